@@ -0,0 +1,351 @@
+#include <sys/printk.h>
+#include <sys/util.h>
+#include <kernel_object.h>
+#include <kernel/stack.h>
+#include <kernel/thread.h>
+#include <version.h>
+
+#include <inc_l4/types.h>
+#include <inc_l4/thread.h>
+#include <inc_l4/ipc.h>
+#include <inc_l4/message.h>
+#include <inc_l4/schedule.h>
+#include <inc_l4/space.h>
+#if defined(CONFIG_CHANNEL)
+#include <inc_l4/channel.h>
+#endif
+
+#include "bench.h"
+
+#define BENCH_STACK_SIZE 	512
+#define BENCH_SENDERS 		8
+
+/* main runs at 31, the server and the consumer preempt it as soon as
+ * they are woken, the open wait senders share its priority */
+#define BENCH_PRIO_HIGH 	32
+#define BENCH_PRIO_MAIN 	31
+
+/* typed item encodings of the kernel, see object/ipc.h */
+#define BENCH_MAP_ITEM 		0x8
+#define BENCH_GRANT_ITEM 	0xa
+#define BENCH_STRING_ITEM 	0x0
+#define BENCH_ITEM_RW 		0x6
+
+#define BENCH_TID(n) 		((L4_ThreadId_t) { .raw = (n) << 14 })
+
+/* Every case is measured between two privileged threads, see bench.h,
+ * so the numbers are the kernel IPC path without the SVC trap of a user
+ * thread. Messages are rendezvoused on the message node of the
+ * receiver: a thread waits with a receive from itself and the sender
+ * sends to it.
+ */
+
+static L4_ThreadId_t main_id = {
+	.raw = 2 << 14
+};
+
+static L4_ThreadId_t bench_space = {
+	.raw = 2 << 14
+};
+
+static L4_ThreadId_t bench_sched = {
+	.raw = 3 << 14
+};
+
+#define server_id 			BENCH_TID(256)
+#define consumer_id 		BENCH_TID(257)
+#define sender_id(n) 		BENCH_TID(258 + (n))
+
+static THREAD_STACK_DEFINE(server_stack, BENCH_STACK_SIZE);
+static THREAD_STACK_ARRAY_DEFINE(sender_stacks, BENCH_SENDERS, BENCH_STACK_SIZE);
+
+static struct utcb server_utcb;
+static struct utcb sender_utcbs[BENCH_SENDERS];
+
+static pager_context_t server_pager;
+static pager_context_t sender_pagers[BENCH_SENDERS];
+
+#if defined(CONFIG_CHANNEL)
+static THREAD_STACK_DEFINE(consumer_stack, BENCH_STACK_SIZE);
+static struct utcb consumer_utcb;
+static pager_context_t consumer_pager;
+
+static u8_t bench_region[1024] __aligned(1024);
+static void *bench_channel;
+#endif
+
+/* sent by the map, grant and string cases */
+static u8_t bench_page[1024] __aligned(1024);
+
+static L4_Word_t bench_payload[BENCH_MAX_WORDS];
+
+/* written by main before each message, read by the woken thread */
+static volatile u32_t bench_start;
+static volatile word_t bench_count;
+static volatile word_t bench_reply_words;
+static volatile bool_t bench_unmap;
+
+static u32_t oneway[BENCH_ITERATIONS];
+static u32_t roundtrip[BENCH_ITERATIONS];
+
+static void bench_pager_init(pager_context_t *pager, struct thread_stack *stack,
+	struct utcb *utcb, ktcb_entry_t entry)
+{
+	pager->stack_ptr = stack;
+	pager->stack_size = BENCH_STACK_SIZE;
+	pager->entry = entry;
+	pager->p1 = (void *)0;
+	pager->p2 = (void *)0;
+	pager->p3 = (void *)0;
+	/* no user option, the cycle counter is privileged */
+	pager->options = 0;
+	pager->virual_user = utcb;
+}
+
+static void bench_thread_start(L4_ThreadId_t id, pager_context_t *pager,
+	L4_Word_t prior)
+{
+	L4_ThreadId_t pager_id = {
+		.raw = (L4_Word_t)pager
+	};
+
+	L4_ThreadControl(id, bench_space, bench_sched, pager_id, (void *)0);
+	L4_Schedule(id, 100 << 20 | 100 << 8 | 2, 0,
+		0xff << 24 | prior << 12 | prior, 0, (L4_Word_t *)0);
+}
+
+/* Takes the one-way sample when woken and answers with
+ * bench_reply_words words, which main times as the round trip.
+ */
+void server_entry(void *p1, void *p2, void *p3)
+{
+	L4_Msg_t reply;
+	u32_t now;
+
+	for (;;)
+	{
+		L4_Receive(server_id);
+		now = bench_cycles();
+
+		if (bench_count < BENCH_ITERATIONS)
+		{
+			oneway[bench_count++] = now - bench_start;
+		}
+
+		/* drop what the item cases mapped, outside the timed window */
+		if (bench_unmap)
+		{
+			L4_Unmap(0);
+		}
+
+		L4_MsgClear(&reply);
+		L4_MsgPut(&reply, 0, bench_reply_words, bench_payload, 0, L4_NULL);
+		L4_MsgLoad(&reply);
+		L4_Send(main_id);
+	}
+}
+
+void sender_entry(void *p1, void *p2, void *p3)
+{
+	L4_Msg_t msg;
+
+	L4_MsgClear(&msg);
+	L4_MsgPut(&msg, 0, 0, L4_NULL, 0, L4_NULL);
+
+	for (;;)
+	{
+		L4_MsgLoad(&msg);
+		L4_Send(main_id);
+	}
+}
+
+#if defined(CONFIG_CHANNEL)
+void consumer_entry(void *p1, void *p2, void *p3)
+{
+	u32_t now;
+
+	for (;;)
+	{
+		L4_Receive(consumer_id);
+		now = bench_cycles();
+
+		if (bench_count < BENCH_ITERATIONS &&
+			(L4_NotifyBadge() & CHANNEL_DOORBELL_BADGE))
+		{
+			oneway[bench_count++] = now - bench_start;
+		}
+	}
+}
+#endif
+
+static void bench_counter(void)
+{
+	for (word_t i = 0; i < BENCH_ITERATIONS; i++)
+	{
+		u32_t start = bench_cycles();
+
+		roundtrip[i] = bench_cycles() - start;
+	}
+
+	bench_report("counter", NULL, 0, roundtrip, BENCH_ITERATIONS);
+}
+
+/* one message per iteration, oneway[] is filled by the server */
+static void bench_exchange(L4_Msg_t *msg)
+{
+	u32_t start;
+
+	bench_count = 0;
+	for (word_t i = 0; i < BENCH_ITERATIONS; i++)
+	{
+		L4_MsgLoad(msg);
+		start = bench_cycles();
+		bench_start = start;
+		L4_Send(server_id);
+		L4_Receive(main_id);
+		roundtrip[i] = bench_cycles() - start;
+	}
+}
+
+static void bench_untyped(void)
+{
+	static const word_t words[] = { 0, 3, 8, BENCH_MAX_WORDS };
+	L4_Msg_t msg;
+
+	for (word_t i = 0; i < ARRAY_SIZE(words); i++)
+	{
+		L4_MsgClear(&msg);
+		L4_MsgPut(&msg, 0, words[i], bench_payload, 0, L4_NULL);
+		bench_reply_words = words[i];
+
+		bench_exchange(&msg);
+
+		bench_report("ipc_oneway", "words", words[i], oneway, bench_count);
+		bench_report("ipc_roundtrip", "words", words[i], roundtrip, BENCH_ITERATIONS);
+	}
+}
+
+static void bench_item(const char *name, L4_Word_t word0, L4_Word_t word1)
+{
+	L4_Word_t item[2] = { word0, word1 };
+	L4_Msg_t msg;
+
+	L4_MsgClear(&msg);
+	L4_MsgPut(&msg, 0, 0, L4_NULL, 2, item);
+	bench_reply_words = 0;
+	bench_unmap = TRUE;
+
+	bench_exchange(&msg);
+
+	bench_unmap = FALSE;
+	bench_report(name, "bytes", sizeof(bench_page), oneway, bench_count);
+}
+
+static void bench_items(void)
+{
+	L4_Word_t base = (L4_Word_t)bench_page;
+	L4_Word_t size = sizeof(bench_page);
+
+	bench_item("ipc_map", base | BENCH_MAP_ITEM,
+		(size & 0xFFFFFFF0) | BENCH_ITEM_RW);
+	bench_item("ipc_grant", base | BENCH_GRANT_ITEM,
+		(size & 0xFFFFFFF0) | BENCH_ITEM_RW);
+	bench_item("ipc_string", (size << 10) | BENCH_STRING_ITEM, base);
+}
+
+#if defined(CONFIG_CHANNEL)
+/* from the doorbell of the producer to the consumer running */
+static void bench_notify(void)
+{
+	bench_pager_init(&consumer_pager, consumer_stack, &consumer_utcb, consumer_entry);
+	bench_thread_start(consumer_id, &consumer_pager, BENCH_PRIO_HIGH);
+
+	if (!L4_ChannelCreate(&bench_channel, bench_region, sizeof(bench_region),
+		main_id, consumer_id))
+	{
+		printk("BENCH case=notify_wake error=channel\n");
+		return;
+	}
+
+	bench_count = 0;
+	for (word_t i = 0; i < BENCH_ITERATIONS; i++)
+	{
+		bench_start = bench_cycles();
+		channel_doorbell(bench_channel);
+	}
+
+	bench_report("notify_wake", NULL, 0, oneway, bench_count);
+}
+#endif
+
+/* Open wait with n senders queued on main. The senders share main's
+ * priority, so the one handed its message does not preempt the timed
+ * receive; the yield afterwards lets it queue up again. This runs last,
+ * the senders keep sending to main for good.
+ */
+static void bench_open_wait(void)
+{
+	static const word_t waiters[] = { 1, 2, 4, BENCH_SENDERS };
+	L4_ThreadId_t from;
+	word_t created = 0;
+	u32_t start;
+
+	for (word_t w = 0; w < ARRAY_SIZE(waiters); w++)
+	{
+		for (; created < waiters[w]; created++)
+		{
+			bench_pager_init(&sender_pagers[created], sender_stacks[created],
+				&sender_utcbs[created], sender_entry);
+			bench_thread_start(sender_id(created), &sender_pagers[created],
+				BENCH_PRIO_MAIN);
+		}
+
+		/* let the new senders run up to their send */
+		L4_Yield();
+
+		for (word_t i = 0; i < BENCH_ITERATIONS; i++)
+		{
+			start = bench_cycles();
+			L4_Wait(&from);
+			roundtrip[i] = bench_cycles() - start;
+
+			L4_Yield();
+		}
+
+		bench_report("ipc_openwait", "senders", waiters[w], roundtrip, BENCH_ITERATIONS);
+	}
+}
+
+void main(void)
+{
+	bench_cycles_init();
+
+	for (word_t i = 0; i < BENCH_MAX_WORDS; i++)
+	{
+		bench_payload[i] = i;
+	}
+
+	printk("BENCH begin board=%s kernel=%s counter=%s iters=%u\n",
+		CONFIG_BOARD, KERNEL_VERSION_STRING, bench_cycles_source(),
+		BENCH_ITERATIONS);
+
+	bench_counter();
+
+	bench_pager_init(&server_pager, server_stack, &server_utcb, server_entry);
+	bench_thread_start(server_id, &server_pager, BENCH_PRIO_HIGH);
+
+	bench_untyped();
+	bench_items();
+#if defined(CONFIG_CHANNEL)
+	bench_notify();
+#endif
+	bench_open_wait();
+
+	printk("BENCH end\n");
+
+	/* exit main task */
+	L4_Yield();
+	for (;;)
+	{
+	}
+}
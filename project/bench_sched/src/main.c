@@ -0,0 +1,434 @@
+#include <sys/printk.h>
+#include <sys/util.h>
+#include <kernel_object.h>
+#include <kernel/stack.h>
+#include <kernel/thread.h>
+#include <arch/irq.h>
+#include <benchmark/sched_stats.h>
+#include <version.h>
+
+#include <inc_l4/types.h>
+#include <inc_l4/thread.h>
+#include <inc_l4/ipc.h>
+#include <inc_l4/message.h>
+#include <inc_l4/schedule.h>
+#if defined(CONFIG_CHANNEL)
+#include <inc_l4/channel.h>
+#endif
+#include <syscalls/sched_stats.h>
+
+#include "bench.h"
+
+#define BENCH_STACK_SIZE 		512
+#define BENCH_FILLER_STACK_SIZE 256
+
+/* The kernel keeps every thread in one table (record_threads), the five
+ * threads of the other cases leave the rest for the fillers, one on each
+ * priority below the probe. */
+#define BENCH_THREAD_TABLE 		THREAD_TABLE_SIZE
+#define BENCH_FILLERS 			MIN(BENCH_THREAD_TABLE - 5, NUM_PRIORITIES - 1)
+
+/* null system calls per sample of the syscall case */
+#define BENCH_SYSCALL_BATCH 	16U
+
+/* exhaustions taken by the budget case */
+#define BENCH_BUDGET_SAMPLES 	200U
+
+/* budget << 20 | period << 8 | refills, in ticks */
+#define BENCH_TIME_RR 			(100 << 20 | 100 << 8 | 2)
+#define BENCH_TIME_BUDGET 		(20 << 20 | 40 << 8 | 2)
+
+/* the probe of the selection case is above everything */
+#define BENCH_PRIO_TOP 			(NUM_PRIORITIES - 1)
+#define BENCH_PRIO_HIGH 		(MAIN_THREAD_PRIO + 1)
+#define BENCH_PRIO_MAIN 		MAIN_THREAD_PRIO
+#define BENCH_PRIO_LOW 			(MAIN_THREAD_PRIO - 1)
+
+#define BENCH_TID(n) 			((L4_ThreadId_t) { .raw = (n) << 14 })
+
+/* The scheduler side (next_thread, refill_budget_check, swap) is timed
+ * in the kernel with CONFIG_SCHED_LATENCY_STATS and read back through
+ * sched_stats_read; the rest is timed here by privileged threads, see
+ * bench.h. Every case prints its summary and its histogram.
+ */
+
+static L4_ThreadId_t main_id = {
+	.raw = 2 << 14
+};
+
+static L4_ThreadId_t bench_space = {
+	.raw = 2 << 14
+};
+
+static L4_ThreadId_t bench_sched = {
+	.raw = 3 << 14
+};
+
+#define caller_id 			BENCH_TID(256)
+#define partner_id 			BENCH_TID(257)
+#define waker_id 			BENCH_TID(258)
+#define spinner_id 			BENCH_TID(259)
+#define probe_id 			BENCH_TID(260)
+#define filler_id(n) 		BENCH_TID(261 + (n))
+
+static THREAD_STACK_DEFINE(caller_stack, BENCH_STACK_SIZE);
+static THREAD_STACK_DEFINE(partner_stack, BENCH_STACK_SIZE);
+static THREAD_STACK_DEFINE(spinner_stack, BENCH_STACK_SIZE);
+static THREAD_STACK_DEFINE(probe_stack, BENCH_STACK_SIZE);
+static THREAD_STACK_ARRAY_DEFINE(filler_stacks, BENCH_FILLERS, BENCH_FILLER_STACK_SIZE);
+
+static struct utcb caller_utcb;
+static struct utcb partner_utcb;
+static struct utcb spinner_utcb;
+static struct utcb probe_utcb;
+static struct utcb filler_utcbs[BENCH_FILLERS];
+
+static pager_context_t caller_pager;
+static pager_context_t partner_pager;
+static pager_context_t spinner_pager;
+static pager_context_t probe_pager;
+static pager_context_t filler_pagers[BENCH_FILLERS];
+
+#if defined(CONFIG_CHANNEL) && defined(CONFIG_IRQ_OFFLOAD)
+static THREAD_STACK_DEFINE(waker_stack, BENCH_STACK_SIZE);
+static struct utcb waker_utcb;
+static pager_context_t waker_pager;
+
+static u8_t bench_region[1024] __aligned(1024);
+static void *bench_channel;
+#endif
+
+/* written before each wakeup, read by the woken thread */
+static volatile u32_t bench_start;
+static volatile word_t bench_count;
+
+static volatile bool_t bench_spin_stop;
+static volatile bool_t bench_spin_parked;
+
+static u32_t samples[BENCH_ITERATIONS];
+static u32_t bucket[BENCH_HIST_BUCKETS];
+
+static void bench_pager_init(pager_context_t *pager, struct thread_stack *stack,
+	size_t stack_size, struct utcb *utcb, ktcb_entry_t entry, word_t options)
+{
+	pager->stack_ptr = stack;
+	pager->stack_size = stack_size;
+	pager->entry = entry;
+	pager->p1 = (void *)0;
+	pager->p2 = (void *)0;
+	pager->p3 = (void *)0;
+	pager->options = options;
+	pager->virual_user = utcb;
+}
+
+static void bench_thread_start(L4_ThreadId_t id, pager_context_t *pager,
+	L4_Word_t time, L4_Word_t prior)
+{
+	L4_ThreadId_t pager_id = {
+		.raw = (L4_Word_t)pager
+	};
+
+	L4_ThreadControl(id, bench_space, bench_sched, pager_id, (void *)0);
+	L4_Schedule(id, time, 0, 0xff << 24 | prior << 12 | prior, 0, (L4_Word_t *)0);
+}
+
+/* summary and histogram of samples taken here */
+static void bench_print(const char *name, const char *param, word_t value,
+	word_t count)
+{
+	bench_hist_fill(bucket, samples, count);
+	bench_report(name, param, value, samples, count);
+	bench_hist(name, param, value, bucket);
+}
+
+/* The same for an interval recorded by the kernel, which keeps no
+ * samples: the summary has the mean in place of the median and p99.
+ * The interval is cleared for the next case.
+ */
+static void bench_print_kernel(const char *name, const char *param, word_t value,
+	enum sched_stats_interval interval)
+{
+	struct sched_stats_hist hist;
+
+	if (sched_stats_read(interval, &hist, 1) != EXCEPTION_NONE)
+	{
+		printk("BENCH case=%s error=read\n", name);
+		return;
+	}
+
+	printk("BENCH case=%s", name);
+	if (param)
+	{
+		printk(" %s=%u", param, (u32_t)value);
+	}
+	printk(" n=%u min=%u mean=%u max=%u\n", hist.count, hist.min,
+		hist.count ? (u32_t)(hist.sum / hist.count) : 0, hist.max);
+
+	bench_hist(name, param, value, hist.bucket);
+}
+
+static void bench_clear_kernel(enum sched_stats_interval interval)
+{
+	struct sched_stats_hist hist;
+
+	(void)sched_stats_read(interval, &hist, 1);
+}
+
+/* Runs in user mode and cannot read the counter: it sends to main after
+ * every batch of null calls, main times the gap between two messages.
+ * A run without calls gives the IPC part to take off. Touches no data
+ * outside its stack.
+ */
+void caller_entry(void *p1, void *p2, void *p3)
+{
+	for (word_t run = 0; run < 2; run++)
+	{
+		word_t calls = run ? BENCH_SYSCALL_BATCH : 0;
+
+		for (word_t i = 0; i <= BENCH_ITERATIONS; i++)
+		{
+			for (word_t c = 0; c < calls; c++)
+			{
+				sched_stats_null();
+			}
+
+			L4_LoadMR(0, 0);
+			L4_Send(BENCH_TID(2));
+		}
+	}
+
+	L4_Receive(caller_id);
+}
+
+/* main and the partner share a priority and take turns: each one stamps
+ * before its yield and the other one takes the sample when it runs */
+static void bench_yield_loop(void)
+{
+	u32_t now;
+
+	while (bench_count < BENCH_ITERATIONS)
+	{
+		bench_start = bench_cycles();
+		L4_Yield();
+		now = bench_cycles();
+
+		if (bench_count < BENCH_ITERATIONS)
+		{
+			samples[bench_count++] = now - bench_start;
+		}
+	}
+}
+
+void partner_entry(void *p1, void *p2, void *p3)
+{
+	bench_yield_loop();
+	L4_Receive(partner_id);
+}
+
+#if defined(CONFIG_CHANNEL) && defined(CONFIG_IRQ_OFFLOAD)
+void waker_entry(void *p1, void *p2, void *p3)
+{
+	u32_t now;
+
+	for (;;)
+	{
+		L4_Receive(waker_id);
+		now = bench_cycles();
+
+		if (bench_count < BENCH_ITERATIONS &&
+			(L4_NotifyBadge() & CHANNEL_DOORBELL_BADGE))
+		{
+			samples[bench_count++] = now - bench_start;
+		}
+	}
+}
+
+/* in interrupt context: the same wakeup a driver ISR does */
+static void bench_isr_wake(void *channel)
+{
+	do_channel_doorbell(channel);
+	schedule();
+}
+#endif
+
+/* spins through its budget until told to stop */
+void spinner_entry(void *p1, void *p2, void *p3)
+{
+	while (!bench_spin_stop)
+	{
+	}
+
+	bench_spin_parked = TRUE;
+	L4_Receive(spinner_id);
+}
+
+/* ready at every level it is given, below the probe */
+void filler_entry(void *p1, void *p2, void *p3)
+{
+	for (;;)
+	{
+		L4_Yield();
+	}
+}
+
+static void bench_syscall(void)
+{
+	static const word_t calls[] = { 0, BENCH_SYSCALL_BATCH };
+	u32_t last;
+	u32_t now;
+
+	bench_pager_init(&caller_pager, caller_stack, BENCH_STACK_SIZE,
+		&caller_utcb, caller_entry, 1 << 2);
+	bench_thread_start(caller_id, &caller_pager, BENCH_TIME_RR, BENCH_PRIO_LOW);
+
+	for (word_t run = 0; run < ARRAY_SIZE(calls); run++)
+	{
+		L4_Receive(main_id);
+		last = bench_cycles();
+
+		for (word_t i = 0; i < BENCH_ITERATIONS; i++)
+		{
+			L4_Receive(main_id);
+			now = bench_cycles();
+			samples[i] = now - last;
+			last = now;
+		}
+
+		bench_print("syscall_null", "calls", calls[run], BENCH_ITERATIONS);
+	}
+}
+
+static void bench_yield(void)
+{
+	bench_pager_init(&partner_pager, partner_stack, BENCH_STACK_SIZE,
+		&partner_utcb, partner_entry, 0);
+	bench_thread_start(partner_id, &partner_pager, BENCH_TIME_RR, BENCH_PRIO_MAIN);
+
+	bench_clear_kernel(sched_stats_swap);
+
+	bench_count = 0;
+	bench_yield_loop();
+
+	/* if main took the last sample, let the partner see it and park */
+	L4_Yield();
+
+	bench_print("yield", NULL, 0, bench_count);
+	bench_print_kernel("swap", NULL, 0, sched_stats_swap);
+}
+
+#if defined(CONFIG_CHANNEL) && defined(CONFIG_IRQ_OFFLOAD)
+/* from raising the interrupt to the higher priority thread it woke running */
+static void bench_isr(void)
+{
+	bench_pager_init(&waker_pager, waker_stack, BENCH_STACK_SIZE,
+		&waker_utcb, waker_entry, 0);
+	bench_thread_start(waker_id, &waker_pager, BENCH_TIME_RR, BENCH_PRIO_HIGH);
+
+	if (!L4_ChannelCreate(&bench_channel, bench_region, sizeof(bench_region),
+		main_id, waker_id))
+	{
+		printk("BENCH case=isr_preempt error=channel\n");
+		return;
+	}
+
+	bench_count = 0;
+	for (word_t i = 0; i < BENCH_ITERATIONS; i++)
+	{
+		bench_start = bench_cycles();
+		thread_irq_offload(bench_isr_wake, bench_channel);
+	}
+
+	bench_print("isr_preempt", NULL, 0, bench_count);
+}
+#endif
+
+/* A higher priority thread with half the bandwidth spins; every time it
+ * runs out of budget the kernel charges it through refill_budget_check.
+ * main polls in the other half.
+ */
+static void bench_budget(void)
+{
+	struct sched_stats_hist hist;
+
+	bench_clear_kernel(sched_stats_refill_budget);
+
+	bench_pager_init(&spinner_pager, spinner_stack, BENCH_STACK_SIZE,
+		&spinner_utcb, spinner_entry, 0);
+	bench_thread_start(spinner_id, &spinner_pager, BENCH_TIME_BUDGET, BENCH_PRIO_HIGH);
+
+	do
+	{
+		(void)sched_stats_read(sched_stats_refill_budget, &hist, 0);
+	} while (hist.count < BENCH_BUDGET_SAMPLES);
+
+	bench_spin_stop = TRUE;
+	while (!bench_spin_parked)
+	{
+	}
+
+	bench_print_kernel("refill_budget", NULL, 0, sched_stats_refill_budget);
+}
+
+/* next_thread() with 1, 16 and as many populated priorities as the
+ * thread table allows: the probe on top and a filler on each level
+ * below it. main is blocked, the probe ends the run.
+ */
+void probe_entry(void *p1, void *p2, void *p3)
+{
+	static const word_t levels[] = { 1, 16, BENCH_FILLERS + 1 };
+	word_t created = 0;
+
+	for (word_t l = 0; l < ARRAY_SIZE(levels); l++)
+	{
+		for (; created < levels[l] - 1; created++)
+		{
+			bench_pager_init(&filler_pagers[created], filler_stacks[created],
+				BENCH_FILLER_STACK_SIZE, &filler_utcbs[created], filler_entry, 0);
+			bench_thread_start(filler_id(created), &filler_pagers[created],
+				BENCH_TIME_RR, created);
+		}
+
+		bench_clear_kernel(sched_stats_next_thread);
+		for (word_t i = 0; i < BENCH_ITERATIONS; i++)
+		{
+			L4_Yield();
+		}
+
+		bench_print_kernel("next_thread", "levels", levels[l], sched_stats_next_thread);
+	}
+
+	printk("BENCH end\n");
+
+	L4_Receive(probe_id);
+}
+
+static void bench_select(void)
+{
+	bench_pager_init(&probe_pager, probe_stack, BENCH_STACK_SIZE,
+		&probe_utcb, probe_entry, 0);
+	bench_thread_start(probe_id, &probe_pager, BENCH_TIME_RR, BENCH_PRIO_TOP);
+
+	/* nobody sends to main again */
+	L4_Receive(main_id);
+}
+
+void main(void)
+{
+	bench_cycles_init();
+
+	printk("BENCH begin board=%s kernel=%s counter=%s iters=%u\n",
+		CONFIG_BOARD, KERNEL_VERSION_STRING, bench_cycles_source(),
+		BENCH_ITERATIONS);
+
+	bench_syscall();
+	bench_yield();
+#if defined(CONFIG_CHANNEL) && defined(CONFIG_IRQ_OFFLOAD)
+	bench_isr();
+#endif
+	bench_budget();
+	bench_select();
+
+	for (;;)
+	{
+	}
+}
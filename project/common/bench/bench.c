@@ -0,0 +1,158 @@
+#include <sys/printk.h>
+#include <sys/util.h>
+
+#include <benchmark/cycles.h>
+
+#include "bench.h"
+
+bool_t bench_has_counter;
+
+#if defined(CONFIG_ARM64)
+/* ID_AA64DFR0_EL1.PMUVer, 0 is no PMU and 0xf an IMPLEMENTATION DEFINED one */
+#define PMUVER_SHIFT 		8
+#define PMUVER_MASK 		0xf
+
+#define PMCR_E 				BIT(0)
+#define PMCR_C 				BIT(2)
+#define PMCNTEN_C 			BIT(31)
+
+void bench_cycles_init(void)
+{
+	u64_t dfr0;
+	u64_t pmcr;
+	word_t ver;
+
+	__asm__ volatile("mrs %0, id_aa64dfr0_el1" : "=r" (dfr0));
+	ver = (dfr0 >> PMUVER_SHIFT) & PMUVER_MASK;
+	if (ver == 0 || ver == PMUVER_MASK)
+	{
+		bench_has_counter = FALSE;
+		return;
+	}
+
+	/* count at EL1 and EL0 */
+	__asm__ volatile("msr pmccfiltr_el0, xzr");
+	__asm__ volatile("mrs %0, pmcr_el0" : "=r" (pmcr));
+	__asm__ volatile("msr pmcr_el0, %0" : : "r" (pmcr | PMCR_E | PMCR_C));
+	__asm__ volatile("msr pmcntenset_el0, %0" : : "r" ((u64_t)PMCNTEN_C));
+	__asm__ volatile("isb");
+
+	bench_has_counter = TRUE;
+}
+
+const char *bench_cycles_source(void)
+{
+	return bench_has_counter ? "pmu" : "timer";
+}
+#elif defined(CONFIG_CPU_CORTEX_M_HAS_DWT)
+void bench_cycles_init(void)
+{
+	u32_t start;
+
+	if (!arm_dwt_cycle_count_enable())
+	{
+		bench_has_counter = FALSE;
+		return;
+	}
+
+	/* an emulator may take the writes and still never count */
+	start = DWT->CYCCNT;
+	for (volatile word_t i = 0; i < 16; i++)
+	{
+	}
+	bench_has_counter = (DWT->CYCCNT != start);
+}
+
+const char *bench_cycles_source(void)
+{
+	return bench_has_counter ? "dwt" : "systick";
+}
+#else
+void bench_cycles_init(void)
+{
+	bench_has_counter = FALSE;
+}
+
+const char *bench_cycles_source(void)
+{
+	return "timer";
+}
+#endif
+
+/* shell sort, in place and without recursion on the main stack */
+static void bench_sort(u32_t *samples, word_t count)
+{
+	static const word_t gaps[] = { 701, 301, 132, 57, 23, 10, 4, 1 };
+
+	for (word_t g = 0; g < ARRAY_SIZE(gaps); g++)
+	{
+		word_t gap = gaps[g];
+
+		for (word_t i = gap; i < count; i++)
+		{
+			u32_t value = samples[i];
+			word_t j = i;
+
+			while (j >= gap && samples[j - gap] > value)
+			{
+				samples[j] = samples[j - gap];
+				j -= gap;
+			}
+			samples[j] = value;
+		}
+	}
+}
+
+void bench_report(const char *name, const char *param, word_t value,
+	u32_t *samples, word_t count)
+{
+	printk("BENCH case=%s", name);
+	if (param)
+	{
+		printk(" %s=%u", param, (u32_t)value);
+	}
+
+	if (count == 0)
+	{
+		printk(" n=0\n");
+		return;
+	}
+
+	bench_sort(samples, count);
+
+	printk(" n=%u min=%u median=%u p99=%u max=%u\n", (u32_t)count,
+		samples[0], samples[count / 2], samples[(count * 99) / 100],
+		samples[count - 1]);
+}
+
+void bench_hist_fill(u32_t *bucket, const u32_t *samples, word_t count)
+{
+	for (word_t b = 0; b < BENCH_HIST_BUCKETS; b++)
+	{
+		bucket[b] = 0;
+	}
+
+	for (word_t i = 0; i < count; i++)
+	{
+		bucket[benchmark_cycles_bucket(samples[i])]++;
+	}
+}
+
+void bench_hist(const char *name, const char *param, word_t value,
+	const u32_t *bucket)
+{
+	printk("BENCH hist case=%s", name);
+	if (param)
+	{
+		printk(" %s=%u", param, (u32_t)value);
+	}
+
+	for (word_t b = 0; b < BENCH_HIST_BUCKETS; b++)
+	{
+		if (bucket[b])
+		{
+			printk(" 2^%u=%u", (u32_t)b, bucket[b]);
+		}
+	}
+	printk("\n");
+}
@@ -0,0 +1,80 @@
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <types_def.h>
+#include <drivers/timer/system_timer.h>
+
+#if defined(CONFIG_CPU_CORTEX_M_HAS_DWT)
+#include <arch/arm/aarch32/cortex_m/dwt.h>
+#endif
+
+/* samples per case, the p99 is taken from the sorted samples */
+#define BENCH_ITERATIONS 	2000U
+
+/* largest untyped payload, MR0 holds the tag */
+#define BENCH_MAX_WORDS 	10U
+
+/* log2 buckets, one per bit of a 32 bit cycle count */
+#define BENCH_HIST_BUCKETS 	32U
+
+extern bool_t bench_has_counter;
+
+/* The benchmark threads are created without the user option, so the
+ * cycle counter can be read directly: DWT CYCCNT on Cortex-M, PMCCNTR
+ * on AArch64. When the core has none, or it does not count (emulators),
+ * fall back to the system timer, which is SysTick based on Cortex-M.
+ */
+static FORCE_INLINE u32_t bench_cycles(void)
+{
+#if defined(CONFIG_ARM64)
+	u64_t cycles;
+
+	if (!bench_has_counter)
+	{
+		return clock_cycle_get_32();
+	}
+
+	__asm__ volatile("isb\n\t"
+			 "mrs %0, pmccntr_el0" : "=r" (cycles) : : "memory");
+
+	return (u32_t)cycles;
+#elif defined(CONFIG_CPU_CORTEX_M_HAS_DWT)
+	if (bench_has_counter)
+	{
+		return DWT->CYCCNT;
+	}
+
+	return clock_cycle_get_32();
+#else
+	return clock_cycle_get_32();
+#endif
+}
+
+void bench_cycles_init(void);
+const char *bench_cycles_source(void);
+
+/**
+ * @brief Print one case
+ *
+ * Sorts the samples in place and prints one line, the parameter is
+ * left out when param is NULL:
+ * BENCH case=<name> <param>=<value> n=<n> min=<c> median=<c> p99=<c> max=<c>
+ */
+void bench_report(const char *name, const char *param, word_t value,
+	u32_t *samples, word_t count);
+
+/* count the samples into bucket[BENCH_HIST_BUCKETS], see bench_hist */
+void bench_hist_fill(u32_t *bucket, const u32_t *samples, word_t count);
+
+/**
+ * @brief Print the histogram of one case
+ *
+ * Bucket i holds the samples in [2^i, 2^(i+1)) cycles, bucket 0 also
+ * holds 0. Only the buckets that are not empty are printed, keyed by
+ * their lower bound:
+ * BENCH hist case=<name> <param>=<value> 2^<i>=<count> ...
+ */
+void bench_hist(const char *name, const char *param, word_t value,
+	const u32_t *bucket);
+
+#endif
@@ -0,0 +1,275 @@
+#include <sys/printk.h>
+#include <sys/util.h>
+#include <sys/string.h>
+#include <sys/rb.h>
+#include <kernel_object.h>
+#include <kernel/thread.h>
+#include <kernel/time.h>
+#include <kernel/cspace.h>
+#include <model/sporadic.h>
+#include <object/objecttype.h>
+#include <state/statedata.h>
+
+#include "host_test.h"
+
+/* Microbenchmarks of the kernel's data structures, on the main thread of
+ * a booted kernel like the tests. The argument of a case is the number
+ * of entries the structure holds while it is timed.
+ */
+
+#define BENCH_THREADS 		256
+#define BENCH_OBJECTS 		1024
+#define BENCH_RB_ITEMS 		1024
+
+/* far enough that nothing resident ever fires, no time passes anyway */
+#define BENCH_FAR_TICKS 	100000
+
+static struct ktcb threads[BENCH_THREADS + 1];
+static struct thread_sched scheds[BENCH_THREADS + 1];
+static struct ktcb dummy_thread;
+
+static const word_t bench_sizes[] = { 1, 16, 64, 256, 0 };
+static const word_t bench_queue_lengths[] = { 1, 2, 0 };
+/* above main, which stays queued at MAIN_THREAD_PRIO; 32, 64, 160 and
+ * 255 of 256 */
+static const word_t bench_prios[] = {
+	MAIN_THREAD_PRIO + 1, MAX(MAIN_THREAD_PRIO + 2, NUM_PRIORITIES / 4),
+	NUM_PRIORITIES * 5 / 8, NUM_PRIORITIES - 1, 0
+};
+static const word_t bench_objects[] = { 16, 256, 1024, 0 };
+static const word_t bench_blocks[] = { 16, 64, 256, 0 };
+
+static void bench_thread_init(struct ktcb *thread, word_t prio)
+{
+	memset(thread, 0, sizeof(*thread));
+	thread->base.sched_prior = prio;
+	thread->base.mcp = NUM_PRIORITIES - 1;
+}
+
+/* the selection of schedule(): the best thread comes off its queue, and
+ * goes back on as if it was preempted. The argument is the priority
+ * picked, in different words of both levels of the bitmap.
+ */
+static void bm_ready_queue_pick(struct host_bench_state *state)
+{
+	struct ktcb *current = _current_thread;
+	struct ktcb *thread = &threads[0];
+
+	bench_thread_init(thread, state->arg);
+	marktcb_as_queued(thread);
+	sched_append(thread);
+
+	_current_thread = &dummy_thread;
+	for (u64_t i = 0; i < state->iterations; i++)
+	{
+		struct ktcb *next = next_thread();
+
+		marktcb_as_queued(next);
+		sched_enqueue(next);
+	}
+	_current_thread = current;
+
+	sched_dequeue(thread);
+	marktcb_as_not_queued(thread);
+}
+
+/* append and remove one thread, alone on its priority so the bitmap
+ * is updated both ways, or behind another thread */
+static void bm_ready_queue_append_dequeue(struct host_bench_state *state)
+{
+	struct ktcb *thread = &threads[0];
+	struct ktcb *resident = &threads[1];
+	word_t prio = NUM_PRIORITIES - 1;
+
+	bench_thread_init(thread, prio);
+	bench_thread_init(resident, prio);
+	if (state->arg > 1)
+	{
+		marktcb_as_queued(resident);
+		sched_append(resident);
+	}
+
+	for (u64_t i = 0; i < state->iterations; i++)
+	{
+		sched_append(thread);
+		sched_dequeue(thread);
+	}
+
+	if (state->arg > 1)
+	{
+		sched_dequeue(resident);
+		marktcb_as_not_queued(resident);
+	}
+}
+
+/* insert behind the last of the resident events, the longest walk, and
+ * remove again; removing the last one leaves the others' deltas alone */
+static void bm_timer_list_insert(struct host_bench_state *state)
+{
+	static struct timer_event events[BENCH_THREADS + 1];
+	struct timer_event *event = &events[BENCH_THREADS];
+
+	for (word_t i = 0; i < state->arg; i++)
+	{
+		initialize_timelist(&events[i]);
+		add_to_timelist(&events[i], NULL, NULL, BENCH_FAR_TICKS + i);
+	}
+	initialize_timelist(event);
+
+	for (u64_t i = 0; i < state->iterations; i++)
+	{
+		add_to_timelist(event, NULL, NULL, BENCH_FAR_TICKS + BENCH_THREADS);
+		remove_from_timelist(event);
+	}
+
+	for (word_t i = 0; i < state->arg; i++)
+	{
+		remove_from_timelist(&events[state->arg - 1 - i]);
+	}
+}
+
+/* the release queue is ordered by the time of the head refill */
+static void bm_release_queue_insert(struct host_bench_state *state)
+{
+	struct ktcb *thread = &threads[BENCH_THREADS];
+	bool_t reprogram_saved = reprogram;
+	struct ktcb *release_saved = release_queue;
+
+	release_queue = NULL;
+
+	for (word_t i = 0; i <= state->arg; i++)
+	{
+		word_t n = (i == state->arg) ? BENCH_THREADS : i;
+
+		bench_thread_init(&threads[n], 1);
+		memset(&scheds[n], 0, sizeof(scheds[n]));
+		scheds[n].refill_max = 1;
+		REFILL_HEAD(&scheds[n]).refill_time = BENCH_FAR_TICKS + n;
+		threads[n].sched = &scheds[n];
+
+		if (i < state->arg)
+		{
+			release_enqueue(&threads[n]);
+		}
+	}
+
+	for (u64_t i = 0; i < state->iterations; i++)
+	{
+		release_enqueue(thread);
+		release_remove(thread);
+	}
+
+	release_queue = release_saved;
+	reprogram = reprogram_saved;
+}
+
+static byte_t objects[BENCH_OBJECTS][sizeof(struct d_object) + sizeof(struct timer_event)] __aligned(sizeof(void *));
+static void *object_names[BENCH_OBJECTS];
+static word_t objects_carved;
+
+/* k_object_find() of a kernel object among arg of them, the lookup of
+ * every capability a system call is given */
+static void bm_object_lookup(struct host_bench_state *state)
+{
+	word_t count = state->arg;
+
+	/* the tree only grows, each case adds what it needs */
+	while (objects_carved < count)
+	{
+		object_names[objects_carved] = d_object_carve(objects[objects_carved], obj_time_obj);
+		objects_carved++;
+	}
+
+	for (u64_t i = 0; i < state->iterations; i++)
+	{
+		/* 97 is coprime to every count, so all of them are visited */
+		struct k_object *ko = k_object_find(object_names[(i * 97) % count]);
+
+		host_bench_keep(ko);
+	}
+}
+
+static void bm_mempool_alloc_free(struct host_bench_state *state)
+{
+	for (u64_t i = 0; i < state->iterations; i++)
+	{
+		void *block = malloc_object(state->arg);
+
+		host_bench_keep(block);
+		free_object(block);
+	}
+}
+
+/* with a block of each size held, so the pool is not empty */
+static void bm_mempool_alloc_free_held(struct host_bench_state *state)
+{
+	void *held[ARRAY_SIZE(bench_blocks) - 1];
+
+	for (word_t i = 0; i < ARRAY_SIZE(held); i++)
+	{
+		held[i] = malloc_object(bench_blocks[i]);
+	}
+
+	bm_mempool_alloc_free(state);
+
+	for (word_t i = 0; i < ARRAY_SIZE(held); i++)
+	{
+		free_object(held[i]);
+	}
+}
+
+struct bench_rb_item {
+	struct rbnode node;
+	word_t key;
+};
+
+static struct bench_rb_item rb_items[BENCH_RB_ITEMS + 1];
+
+static bool_t bench_rb_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	return CONTAINER_OF(a, struct bench_rb_item, node)->key <
+		CONTAINER_OF(b, struct bench_rb_item, node)->key;
+}
+
+static void bm_rbtree_insert_remove(struct host_bench_state *state)
+{
+	struct rbtree tree = {
+		.lessthan_fn = bench_rb_lessthan
+	};
+	struct bench_rb_item *item = &rb_items[BENCH_RB_ITEMS];
+
+	for (word_t i = 0; i < state->arg; i++)
+	{
+		rb_items[i].key = i * 2;
+		rb_node_init(&rb_items[i].node);
+		rb_insert(&tree, &rb_items[i].node);
+	}
+
+	/* in the middle, between two resident keys */
+	item->key = state->arg | 1;
+	rb_node_init(&item->node);
+
+	for (u64_t i = 0; i < state->iterations; i++)
+	{
+		rb_insert(&tree, &item->node);
+		rb_remove(&tree, &item->node);
+	}
+}
+
+static const struct host_bench benches[] = {
+	HOST_BENCH_ARGS(bm_ready_queue_pick, bench_prios),
+	HOST_BENCH_ARGS(bm_ready_queue_append_dequeue, bench_queue_lengths),
+	HOST_BENCH_ARGS(bm_timer_list_insert, bench_sizes),
+	HOST_BENCH_ARGS(bm_release_queue_insert, bench_sizes),
+	HOST_BENCH_ARGS(bm_object_lookup, bench_objects),
+	HOST_BENCH_ARGS(bm_mempool_alloc_free, bench_blocks),
+	HOST_BENCH_ARGS(bm_mempool_alloc_free_held, bench_blocks),
+	HOST_BENCH_ARGS(bm_rbtree_insert_remove, bench_objects),
+};
+
+void main(void)
+{
+	dummy_thread.base.thread_state.obj_state = state_dummy_state;
+
+	host_bench_run(benches, ARRAY_SIZE(benches));
+}
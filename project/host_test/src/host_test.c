@@ -0,0 +1,203 @@
+#include <sys/string.h>
+#include <arch/posix/posix_host.h>
+
+#include "host_test.h"
+
+#define HOST_NAME_WIDTH 		40
+
+/* 0.5s, the default of Google Benchmark */
+#define HOST_BENCH_MIN_NS 		500000000ULL
+#define HOST_BENCH_MAX_ITERS 	1000000000ULL
+
+#define NSEC_PER_SEC_ULL 		1000000000ULL
+
+word_t host_test_failed;
+
+static bool_t host_test_current_failed;
+
+/* value of --<option>=<value> on the command line, NULL when absent */
+static const char *host_option(const char *option)
+{
+	size_t len = strlen(option);
+
+	for (int i = 1; i < posix_argc(); i++)
+	{
+		const char *arg = posix_argv()[i];
+
+		if (strncmp(arg, "--", 2) == 0 &&
+			strncmp(arg + 2, option, len) == 0 &&
+			arg[2 + len] == '=')
+		{
+			return arg + 3 + len;
+		}
+	}
+
+	return NULL;
+}
+
+static bool_t host_selected(const char *name, const char *filter)
+{
+	return filter == NULL || strstr(name, filter) != NULL;
+}
+
+void host_test_fail(const char *file, sword_t line, const char *expr)
+{
+	printk("%s:%d: check failed: %s\n", file, (int)line, expr);
+	host_test_current_failed = TRUE;
+}
+
+void host_test_run(const struct host_test *tests, word_t count)
+{
+	const char *filter = host_option("test_filter");
+	word_t run = 0;
+
+	for (word_t i = 0; i < count; i++)
+	{
+		if (!host_selected(tests[i].name, filter))
+		{
+			continue;
+		}
+
+		printk("[ RUN      ] %s\n", tests[i].name);
+		host_test_current_failed = FALSE;
+		tests[i].fn();
+		run++;
+
+		if (host_test_current_failed)
+		{
+			host_test_failed++;
+			printk("[  FAILED  ] %s\n", tests[i].name);
+		}
+		else
+		{
+			printk("[       OK ] %s\n", tests[i].name);
+		}
+	}
+
+	printk("[==========] %u tests ran, %u failed\n",
+		(u32_t)run, (u32_t)host_test_failed);
+
+	posix_exit(host_test_failed != 0);
+	CODE_UNREACHABLE;
+}
+
+void host_bench_pause(struct host_bench_state *state)
+{
+	state->paused_ns = posix_host_time_ns();
+}
+
+void host_bench_resume(struct host_bench_state *state)
+{
+	state->start_ns += posix_host_time_ns() - state->paused_ns;
+}
+
+/* "0.5", "2" or "0.01s": seconds, as Google Benchmark takes them */
+static u64_t host_parse_seconds(const char *value)
+{
+	u64_t ns = 0;
+	u64_t scale = NSEC_PER_SEC_ULL;
+
+	while (*value >= '0' && *value <= '9')
+	{
+		ns = ns * 10 + (u64_t)(*value++ - '0');
+	}
+	ns *= NSEC_PER_SEC_ULL;
+
+	if (*value == '.')
+	{
+		value++;
+		while (*value >= '0' && *value <= '9' && scale > 1)
+		{
+			scale /= 10;
+			ns += (u64_t)(*value++ - '0') * scale;
+		}
+	}
+
+	return ns;
+}
+
+static u64_t host_bench_once(const struct host_bench *bench, word_t arg, u64_t iterations)
+{
+	struct host_bench_state state = {
+		.iterations = iterations,
+		.arg = arg,
+	};
+
+	state.start_ns = posix_host_time_ns();
+	bench->fn(&state);
+
+	return posix_host_time_ns() - state.start_ns;
+}
+
+static void host_bench_case(const struct host_bench *bench, word_t arg, u64_t min_ns)
+{
+	char name[HOST_NAME_WIDTH + 1];
+	u64_t iterations = 1;
+	u64_t elapsed;
+	u64_t tenths;
+
+	if (bench->args != NULL)
+	{
+		snprintk(name, sizeof(name), "%s/%u", bench->name, (u32_t)arg);
+	}
+	else
+	{
+		snprintk(name, sizeof(name), "%s", bench->name);
+	}
+
+	/* grow the count by what the last run says is missing, with some
+	 * margin, but at most tenfold so a noisy short run does not
+	 * overshoot */
+	for (;;)
+	{
+		u64_t next;
+
+		elapsed = host_bench_once(bench, arg, iterations);
+		if (elapsed >= min_ns || iterations >= HOST_BENCH_MAX_ITERS)
+		{
+			break;
+		}
+
+		next = iterations * (min_ns + min_ns / 2) / MAX(elapsed, 1ULL);
+		next = MIN(next, iterations * 10);
+		iterations = MIN(MAX(next, iterations + 1), HOST_BENCH_MAX_ITERS);
+	}
+
+	tenths = elapsed * 10 / iterations;
+	printk("%-40s %12llu.%llu %15llu\n", name,
+		tenths / 10, tenths % 10, iterations);
+}
+
+void host_bench_run(const struct host_bench *benches, word_t count)
+{
+	const char *filter = host_option("benchmark_filter");
+	const char *min_time = host_option("benchmark_min_time");
+	u64_t min_ns = min_time ? host_parse_seconds(min_time) : HOST_BENCH_MIN_NS;
+
+	printk("%-40s       Time(ns)      Iterations\n", "Benchmark");
+	printk("------------------------------------------------------------------------\n");
+
+	for (word_t i = 0; i < count; i++)
+	{
+		const struct host_bench *bench = &benches[i];
+
+		if (!host_selected(bench->name, filter))
+		{
+			continue;
+		}
+
+		if (bench->args == NULL)
+		{
+			host_bench_case(bench, 0, min_ns);
+			continue;
+		}
+
+		for (const word_t *arg = bench->args; *arg != 0; arg++)
+		{
+			host_bench_case(bench, *arg, min_ns);
+		}
+	}
+
+	posix_exit(0);
+	CODE_UNREACHABLE;
+}
@@ -0,0 +1,70 @@
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+#include <types_def.h>
+#include <sys/printk.h>
+#include <sys/util.h>
+
+/* A test is a function that returns on the first failed check; a run
+ * prints one line per test and a summary, and exits with the number of
+ * failed tests, so ctest sees any failure.
+ */
+
+struct host_test {
+	const char *name;
+	void (*fn)(void);
+};
+
+#define HOST_TEST(fn) 	{ #fn, fn }
+
+extern word_t host_test_failed;
+
+void host_test_fail(const char *file, sword_t line, const char *expr);
+
+#define HOST_CHECK(expr) 	\
+	do { 	\
+		if (!(expr)) 	\
+		{ 	\
+			host_test_fail(__FILE__, __LINE__, #expr); 	\
+			return; 	\
+		} 	\
+	} while (false)
+
+#define HOST_CHECK_EQ(a, b) 	HOST_CHECK((a) == (b))
+
+/* runs the tests, or only those named by --test_filter=<substring> */
+FUNC_NORETURN void host_test_run(const struct host_test *tests, word_t count);
+
+/* A benchmark runs its body state->iterations times, host_bench_run()
+ * grows the count until a run takes --benchmark_min_time (seconds,
+ * 0.5 by default) and prints the time per iteration, in the layout of
+ * Google Benchmark. Setup that must not be timed goes between
+ * host_bench_pause() and host_bench_resume().
+ */
+
+struct host_bench_state {
+	u64_t iterations;
+	u64_t start_ns;
+	u64_t paused_ns;
+	word_t arg;
+};
+
+struct host_bench {
+	const char *name;
+	void (*fn)(struct host_bench_state *state);
+	/* the benchmark runs once per value, 0 ends the list */
+	const word_t *args;
+};
+
+#define HOST_BENCH(fn) 				{ #fn, fn, NULL }
+#define HOST_BENCH_ARGS(fn, args) 	{ #fn, fn, args }
+
+void host_bench_pause(struct host_bench_state *state);
+void host_bench_resume(struct host_bench_state *state);
+
+/* keeps the compiler from dropping a result that is never used */
+#define host_bench_keep(value) 	__asm__ volatile("" : : "r" (value) : "memory")
+
+FUNC_NORETURN void host_bench_run(const struct host_bench *benches, word_t count);
+
+#endif
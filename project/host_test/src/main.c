@@ -0,0 +1,671 @@
+#include <sys/printk.h>
+#include <sys/util.h>
+#include <sys/string.h>
+#include <sys/rb.h>
+#include <kernel_object.h>
+#include <kernel/thread.h>
+#include <kernel/time.h>
+#include <kernel/cspace.h>
+#include <object/objecttype.h>
+#include <object/untyped.h>
+#include <object/ipc.h>
+#include <state/statedata.h>
+#include <benchmark/thread_stats.h>
+#include <drivers/timer/native_posix_timer.h>
+
+#include "host_test.h"
+
+/* The tests run on the main thread of a booted kernel, see posix_host.c.
+ * Kernel objects are static: word_t is 32 bits wide and only holds the
+ * low addresses of the static, non-PIE executable, not stack ones.
+ */
+
+#define TEST_THREADS 		8
+
+/* main stays queued at MAIN_THREAD_PRIO while it runs, see
+ * init_main_thread() */
+#define TEST_PRIO_LOW 		(MAIN_THREAD_PRIO + 1)
+
+#define CYC_PER_TICK 		(sys_clock_hw_cycles_per_sec() / CONFIG_SYS_CLOCK_TICKS_PER_SEC)
+
+static struct ktcb threads[TEST_THREADS];
+static struct thread_sched scheds[TEST_THREADS];
+static struct ktcb dummy_thread;
+
+static void test_thread_init(struct ktcb *thread, word_t prio)
+{
+	memset(thread, 0, sizeof(*thread));
+	thread->base.sched_prior = prio;
+	thread->base.mcp = NUM_PRIORITIES - 1;
+}
+
+static void test_ready(struct ktcb *thread, bool_t tail)
+{
+	marktcb_as_queued(thread);
+	if (tail)
+	{
+		sched_append(thread);
+	}
+	else
+	{
+		sched_enqueue(thread);
+	}
+}
+
+/* whether prio is set in the bitmap, in the layout SCHED_BITMAP_LEVELS
+ * picks */
+static bool_t test_prio_in_bitmap(word_t prio)
+{
+#if SCHED_BITMAP_LEVELS == 1
+	return (ready_queues_l1_bitmap[0] & BIT(prio)) != 0;
+#else
+	word_t l1index = prio_to_l1index(prio);
+
+	return (ready_queues_l1_bitmap[0] & BIT(l1index)) &&
+		(ready_queues_l2_bitmap[0][invert_l1index(l1index)] & BIT(prio & MASK(WORD_SIZE)));
+#endif
+}
+
+/* next_thread() from a current thread that is not runnable, so the
+ * result is the head of the highest ready queue, taken out of it */
+static struct ktcb *test_pick(void)
+{
+	struct ktcb *current = _current_thread;
+	struct ktcb *next;
+
+	_current_thread = &dummy_thread;
+	next = next_thread();
+	_current_thread = current;
+
+	return next;
+}
+
+static void test_ready_queue_bitmap(void)
+{
+	/* on both sides of the words of the bitmap, those there are
+	 * priorities for */
+	static const word_t candidates[] = {
+		TEST_PRIO_LOW + 1, 63, 64, 95, 96, 200
+	};
+	word_t prios[ARRAY_SIZE(candidates) + 2];
+	word_t count = 0;
+
+	prios[count++] = TEST_PRIO_LOW;
+	for (word_t i = 0; i < ARRAY_SIZE(candidates); i++)
+	{
+		if (candidates[i] < NUM_PRIORITIES - 1)
+		{
+			prios[count++] = candidates[i];
+		}
+	}
+	prios[count++] = NUM_PRIORITIES - 1;
+
+	HOST_CHECK(_current_thread->base.sched_prior < TEST_PRIO_LOW);
+
+	for (word_t i = 0; i < count; i++)
+	{
+		test_thread_init(&threads[i], prios[i]);
+		test_ready(&threads[i], TRUE);
+
+		HOST_CHECK(test_prio_in_bitmap(prios[i]));
+	}
+
+	/* highest first, across both levels of the bitmap */
+	for (sword_t i = count - 1; i >= 0; i--)
+	{
+		HOST_CHECK(test_pick() == &threads[i]);
+		HOST_CHECK(!is_thread_queued(&threads[i]));
+	}
+
+	for (word_t i = 0; i < count; i++)
+	{
+		HOST_CHECK(ready_queues[ready_queues_index(0, prios[i])].head == NULL);
+	}
+}
+
+static void test_ready_queue_order(void)
+{
+	word_t prio = TEST_PRIO_LOW + 10;
+
+	for (word_t i = 0; i < 4; i++)
+	{
+		test_thread_init(&threads[i], prio);
+	}
+
+	/* 2 1 0 3 */
+	test_ready(&threads[0], TRUE);
+	test_ready(&threads[1], FALSE);
+	test_ready(&threads[2], FALSE);
+	test_ready(&threads[3], TRUE);
+
+	HOST_CHECK(ready_queues[ready_queues_index(0, prio)].head == &threads[2]);
+	HOST_CHECK(ready_queues[ready_queues_index(0, prio)].tail == &threads[3]);
+
+	/* from the middle, the bitmap stays set */
+	sched_dequeue(&threads[1]);
+	marktcb_as_not_queued(&threads[1]);
+	HOST_CHECK(test_prio_in_bitmap(prio));
+
+	HOST_CHECK(test_pick() == &threads[2]);
+	HOST_CHECK(test_pick() == &threads[0]);
+	HOST_CHECK(test_pick() == &threads[3]);
+	HOST_CHECK(ready_queues[ready_queues_index(0, prio)].head == NULL);
+	HOST_CHECK(ready_queues[ready_queues_index(0, prio)].tail == NULL);
+	HOST_CHECK(!test_prio_in_bitmap(prio));
+}
+
+static void test_release_queue(void)
+{
+	static const ticks_t release_at[] = { 30, 10, 20, 10 };
+	bool_t reprogram_saved = reprogram;
+
+	HOST_CHECK(release_queue == NULL);
+
+	for (word_t i = 0; i < ARRAY_SIZE(release_at); i++)
+	{
+		test_thread_init(&threads[i], TEST_PRIO_LOW);
+		memset(&scheds[i], 0, sizeof(scheds[i]));
+		scheds[i].refill_max = 1;
+		REFILL_HEAD(&scheds[i]).refill_time = release_at[i];
+		threads[i].sched = &scheds[i];
+		release_enqueue(&threads[i]);
+	}
+
+	/* ordered by release time, equal times in arrival order */
+	HOST_CHECK(release_queue == &threads[1]);
+	HOST_CHECK(threads[1].ready_q_next == &threads[3]);
+	HOST_CHECK(threads[3].ready_q_next == &threads[2]);
+	HOST_CHECK(threads[2].ready_q_next == &threads[0]);
+	HOST_CHECK(threads[0].ready_q_next == NULL);
+
+	release_remove(&threads[2]);
+	HOST_CHECK(threads[3].ready_q_next == &threads[0]);
+	HOST_CHECK(threads[0].ready_q_prev == &threads[3]);
+
+	HOST_CHECK(release_dequeue() == &threads[1]);
+	HOST_CHECK(release_dequeue() == &threads[3]);
+	HOST_CHECK(release_dequeue() == &threads[0]);
+	HOST_CHECK(release_queue == NULL);
+
+	reprogram = reprogram_saved;
+}
+
+static struct timer_event events[4];
+static word_t fired[ARRAY_SIZE(events)];
+static word_t fired_count;
+
+static word_t test_timer_handler(generptr_t data)
+{
+	fired[fired_count++] = (word_t)(uintptr_t)data;
+
+	/* one shot */
+	return 0;
+}
+
+static void test_timer_list(void)
+{
+	static const sword_t ticks[] = { 5, 2, 9, 5 };
+
+	fired_count = 0;
+
+	for (word_t i = 0; i < ARRAY_SIZE(events); i++)
+	{
+		initialize_timelist(&events[i]);
+		add_to_timelist(&events[i], test_timer_handler, (generptr_t)(uintptr_t)i, ticks[i]);
+	}
+
+	for (word_t i = 0; i < ARRAY_SIZE(events); i++)
+	{
+		HOST_CHECK(is_active_timelist(&events[i]));
+		HOST_CHECK_EQ(add_up_timelist(&events[i]), ticks[i]);
+	}
+	HOST_CHECK_EQ(get_next_timelist(), 2);
+
+	/* nothing is due a tick early */
+	native_posix_timer_advance(1 * CYC_PER_TICK);
+	HOST_CHECK_EQ(fired_count, 0);
+
+	native_posix_timer_advance(1 * CYC_PER_TICK);
+	HOST_CHECK_EQ(fired_count, 1);
+	HOST_CHECK_EQ(fired[0], 1);
+	HOST_CHECK(is_inactive_timelist(&events[1]));
+
+	/* equal deadlines fire together, in the order they were added */
+	native_posix_timer_advance(3 * CYC_PER_TICK);
+	HOST_CHECK_EQ(fired_count, 3);
+	HOST_CHECK_EQ(fired[1], 0);
+	HOST_CHECK_EQ(fired[2], 3);
+
+	native_posix_timer_advance(4 * CYC_PER_TICK);
+	HOST_CHECK_EQ(fired_count, 4);
+	HOST_CHECK_EQ(fired[3], 2);
+}
+
+static void test_timer_remove(void)
+{
+	fired_count = 0;
+
+	initialize_timelist(&events[0]);
+	add_to_timelist(&events[0], test_timer_handler, (generptr_t)0, 3);
+	remove_from_timelist(&events[0]);
+	HOST_CHECK(is_inactive_timelist(&events[0]));
+
+	native_posix_timer_advance(5 * CYC_PER_TICK);
+	HOST_CHECK_EQ(fired_count, 0);
+}
+
+#define TEST_OBJECTS 		8
+
+static byte_t objects[TEST_OBJECTS][sizeof(struct d_object) + sizeof(struct timer_event)] __aligned(sizeof(void *));
+
+static void test_object_lookup(void)
+{
+	static struct timer_event not_an_object;
+	void *names[TEST_OBJECTS];
+
+	for (word_t i = 0; i < TEST_OBJECTS; i++)
+	{
+		names[i] = d_object_carve(objects[i], obj_time_obj);
+		HOST_CHECK(names[i] != NULL);
+	}
+
+	for (word_t i = 0; i < TEST_OBJECTS; i++)
+	{
+		struct k_object *ko = k_object_find(names[i]);
+
+		HOST_CHECK(ko != NULL);
+		HOST_CHECK(ko->name == names[i]);
+		HOST_CHECK_EQ(ko->type, obj_time_obj);
+	}
+
+	HOST_CHECK(k_object_find(&not_an_object) == NULL);
+}
+
+/* room for two of the smallest objects, the heap blocks are small here */
+#define TEST_UNTYPED_SIZE 	(2 * WB_UP(sizeof(struct untyped_child) + \
+	sizeof(struct d_object) + sizeof(word_t)))
+
+/* an untyped is neither reset nor freed while objects carved from it live */
+static void test_untyped_children(void)
+{
+	void *untyped = d_object_alloc(obj_untyped_obj, TEST_UNTYPED_SIZE);
+	struct d_object *src = d_object_find(untyped);
+	void *carved[2];
+
+	HOST_CHECK(src != NULL);
+	HOST_CHECK_EQ(retype_untyped_bulk_object(src, obj_irq_handler_obj, 0, 2, carved), 
+		EXCEPTION_NONE);
+	HOST_CHECK(untyped_has_children(src));
+	HOST_CHECK_EQ(retype_untyped_object(&carved[0], obj_irq_handler_obj, TRUE, 0, src), 
+		EXCEPTION_SYSCALL_ERROR);
+
+	d_object_free(untyped);
+	HOST_CHECK(d_object_find(untyped) == src);
+
+	d_object_free(carved[0]);
+	HOST_CHECK(untyped_has_children(src));
+	d_object_free(carved[1]);
+	HOST_CHECK(!untyped_has_children(src));
+
+	d_object_free(untyped);
+	HOST_CHECK(d_object_find(untyped) == NULL);
+}
+
+/* what a reset untyped hands out again is cleared, not what the objects
+ * carved from it before left there */
+static void test_untyped_retype_reset(void)
+{
+	void *untyped = d_object_alloc(obj_untyped_obj, TEST_UNTYPED_SIZE);
+	struct d_object *src = d_object_find(untyped);
+	word_t size = get_k_object_size(obj_irq_handler_obj, 0);
+	byte_t *object;
+	void *first;
+
+	HOST_CHECK(src != NULL);
+	HOST_CHECK_EQ(retype_untyped_object(&first, obj_irq_handler_obj, FALSE, 0, src), 
+		EXCEPTION_NONE);
+	memset(first, 0xa5, size);
+	d_object_free(first);
+
+	HOST_CHECK_EQ(retype_untyped_object((void **)&object, obj_irq_handler_obj, TRUE, 0, src), 
+		EXCEPTION_NONE);
+	HOST_CHECK(object == first);
+	for (word_t i = 0; i < size; i++)
+	{
+		HOST_CHECK_EQ(object[i], 0);
+	}
+
+	/* without a reset the next one comes after it, not over it */
+	HOST_CHECK_EQ(retype_untyped_object(&first, obj_irq_handler_obj, FALSE, 0, src), 
+		EXCEPTION_NONE);
+	HOST_CHECK((byte_t *)first >= object + size);
+
+	d_object_free(first);
+	d_object_free(object);
+	d_object_free(untyped);
+	HOST_CHECK(d_object_find(untyped) == NULL);
+}
+
+static struct utcb utcbs[2];
+
+/* MR0-2 are saved registers, MR3 on are the words of the utcb */
+static void test_message_registers(void)
+{
+	struct ktcb *thread = &threads[0];
+
+	test_thread_init(thread, TEST_PRIO_LOW);
+	memset(&utcbs[0], 0, sizeof(utcbs[0]));
+	thread->user = &utcbs[0];
+
+	HOST_CHECK_EQ(MESSAGE_REGISTER_NUM, 3 + ARRAY_SIZE(utcbs[0].mr));
+
+	for (word_t i = 0; i < MESSAGE_REGISTER_NUM; i++)
+	{
+		store_message_registers(thread, i, 0x100 + i);
+	}
+
+	HOST_CHECK_EQ(thread->callee_saved.mr[5], 0x100);
+	HOST_CHECK_EQ(thread->callee_saved.mr[6], 0x101);
+	HOST_CHECK_EQ(thread->callee_saved.mr[7], 0x102);
+	for (word_t i = 0; i < ARRAY_SIZE(utcbs[0].mr); i++)
+	{
+		HOST_CHECK_EQ(utcbs[0].mr[i], 0x103 + i);
+	}
+
+	/* the last MR is the last word of mr[], the buffer registers after it
+	 * are not touched */
+	for (word_t i = 0; i < ARRAY_SIZE(utcbs[0].br); i++)
+	{
+		HOST_CHECK_EQ(utcbs[0].br[i], 0);
+	}
+
+	for (word_t i = 0; i < MESSAGE_REGISTER_NUM; i++)
+	{
+		HOST_CHECK_EQ(load_message_registers(thread, i), 0x100 + i);
+	}
+}
+
+static void test_ipc_untyped(void)
+{
+	struct ktcb *sender = &threads[0];
+	struct ktcb *receiver = &threads[1];
+	struct ktcb *action = scheduler_action;
+	message_tag_t tag = { .raw = 0 };
+	message_t *node;
+
+	for (word_t i = 0; i < 2; i++)
+	{
+		test_thread_init(&threads[i], TEST_PRIO_LOW);
+		memset(&utcbs[i], 0, sizeof(utcbs[i]));
+		threads[i].user = &utcbs[i];
+	}
+
+	node = (message_t *)d_object_alloc(obj_message_obj, 0);
+	HOST_CHECK(node != NULL);
+
+	/* MR1-6, across the registers and the utcb */
+	tag.s.u = 6;
+	store_message_registers(sender, 0, tag.raw);
+	for (word_t i = 1; i <= 6; i++)
+	{
+		store_message_registers(sender, i, 0x200 + i);
+	}
+
+	receive_ipc(receiver, TRUE, node);
+	HOST_CHECK_EQ(node->state, message_state_recv);
+
+	send_ipc(sender, TRUE, FALSE, node);
+	HOST_CHECK_EQ(node->state, message_state_idle);
+	HOST_CHECK_EQ(load_message_registers(receiver, 0), tag.raw);
+	for (word_t i = 1; i <= 6; i++)
+	{
+		HOST_CHECK_EQ(load_message_registers(receiver, i), 0x200 + i);
+	}
+	/* nothing past the message */
+	HOST_CHECK_EQ(load_message_registers(receiver, 7), 0);
+
+	if (is_thread_queued(receiver))
+	{
+		sched_dequeue(receiver);
+		marktcb_as_not_queued(receiver);
+	}
+	scheduler_action = action;
+	d_object_free(node);
+}
+
+/* the direct interrupt path leaves the handler running, not blocked,
+ * queued or restarting, and makes it the next thread */
+static void test_direct_signal(void)
+{
+	struct ktcb *handler = &threads[0];
+	struct ktcb *ready = _kernel.ready_thread;
+	notifation_t *node;
+
+	test_thread_init(handler, NUM_PRIORITIES - 1);
+	memset(&utcbs[0], 0, sizeof(utcbs[0]));
+	handler->user = &utcbs[0];
+
+	node = (notifation_t *)d_object_alloc(obj_notification_obj, 0);
+	HOST_CHECK(node != NULL);
+	node->bindedtcb = handler;
+	handler->notifation_node = node;
+
+	recevie_signal(handler, node, TRUE);
+	HOST_CHECK_EQ(node->state, notifation_state_wait);
+	HOST_CHECK(!is_thread_running(handler));
+
+	/* what a syscall entry leaves set is cleared too */
+	set_thread_states(handler, state_restart_state);
+	direct_signal(handler, node, BIT(3));
+	direct_switchto(handler);
+
+	HOST_CHECK(is_thread_running(handler));
+	HOST_CHECK_EQ(node->state, notifation_state_idle);
+	HOST_CHECK(node->queue.head == NULL);
+	HOST_CHECK_EQ(load_message_registers(handler, NOTIFATION_BADGE_MR), BIT(3));
+	HOST_CHECK(_kernel.ready_thread == handler);
+
+	_kernel.ready_thread = ready;
+	handler->notifation_node = NULL;
+	d_object_free(node);
+}
+
+/* A caller of exchange_ipc is switched out first and blocked by the
+ * privilege thread after, only the time from then on is a wait. The
+ * counters are charged on the simulated cycle counter, less than a tick
+ * at a time so no timeout fires in between. */
+static void test_thread_stats(void)
+{
+	struct ktcb *waiter = &threads[0];
+	struct ktcb *other = &threads[1];
+	struct ktcb *current = _current_thread;
+	struct ktcb *action = scheduler_action;
+	message_t *node;
+
+	for (word_t i = 0; i < 2; i++)
+	{
+		test_thread_init(&threads[i], TEST_PRIO_LOW);
+		thread_stats_init(&threads[i]);
+		memset(&utcbs[i], 0, sizeof(utcbs[i]));
+		threads[i].user = &utcbs[i];
+	}
+
+	node = (message_t *)d_object_alloc(obj_message_obj, 0);
+	HOST_CHECK(node != NULL);
+
+	thread_stats_switched_in(waiter);
+	native_posix_timer_advance(10);
+
+	thread_stats_voluntary(waiter);
+	thread_stats_switched_in(other);
+	native_posix_timer_advance(20);
+
+	receive_ipc(waiter, TRUE, node);
+	native_posix_timer_advance(30);
+	send_ipc(other, TRUE, FALSE, node);
+	native_posix_timer_advance(40);
+
+	thread_stats_switched_in(waiter);
+
+	HOST_CHECK_EQ(waiter->cold.runtime_stats.run_cycles, 10);
+	HOST_CHECK_EQ(waiter->cold.runtime_stats.recv_wait_cycles, 70);
+	HOST_CHECK_EQ(waiter->cold.runtime_stats.send_wait_cycles, 0);
+	HOST_CHECK_EQ(waiter->cold.runtime_stats.switches_in, 2);
+	HOST_CHECK_EQ(waiter->cold.runtime_stats.voluntary_switches, 1);
+	HOST_CHECK_EQ(waiter->cold.runtime_stats.involuntary_switches, 0);
+
+	/* other was still ready when it left */
+	HOST_CHECK_EQ(other->cold.runtime_stats.run_cycles, 90);
+	HOST_CHECK_EQ(other->cold.runtime_stats.switches_in, 1);
+	HOST_CHECK_EQ(other->cold.runtime_stats.voluntary_switches, 0);
+	HOST_CHECK_EQ(other->cold.runtime_stats.involuntary_switches, 1);
+
+	thread_stats_switched_in(current);
+
+	if (is_thread_queued(waiter))
+	{
+		sched_dequeue(waiter);
+		marktcb_as_not_queued(waiter);
+	}
+	scheduler_action = action;
+	d_object_free(node);
+}
+
+static void test_mempool(void)
+{
+	static void *blocks[CONFIG_KERNEL_OBJECT_NUMBER * 16];
+	word_t count = 0;
+	word_t again = 0;
+	byte_t *zeroed;
+
+	/* dirty a block for calloc to clear */
+	blocks[0] = malloc_object(64);
+	HOST_CHECK(blocks[0] != NULL);
+	memset(blocks[0], 0xa5, 64);
+	free_object(blocks[0]);
+
+	zeroed = calloc_object(8, 8);
+	HOST_CHECK(zeroed != NULL);
+	for (word_t i = 0; i < 64; i++)
+	{
+		HOST_CHECK_EQ(zeroed[i], 0);
+	}
+	free_object(zeroed);
+
+	/* what is freed can be allocated again, all of it */
+	while (count < ARRAY_SIZE(blocks) && (blocks[count] = malloc_object(64)) != NULL)
+	{
+		count++;
+	}
+	HOST_CHECK(count > 0);
+	HOST_CHECK(count < ARRAY_SIZE(blocks));
+
+	for (word_t i = 0; i < count; i++)
+	{
+		free_object(blocks[i]);
+	}
+
+	while (again < ARRAY_SIZE(blocks) && (blocks[again] = malloc_object(64)) != NULL)
+	{
+		again++;
+	}
+	HOST_CHECK_EQ(again, count);
+
+	for (word_t i = 0; i < again; i++)
+	{
+		free_object(blocks[i]);
+	}
+}
+
+struct test_rb_item {
+	struct rbnode node;
+	word_t key;
+};
+
+#define TEST_RB_ITEMS 		64
+
+static struct test_rb_item rb_items[TEST_RB_ITEMS];
+
+static bool_t test_rb_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	return CONTAINER_OF(a, struct test_rb_item, node)->key <
+		CONTAINER_OF(b, struct test_rb_item, node)->key;
+}
+
+static struct rbtree rb_tree = {
+	.lessthan_fn = test_rb_lessthan
+};
+
+static word_t rb_last_key;
+static bool_t rb_in_order;
+
+static void test_rb_visit(struct rbnode *node, void *cookie)
+{
+	word_t key = CONTAINER_OF(node, struct test_rb_item, node)->key;
+
+	ARG_UNUSED(cookie);
+	if (key <= rb_last_key)
+	{
+		rb_in_order = FALSE;
+	}
+	rb_last_key = key;
+}
+
+static void test_rbtree(void)
+{
+	for (word_t i = 0; i < TEST_RB_ITEMS; i++)
+	{
+		/* 37 is coprime to 64, so every key shows up once, shuffled */
+		rb_items[i].key = (i * 37) % TEST_RB_ITEMS + 1;
+		rb_node_init(&rb_items[i].node);
+		rb_insert(&rb_tree, &rb_items[i].node);
+	}
+
+	HOST_CHECK_EQ(CONTAINER_OF(rb_get_min(&rb_tree), struct test_rb_item, node)->key, 1);
+	HOST_CHECK_EQ(CONTAINER_OF(rb_get_max(&rb_tree), struct test_rb_item, node)->key, TEST_RB_ITEMS);
+
+	rb_last_key = 0;
+	rb_in_order = TRUE;
+	rb_walk(&rb_tree, test_rb_visit, NULL);
+	HOST_CHECK(rb_in_order);
+
+	for (word_t i = 0; i < TEST_RB_ITEMS; i += 2)
+	{
+		rb_remove(&rb_tree, &rb_items[i].node);
+	}
+
+	for (word_t i = 0; i < TEST_RB_ITEMS; i++)
+	{
+		HOST_CHECK_EQ(rb_contains(&rb_tree, &rb_items[i].node), (i % 2) != 0);
+	}
+
+	for (word_t i = 1; i < TEST_RB_ITEMS; i += 2)
+	{
+		rb_remove(&rb_tree, &rb_items[i].node);
+	}
+	HOST_CHECK(rb_get_min(&rb_tree) == NULL);
+}
+
+static const struct host_test tests[] = {
+	HOST_TEST(test_ready_queue_bitmap),
+	HOST_TEST(test_ready_queue_order),
+	HOST_TEST(test_release_queue),
+	HOST_TEST(test_timer_list),
+	HOST_TEST(test_timer_remove),
+	HOST_TEST(test_object_lookup),
+	HOST_TEST(test_untyped_children),
+	HOST_TEST(test_untyped_retype_reset),
+	HOST_TEST(test_message_registers),
+	HOST_TEST(test_ipc_untyped),
+	HOST_TEST(test_direct_signal),
+	HOST_TEST(test_thread_stats),
+	HOST_TEST(test_mempool),
+	HOST_TEST(test_rbtree),
+};
+
+void main(void)
+{
+	dummy_thread.base.thread_state.obj_state = state_dummy_state;
+
+	host_test_run(tests, ARRAY_SIZE(tests));
+}
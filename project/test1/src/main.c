@@ -10,8 +10,10 @@
 #include <inc_l4/message.h>
 #include <inc_l4/schedule.h>
 
+#if defined(CONFIG_SOC_FAMILY_STM32)
 #include <drivers/stm32f4xx_hal_gpio.h>
 #include <drivers/stm32f4xx_hal_rcc.h>
+#endif
 
 static THREAD_STACK_DEFINE(stack_1, 256);
 
@@ -50,6 +52,7 @@ static L4_ThreadId_t task1_pager = {
 	.raw = (word_t)&pager_1
 };
 
+#if defined(CONFIG_SOC_FAMILY_STM32)
 static L4_Msg_t task1_msg;
 
 static L4_Word_t task1_page[2] = {
@@ -65,6 +68,7 @@ static L4_Word_t task1_page0[2] = {
 	(0x40023800 & 0xFFFFFFC0) | 0xA,
 	(0x4000 & 0xFFFFFFF0) | 0x7
 };
+#endif
 
 /*
 static void _write(L4_Word_t *base, L4_Word_t len, L4_Word_t num)
@@ -79,6 +83,7 @@ static void _write(L4_Word_t *base, L4_Word_t len, L4_Word_t num)
 /* ENTRY_1 function is in a user mode state */
 void entry_1(void *p1, void *p2, void *p3)
 {
+#if defined(CONFIG_SOC_FAMILY_STM32)
 	GPIO_InitTypeDef  GPIO_InitStructure;
 	L4_Word_t *gpiog = (L4_Word_t *)0x40021800;
 	L4_Word_t flag = 0x0;
@@ -104,6 +109,13 @@ void entry_1(void *p1, void *p2, void *p3)
 		flag++;
 		L4_Yield();
 	}
+#else
+	/* No LEDs on the emulated boards, main reports on the console */
+	for (;;)
+	{
+		L4_Yield();
+	}
+#endif
 }
 
 /* The MAIN function is in a pseudo-privileged mode state */
@@ -120,6 +132,7 @@ void main(void)
 	L4_ThreadControl(task1_id, task1_space, task1_sched, task1_pager, (void *)0);
 	L4_Schedule(task1_id, 100 << 20 | 100 << 8 | 2, 0, 0xff << 24 | 1 << 12 | 1, 0, (L4_Word_t *)0);
 
+#if defined(CONFIG_SOC_FAMILY_STM32)
 	/* alloc task1 space and other resource */
 	L4_MsgClear(&task1_msg);
 	L4_MsgPut(&task1_msg, 0, 0, L4_NULL, 2, task1_page);
@@ -134,6 +147,9 @@ void main(void)
 	// test
 	L4_Word_t *usart1_dr = (L4_Word_t *)0x40011004;
 	*usart1_dr = 0x12;
+#else
+	printk("Hello World: WellsL4 OS on %s!\r\n", CONFIG_BOARD);
+#endif
 
 	/* exit main task */
 	L4_Yield();
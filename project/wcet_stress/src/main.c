@@ -0,0 +1,235 @@
+#include <sys/printk.h>
+#include <sys/util.h>
+#include <kernel_object.h>
+#include <kernel/stack.h>
+#include <kernel/thread.h>
+#include <object/tcb.h>
+#include <benchmark/wcet.h>
+#include <version.h>
+
+#include <inc_l4/types.h>
+#include <inc_l4/thread.h>
+#include <inc_l4/ipc.h>
+#include <inc_l4/message.h>
+#include <inc_l4/schedule.h>
+#include <syscalls/objecttype.h>
+#include <syscalls/cnode.h>
+#include <syscalls/wcet.h>
+
+/* Drives the kernel entries into their worst cases while
+ * CONFIG_WCET_STATS records the longest of each, then prints them:
+ * - full ready queues: a filler yields on every priority the thread
+ *   table leaves room for, so every selection sees all of them
+ * - many timers: sleepers with distinct periods keep that many timeouts
+ *   in the timer list, every new one is inserted behind the others
+ * - deep revoke: access to each of STRESS_OBJECTS objects is granted and
+ *   revoked, then they are freed, with the object tree at its largest
+ * Every thread is a user thread, so its calls go through the system
+ * call entry that is timed.
+ */
+
+#define STRESS_STACK_SIZE 			1024
+#define STRESS_SMALL_STACK_SIZE 	256
+
+/* The kernel keeps every thread in one table (record_threads), the
+ * setup thread, the driver and the sleepers leave the rest to the
+ * fillers, as far as there are levels below the sleepers. */
+#define STRESS_THREAD_TABLE 		THREAD_TABLE_SIZE
+#define STRESS_SLEEPERS 			64
+#define STRESS_FILLERS 				MIN(STRESS_THREAD_TABLE - STRESS_SLEEPERS - 2, \
+										NUM_PRIORITIES - STRESS_SLEEPERS - 1)
+
+/* objects revoked per round, their handles are on the driver's stack */
+#define STRESS_OBJECTS 				128
+#define STRESS_OBJECT_SIZE 			16
+
+#define STRESS_ROUNDS 				100
+
+/* the sleepers wake every STRESS_SLEEP_US * (n + 1) */
+#define STRESS_SLEEP_US 			1000
+/* how long the driver leaves the others to run between rounds */
+#define STRESS_PAUSE_US 			20000
+
+/* budget << 20 | period << 8 | refills, in ticks */
+#define STRESS_TIME_RR 				(100 << 20 | 100 << 8 | 2)
+
+/* fillers take the lowest levels, the sleepers the ones above them;
+ * setup and then the driver are on top of everything */
+#define STRESS_PRIO_TOP 			(NUM_PRIORITIES - 1)
+#define STRESS_PRIO_SLEEPER(n) 		(STRESS_FILLERS + (n))
+#define STRESS_PRIO_FILLER(n) 		(n)
+
+BUILD_ASSERT_MSG(STRESS_THREAD_TABLE > STRESS_SLEEPERS + 2 &&
+	NUM_PRIORITIES > STRESS_SLEEPERS + 1,
+	"wcet_stress needs more threads and priorities than it has sleepers");
+
+/* user threads, see thread_control; setup is privileged */
+#define STRESS_USER_OPTION 			(1 << 2)
+
+#define STRESS_TID(n) 				((L4_ThreadId_t) { .raw = (n) << 14 })
+
+static L4_ThreadId_t main_id = {
+	.raw = 2 << 14
+};
+
+static L4_ThreadId_t stress_space = {
+	.raw = 2 << 14
+};
+
+static L4_ThreadId_t stress_sched = {
+	.raw = 3 << 14
+};
+
+#define setup_id 			STRESS_TID(256)
+#define driver_id 			STRESS_TID(257)
+#define sleeper_id(n) 		STRESS_TID(258 + (n))
+#define filler_id(n) 		STRESS_TID(258 + STRESS_SLEEPERS + (n))
+
+static THREAD_STACK_DEFINE(setup_stack, STRESS_STACK_SIZE);
+static THREAD_STACK_DEFINE(driver_stack, STRESS_STACK_SIZE);
+static THREAD_STACK_ARRAY_DEFINE(sleeper_stacks, STRESS_SLEEPERS, STRESS_SMALL_STACK_SIZE);
+static THREAD_STACK_ARRAY_DEFINE(filler_stacks, STRESS_FILLERS, STRESS_SMALL_STACK_SIZE);
+
+static struct utcb setup_utcb;
+static struct utcb driver_utcb;
+static struct utcb sleeper_utcbs[STRESS_SLEEPERS];
+static struct utcb filler_utcbs[STRESS_FILLERS];
+
+static pager_context_t setup_pager;
+static pager_context_t driver_pager;
+static pager_context_t sleeper_pagers[STRESS_SLEEPERS];
+static pager_context_t filler_pagers[STRESS_FILLERS];
+
+static void stress_pager_init(pager_context_t *pager, struct thread_stack *stack,
+	size_t stack_size, struct utcb *utcb, ktcb_entry_t entry, void *p1,
+	word_t options)
+{
+	pager->stack_ptr = stack;
+	pager->stack_size = stack_size;
+	pager->entry = entry;
+	pager->p1 = p1;
+	pager->p2 = (void *)0;
+	pager->p3 = (void *)0;
+	pager->options = options;
+	pager->virual_user = utcb;
+}
+
+static void stress_thread_start(L4_ThreadId_t id, pager_context_t *pager,
+	L4_Word_t prior)
+{
+	L4_ThreadId_t pager_id = {
+		.raw = (L4_Word_t)pager
+	};
+
+	L4_ThreadControl(id, stress_space, stress_sched, pager_id, (void *)0);
+	L4_Schedule(id, STRESS_TIME_RR, 0, 0xff << 24 | prior << 12 | prior, 0, (L4_Word_t *)0);
+}
+
+/* keeps its level of the ready queues populated */
+void filler_entry(void *p1, void *p2, void *p3)
+{
+	for (;;)
+	{
+		L4_Yield();
+	}
+}
+
+/* p1 is the index of the sleeper */
+void sleeper_entry(void *p1, void *p2, void *p3)
+{
+	L4_Time_t period = L4_TimePeriod(STRESS_SLEEP_US * ((L4_Word_t)p1 + 1));
+
+	for (;;)
+	{
+		L4_Sleep(period);
+	}
+}
+
+/* setup sends the driver its own tcb first, the objects are granted to it */
+void driver_entry(void *p1, void *p2, void *p3)
+{
+	L4_Word_t self;
+	void *objects[STRESS_OBJECTS];
+
+	L4_Receive(setup_id);
+	L4_StoreMR(1, &self);
+
+	for (word_t round = 0; round < STRESS_ROUNDS; round++)
+	{
+		for (word_t i = 0; i < STRESS_OBJECTS; i++)
+		{
+			objects[i] = dobject_alloc(obj_untyped_obj, STRESS_OBJECT_SIZE);
+			if (objects[i] != NULL)
+			{
+				kobject_access_grant(objects[i], (struct ktcb *)self);
+			}
+		}
+
+		/* in allocation order, so the tree rebalances all the way */
+		for (word_t i = 0; i < STRESS_OBJECTS; i++)
+		{
+			if (objects[i] != NULL)
+			{
+				kobject_access_revoke(objects[i], (struct ktcb *)self);
+				dobject_free(objects[i]);
+			}
+		}
+
+		L4_Sleep(L4_TimePeriod(STRESS_PAUSE_US));
+	}
+
+	wcet_print(0);
+	printk("WCET end\n");
+
+	L4_Receive(driver_id);
+}
+
+/* Starts every other thread from above them, so none of them runs
+ * before all are there. The driver shares the top level and only gets
+ * to run when setup blocks in the send of its tcb.
+ */
+void setup_entry(void *p1, void *p2, void *p3)
+{
+	L4_Msg_t msg;
+	L4_Word_t self;
+
+	for (word_t n = 0; n < STRESS_FILLERS; n++)
+	{
+		stress_pager_init(&filler_pagers[n], filler_stacks[n], STRESS_SMALL_STACK_SIZE,
+			&filler_utcbs[n], filler_entry, (void *)0, STRESS_USER_OPTION);
+		stress_thread_start(filler_id(n), &filler_pagers[n], STRESS_PRIO_FILLER(n));
+	}
+
+	for (word_t n = 0; n < STRESS_SLEEPERS; n++)
+	{
+		stress_pager_init(&sleeper_pagers[n], sleeper_stacks[n], STRESS_SMALL_STACK_SIZE,
+			&sleeper_utcbs[n], sleeper_entry, (void *)n, STRESS_USER_OPTION);
+		stress_thread_start(sleeper_id(n), &sleeper_pagers[n], STRESS_PRIO_SLEEPER(n));
+	}
+
+	stress_pager_init(&driver_pager, driver_stack, STRESS_STACK_SIZE,
+		&driver_utcb, driver_entry, (void *)0, STRESS_USER_OPTION);
+	stress_thread_start(driver_id, &driver_pager, STRESS_PRIO_TOP);
+
+	self = (L4_Word_t)get_thread(driver_id.raw);
+
+	L4_MsgClear(&msg);
+	L4_MsgPut(&msg, 0, 1, &self, 0, L4_NULL);
+	L4_MsgLoad(&msg);
+	L4_Send(driver_id);
+
+	L4_Receive(setup_id);
+}
+
+void main(void)
+{
+	printk("WCET begin board=%s kernel=%s rounds=%u\n",
+		CONFIG_BOARD, KERNEL_VERSION_STRING, STRESS_ROUNDS);
+
+	stress_pager_init(&setup_pager, setup_stack, STRESS_STACK_SIZE,
+		&setup_utcb, setup_entry, (void *)0, 0);
+	stress_thread_start(setup_id, &setup_pager, STRESS_PRIO_TOP);
+
+	/* nobody sends to main, the fillers take its level as well */
+	L4_Receive(main_id);
+}
@@ -0,0 +1,52 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief DWT cycle counter helpers for Cortex-M CPUs
+ *
+ * The statistics, the trace ring, the cycle clock and the benchmarks all
+ * time with CYCCNT; each of them enables it through here.
+ */
+
+#ifndef ARCH_ARM_INCLUDE_AARCH32_CORTEX_M_DWT_H_
+#define ARCH_ARM_INCLUDE_AARCH32_CORTEX_M_DWT_H_
+
+#if defined(CONFIG_CPU_CORTEX_M_HAS_DWT)
+
+#include <types_def.h>
+#include <arch/arm/aarch32/cortex_m/cmsis.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Start the DWT cycle counter
+ *
+ * CYCCNT is never reset here, so a user that is already timing with it
+ * keeps a monotonic count when another one enables it again.
+ *
+ * @return FALSE if the DWT has no cycle counter
+ */
+static FORCE_INLINE bool_t arm_dwt_cycle_count_enable(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+
+	if (DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk)
+	{
+		return FALSE;
+	}
+
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	return TRUE;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_CPU_CORTEX_M_HAS_DWT */
+
+#endif /* ARCH_ARM_INCLUDE_AARCH32_CORTEX_M_DWT_H_ */
@@ -26,6 +26,15 @@ static FORCE_INLINE u32_t arch_k_cycle_get_32(void)
 	return clock_cycle_get_32();
 }
 
+#if defined(CONFIG_SYSTEM_CLOCK_CYCLES_64)
+extern u64_t clock_cycle_get_64(void);
+
+static FORCE_INLINE u64_t arch_k_cycle_get_64(void)
+{
+	return clock_cycle_get_64();
+}
+#endif
+
 static FORCE_INLINE void arch_nop(void)
 {
 	__asm__ volatile("nop");
@@ -21,6 +21,11 @@
 #define _SVC_CALL_RUNTIME_EXCEPT	2
 #define _SVC_CALL_SYSTEM_CALL		3
 
+/* dedicated numbers of the hot system calls, see CONFIG_SYSCALL_DIRECT_SVC */
+#define _SVC_CALL_EXCHANGE_IPC		4
+#define _SVC_CALL_SWITCH_THREAD		5
+#define _SVC_CALL_SYSTEM_CLOCK		6
+
 #ifdef CONFIG_USERSPACE
 #ifndef _ASMLANGUAGE
 
@@ -163,6 +168,68 @@ static inline uintptr_t arch_syscall_invoke0(uintptr_t call_id)
 	return ret;
 }
 
+#if defined(CONFIG_SYSCALL_DIRECT_SVC)
+/* Direct invocation through a dedicated SVC number. The call id is not
+ * passed, the kernel loads the handler address into r6 instead, so r6 is
+ * clobbered. The number must be a constant, hence macros.
+ */
+#define arch_syscall_direct_invoke0(svid) \
+({ \
+	register uint32_t ret __asm__("r0"); \
+	__asm__ volatile("svc %[svid]\n" \
+			 : "=r"(ret) \
+			 : [svid] "i" (svid) \
+			 : "r1", "r2", "r3", "r6", "r8", "memory", "ip"); \
+	(uintptr_t)ret; \
+})
+
+#define arch_syscall_direct_invoke1(arg1, svid) \
+({ \
+	register uint32_t ret __asm__("r0") = (arg1); \
+	__asm__ volatile("svc %[svid]\n" \
+			 : "=r"(ret) \
+			 : [svid] "i" (svid), "r" (ret) \
+			 : "r1", "r2", "r3", "r6", "r8", "memory", "ip"); \
+	(uintptr_t)ret; \
+})
+
+#define arch_syscall_direct_invoke2(arg1, arg2, svid) \
+({ \
+	register uint32_t ret __asm__("r0") = (arg1); \
+	register uint32_t r1 __asm__("r1") = (arg2); \
+	__asm__ volatile("svc %[svid]\n" \
+			 : "=r"(ret), "=r"(r1) \
+			 : [svid] "i" (svid), "r" (ret), "r" (r1) \
+			 : "r2", "r3", "r6", "r8", "memory", "ip"); \
+	(uintptr_t)ret; \
+})
+
+#define arch_syscall_direct_invoke3(arg1, arg2, arg3, svid) \
+({ \
+	register uint32_t ret __asm__("r0") = (arg1); \
+	register uint32_t r1 __asm__("r1") = (arg2); \
+	register uint32_t r2 __asm__("r2") = (arg3); \
+	__asm__ volatile("svc %[svid]\n" \
+			 : "=r"(ret), "=r"(r1), "=r"(r2) \
+			 : [svid] "i" (svid), "r" (ret), "r" (r1), "r" (r2) \
+			 : "r3", "r6", "r8", "memory", "ip"); \
+	(uintptr_t)ret; \
+})
+
+#define arch_syscall_direct_invoke4(arg1, arg2, arg3, arg4, svid) \
+({ \
+	register uint32_t ret __asm__("r0") = (arg1); \
+	register uint32_t r1 __asm__("r1") = (arg2); \
+	register uint32_t r2 __asm__("r2") = (arg3); \
+	register uint32_t r3 __asm__("r3") = (arg4); \
+	__asm__ volatile("svc %[svid]\n" \
+			 : "=r"(ret), "=r"(r1), "=r"(r2), "=r"(r3) \
+			 : [svid] "i" (svid), "r" (ret), "r" (r1), "r" (r2), "r" (r3) \
+			 : "r6", "r8", "memory", "ip"); \
+	(uintptr_t)ret; \
+})
+#endif /* CONFIG_SYSCALL_DIRECT_SVC */
+
 static inline bool arch_is_user_context(void)
 {
 #if defined(CONFIG_CPU_CORTEX_M) 
@@ -28,6 +28,17 @@ static FORCE_INLINE u32_t arch_k_cycle_get_32(void)
 	return clock_cycle_get_32();
 }
 
+/* The architected virtual counter is 64 bits wide already */
+static FORCE_INLINE u64_t arch_k_cycle_get_64(void)
+{
+	u64_t cntvct;
+
+	__asm__ volatile("isb\n\t"
+			 "mrs %0, cntvct_el0" : "=r" (cntvct) : : "memory");
+
+	return cntvct;
+}
+
 static FORCE_INLINE void arch_nop(void)
 {
 	__asm__ volatile("nop");
@@ -15,38 +15,63 @@
 extern "C" {
 #endif
 
+/* The virtual timer (CNTV_*) is the default; the EL1 physical timer
+ * (CNTP_*) is used when the kernel owns CNTVOFF or runs without a
+ * hypervisor that virtualises it.
+ */
+#if defined(CONFIG_ARM_ARCH_TIMER_PHYSICAL)
+#define ARM_ARCH_TIMER_IRQ	((ARM_TIMER_NON_SECURE_IRQ + 1) << 8)
+#define ARM_ARCH_TIMER_CVAL	"cntp_cval_el0"
+#define ARM_ARCH_TIMER_CTL	"cntp_ctl_el0"
+#define ARM_ARCH_TIMER_CNT	"cntpct_el0"
+#else
 #define ARM_ARCH_TIMER_IRQ	((ARM_TIMER_VIRTUAL_IRQ + 1) << 8)
+#define ARM_ARCH_TIMER_CVAL	"cntv_cval_el0"
+#define ARM_ARCH_TIMER_CTL	"cntv_ctl_el0"
+#define ARM_ARCH_TIMER_CNT	"cntvct_el0"
+#endif
+
 #define CNTV_CTL_ENABLE		((1) << 0)
 
 
 static FORCE_INLINE void arm_arch_timer_set_compare(u64_t val)
 {
-	__asm__ volatile("msr cntv_cval_el0, %0\n\t" : : "r" (val) : "memory");
+	__asm__ volatile("msr " ARM_ARCH_TIMER_CVAL ", %0\n\t" : : "r" (val) : "memory");
 }
 
 static FORCE_INLINE void arm_arch_timer_enable(unsigned char enable)
 {
-	u32_t cntv_ctl;
+	u64_t cntv_ctl;
 
-	__asm__ volatile("mrs %0, cntv_ctl_el0\n\t" : "=r" (cntv_ctl) :  : "memory");
+	__asm__ volatile("mrs %0, " ARM_ARCH_TIMER_CTL "\n\t" : "=r" (cntv_ctl) :  : "memory");
 
 	if (enable)
 		cntv_ctl |= CNTV_CTL_ENABLE;
 	else
 		cntv_ctl &= ~CNTV_CTL_ENABLE;
 
-	__asm__ volatile("msr cntv_ctl_el0, %0\n\t" : : "r" (cntv_ctl) : "memory");
+	__asm__ volatile("msr " ARM_ARCH_TIMER_CTL ", %0\n\t" : : "r" (cntv_ctl) : "memory");
 }
 
 static FORCE_INLINE u64_t arm_arch_timer_count(void)
 {
 	u64_t cntvct_el0;
 
-	__asm__ volatile("mrs %0, cntvct_el0\n\t" : "=r" (cntvct_el0) : : "memory");
+	__asm__ volatile("isb\n\t"
+			 "mrs %0, " ARM_ARCH_TIMER_CNT "\n\t" : "=r" (cntvct_el0) : : "memory");
 
 	return cntvct_el0;
 }
 
+static FORCE_INLINE u32_t arm_arch_timer_freq(void)
+{
+	u64_t cntfrq_el0;
+
+	__asm__ volatile("mrs %0, cntfrq_el0\n\t" : "=r" (cntfrq_el0) : : "memory");
+
+	return (u32_t)cntfrq_el0;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -11,6 +11,8 @@
 #include <arch/arm/aarch64/kernel_offsets.h>
 #elif defined(CONFIG_ARM)
 #include <arch/arm/aarch32/kernel_offsets.h>
+#elif defined(CONFIG_ARCH_POSIX)
+#include <arch/posix/kernel_offsets.h>
 #endif
 
 
@@ -0,0 +1,36 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief POSIX (host) specific kernel interface header
+ *
+ * Stub architecture that lets the portable kernel core run as a plain
+ * user space program on the build host, for unit tests and
+ * microbenchmarks. There are no interrupts, no MMU and no real context
+ * switch; see src/arch/posix for what is emulated.
+ */
+
+#ifndef ARCH_POSIX_ARCH_H_
+#define ARCH_POSIX_ARCH_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STACK_ALIGN		16
+#define THREAD_STACK_ALIGN_SIZE	STACK_ALIGN
+
+#include <arch/posix/thread.h>
+#include <kernel_object.h>
+#include <arch/posix/exc.h>
+#include <arch/posix/irq.h>
+#include <arch/posix/misc.h>
+#include <arch/posix/arch_inlines.h>
+#include <arch/posix/sys_io.h>
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,53 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ARCH_POSIX_ARCH_INLINES_H_
+#define ARCH_POSIX_ARCH_INLINES_H_
+
+/*
+ * The file must not be included directly
+ * Include arch/cpu.h instead
+ */
+
+#ifndef _ASMLANGUAGE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Nothing preempts the host thread, the lock is a flag so that the
+ * checks of the portable code still see a consistent state */
+extern word_t posix_irq_locked;
+
+static FORCE_INLINE word_t arch_get_curr_cpu_index(void)
+{
+	return 0;
+}
+
+static FORCE_INLINE word_t arch_irq_lock(void)
+{
+	word_t key = posix_irq_locked;
+
+	posix_irq_locked = 1;
+	compiler_barrier();
+	return key;
+}
+
+static FORCE_INLINE void arch_irq_unlock(word_t key)
+{
+	compiler_barrier();
+	posix_irq_locked = key;
+}
+
+static FORCE_INLINE bool arch_irq_unlocked(word_t key)
+{
+	return key == 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+#endif
@@ -0,0 +1,29 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ARCH_POSIX_EXC_H_
+#define ARCH_POSIX_EXC_H_
+
+#ifndef _ASMLANGUAGE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct esf {
+	struct basic_esf {
+		u64_t regs[8];
+	} basic;
+};
+
+typedef struct esf arch_esf_t;
+typedef struct esf _esf_t;
+typedef struct basic_esf _basic_sf_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+#endif
@@ -0,0 +1,69 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief POSIX (host) interrupt handling
+ *
+ * The host has no interrupt controller. Connected handlers are only
+ * recorded, a test raises them by calling posix_irq_raise().
+ */
+
+#ifndef ARCH_POSIX_IRQ_H_
+#define ARCH_POSIX_IRQ_H_
+
+#include <arch/irq.h>
+#include <sys/stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef _ASMLANGUAGE
+extern void arch_irq_enable(word_t irq);
+extern void arch_irq_disable(word_t irq);
+extern sword_t arch_irq_is_enabled(word_t irq);
+extern word_t arch_is_irq_pending(void);
+
+extern void posix_irq_connect(word_t irq, void (*isr)(generptr_t), generptr_t arg);
+extern void posix_irq_raise(word_t irq);
+
+#define ARCH_IRQ_DYNC_CONNECT(irq_p, sched_prior_p, isr_p, isr_param_p, flags_p) \
+({ \
+	posix_irq_connect(irq_p, (void (*)(generptr_t))(isr_p), (generptr_t)(isr_param_p)); \
+	irq_p; \
+})
+
+#define ARCH_IRQ_DIRECT_CONNECT(irq_p, sched_prior_p, isr_p, flags_p) \
+({ \
+	posix_irq_connect(irq_p, (void (*)(generptr_t))(isr_p), NULL); \
+	irq_p; \
+})
+
+#define ARCH_ISR_DIRECT_HEADER()
+#define ARCH_ISR_DIRECT_FOOTER(swap)
+#define ARCH_ISR_DIRECT_PM()
+
+#define ARCH_ISR_DIRECT_DECLARE(name) \
+	static FORCE_INLINE bool_t name##_body(void); \
+	void name(void) \
+	{ \
+		(void)name##_body(); \
+	} \
+	static FORCE_INLINE bool_t name##_body(void)
+
+/* non-zero while posix_irq_raise() runs a handler */
+extern word_t posix_irq_nest;
+
+static FORCE_INLINE bool arch_is_in_isr(void)
+{
+	return posix_irq_nest != 0U;
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,13 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ARCH_POSIX_KERNEL_OFFSETS_H_
+#define ARCH_POSIX_KERNEL_OFFSETS_H_
+
+#include <offsets.h>
+
+#define _thread_offset_to_swap_return_value \
+	(__ktcb_t_arch_OFFSET + __thread_arch_t_swap_return_value_OFFSET)
+
+#endif
@@ -0,0 +1,51 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ARCH_POSIX_MISC_H_
+#define ARCH_POSIX_MISC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef _ASMLANGUAGE
+
+struct interrupt_stack;
+struct ktcb;
+
+extern u32_t clock_cycle_get_32(void);
+
+static FORCE_INLINE u32_t arch_k_cycle_get_32(void)
+{
+	return clock_cycle_get_32();
+}
+
+#if defined(CONFIG_SYSTEM_CLOCK_CYCLES_64)
+extern u64_t clock_cycle_get_64(void);
+
+static FORCE_INLINE u64_t arch_k_cycle_get_64(void)
+{
+	return clock_cycle_get_64();
+}
+#endif
+
+static FORCE_INLINE void arch_nop(void)
+{
+	__asm__ volatile("nop");
+}
+
+static FORCE_INLINE void arch_kernel_init(struct interrupt_stack *int_stack)
+{
+}
+
+/* out of line, struct ktcb is not complete yet here */
+void arch_thread_swap_retval_set(struct ktcb *thread, u32_t value);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
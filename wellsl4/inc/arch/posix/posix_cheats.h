@@ -0,0 +1,23 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Force included into every kernel and application file of a
+ * POSIX build
+ *
+ * The host process has a main() of its own, in posix_host.c, which
+ * boots the kernel. The main() of the application, the one the main
+ * thread runs, is renamed so the two do not clash.
+ */
+
+#ifndef ARCH_POSIX_POSIX_CHEATS_H_
+#define ARCH_POSIX_POSIX_CHEATS_H_
+
+#ifdef main
+#undef main
+#endif
+#define main(...) wellsl4_app_main(__VA_ARGS__)
+
+#endif /* ARCH_POSIX_POSIX_CHEATS_H_ */
@@ -0,0 +1,38 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Host services of the POSIX arch
+ *
+ * Implemented in src/arch/posix/posix_host.c on top of the host C
+ * library, the only place the kernel build reaches the host from.
+ */
+
+#ifndef ARCH_POSIX_POSIX_HOST_H_
+#define ARCH_POSIX_POSIX_HOST_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void posix_print_error_and_exit(const char *format, ...);
+void posix_print_warning(const char *format, ...);
+void posix_print_trace(const char *format, ...);
+int posix_putchar(int c);
+void posix_exit(int exit_code);
+
+/* command line of the host process, as main() got it */
+int posix_argc(void);
+char **posix_argv(void);
+
+/* host monotonic clock in nanoseconds, to time code with, not the
+ * kernel clock */
+unsigned long long posix_host_time_ns(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARCH_POSIX_POSIX_HOST_H_ */
@@ -0,0 +1,48 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Per-arch thread definition
+ *
+ * Nothing is ever restored from here on the host, the layout only has
+ * to provide what the portable code reads and writes.
+ */
+
+#ifndef ARCH_POSIX_THREAD_H_
+#define ARCH_POSIX_THREAD_H_
+
+#ifndef _ASMLANGUAGE
+
+struct callee_save {
+	union {
+		struct {
+			u64_t r0;
+			u64_t r1;
+			u64_t r2;
+			u64_t r3;
+			u64_t r4;
+			u64_t r5;
+			u64_t r6;
+			u64_t r7;
+		};
+		u64_t mr[8];
+	};
+
+	/* named after the Cortex-M stack pointer, tcb.c writes it */
+	u64_t psp;
+	u64_t pc;
+};
+
+typedef struct callee_save callee_save_t;
+
+struct thread_arch {
+	u32_t swap_return_value;
+};
+
+typedef struct thread_arch thread_arch_t;
+
+#endif
+
+#endif
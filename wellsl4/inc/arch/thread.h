@@ -49,6 +49,15 @@ typedef void (*thread_entry_t)(void *p1, void *p2, void *p3);
  */
 static FORCE_INLINE u32_t arch_k_cycle_get_32(void);
 
+/**
+ * Obtain the _current_thread 64-bit monotonic cycle count
+ *
+ * @see get_cycle_64()
+ */
+#if defined(CONFIG_SYSTEM_CLOCK_CYCLES_64)
+static FORCE_INLINE u64_t arch_k_cycle_get_64(void);
+#endif
+
 
 /**
  * @brief Power save idle routine
@@ -494,6 +503,8 @@ FUNC_NORETURN void arch_user_mode_enter(thread_entry_t user_entry,
  */
 FUNC_NORETURN void arch_syscall_oops(void *ssf);
 
+#endif
+
 /**
  * @brief Safely take the length of a potentially bad string
  *
@@ -501,13 +512,15 @@ FUNC_NORETURN void arch_syscall_oops(void *ssf);
  * This function otherwise should work exactly like libc strnlen(). On success
  * *err should be set to 0.
  *
+ * user_string_nlen() is built without CONFIG_USERSPACE too, so this is
+ * declared for every configuration.
+ *
  * @param s String to measure
  * @param maxsize Max length of the string
  * @param err Error value to write
  * @return Length of the string, not counting NULL byte, up to maxsize
  */
 size_t arch_user_string_nlen(const char *s, size_t maxsize, s32_t *err);
-#endif
 
 
 /**
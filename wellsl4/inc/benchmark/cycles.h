@@ -0,0 +1,38 @@
+#ifndef BENCHMARK_CYCLES_H_
+#define BENCHMARK_CYCLES_H_
+
+#include <types_def.h>
+#include <kernel/time.h>
+#include <arch/ffs.h>
+
+#if defined(CONFIG_CPU_CORTEX_M_HAS_DWT)
+#include <arch/arm/aarch32/cortex_m/dwt.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The counter the statistics, the trace ring and the WCET records time
+ * with: CYCCNT where the core has a DWT, started once by
+ * CONFIG_BENCHMARK_CYCLES, the system clock otherwise. */
+static FORCE_INLINE u32_t benchmark_cycles(void)
+{
+#if defined(CONFIG_CPU_CORTEX_M_HAS_DWT)
+	return DWT->CYCCNT;
+#else
+	return (u32_t)get_cycle_32();
+#endif
+}
+
+/* log2 histogram bucket of a cycle count, 0 and 1 both go to bucket 0 */
+static FORCE_INLINE word_t benchmark_cycles_bucket(u32_t cycles)
+{
+	return cycles ? find_msb_set(cycles) - 1 : 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
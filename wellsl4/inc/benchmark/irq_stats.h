@@ -0,0 +1,65 @@
+#ifndef BENCHMARK_IRQ_STATS_H_
+#define BENCHMARK_IRQ_STATS_H_
+
+#include <types_def.h>
+#include <kernel_object.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* the three intervals recorded for every IRQ */
+enum irq_stats_interval {
+	irq_stats_entry_latency = 0,	/* assertion ~ ISR entry */
+	irq_stats_wakeup_latency,		/* ISR entry ~ handler thread running */
+	irq_stats_isr_duration,			/* ISR entry ~ ISR exit */
+	irq_stats_interval_number
+};
+
+#if defined(CONFIG_IRQ_LATENCY_STATS)
+#define IRQ_STATS_BUCKETS 	CONFIG_IRQ_LATENCY_STATS_BUCKETS
+
+/**
+ * @brief Distribution of one interval of one IRQ
+ *
+ * Bucket i counts the samples in [2^i, 2^(i+1)) cycles, bucket 0 also
+ * takes 0 and the last bucket takes everything above. Counts saturate.
+ */
+struct irq_stats_hist {
+	u32_t count;
+	u32_t min;
+	u32_t max;
+	u64_t sum;
+	u16_t bucket[IRQ_STATS_BUCKETS];
+};
+
+struct irq_stats {
+	struct irq_stats_hist interval[irq_stats_interval_number];
+};
+
+void irq_stats_isr_enter(int32_t num);
+void irq_stats_isr_exit(int32_t num);
+void irq_stats_asserted(int32_t num, u32_t assert_cycle);
+void irq_stats_thread_woken(int32_t num, struct ktcb *thread);
+void irq_stats_thread_switched_in(void);
+void irq_stats_dump(bool_t reset);
+#else
+#define irq_stats_isr_enter(num)
+#define irq_stats_isr_exit(num)
+#define irq_stats_asserted(num, assert_cycle)
+#define irq_stats_thread_woken(num, thread)
+#define irq_stats_dump(reset)
+#endif
+
+/*
+__syscall exception_t irq_stats_print(word_t reset)
+{
+	return EXCEPTION_NONE;
+}
+*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
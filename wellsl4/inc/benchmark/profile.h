@@ -0,0 +1,78 @@
+#ifndef BENCHMARK_PROFILE_H_
+#define BENCHMARK_PROFILE_H_
+
+#include <types_def.h>
+#include <kernel_object.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* "L4PF" when read as little endian bytes */
+#define PROFILE_BUFFER_MAGIC 	0x4650344c
+#define PROFILE_BUFFER_SAMPLES 	CONFIG_PROFILER_BUFFER_SAMPLES
+
+/* the sample was taken in a user thread */
+#define PROFILE_SAMPLE_USER 	BIT(0)
+/* the sample interrupted another exception handler */
+#define PROFILE_SAMPLE_ISR 		BIT(1)
+
+/**
+ * @brief One sample of the interrupted context
+ *
+ * lr is 0 where the sample source cannot see the interrupted link
+ * register.
+ */
+struct profile_sample {
+	uintptr_t pc;
+	uintptr_t lr;
+	u32_t thread_id;
+	u32_t flags;
+};
+
+/**
+ * @brief Per cpu ring of samples
+ *
+ * Written only by the sample interrupt of its cpu, which does not nest
+ * with itself, so there is no lock. Once full the oldest samples are
+ * overwritten. tool/scripts/profile_report.py parses this layout from a
+ * memory dump of profile_buffers.
+ */
+struct profile_buffer {
+	u32_t magic;
+	u32_t sample_size;
+	u32_t samples;
+	u32_t cpu;
+	u32_t frequency;
+	u32_t head;
+	u32_t reserved[2];
+	struct profile_sample sample[PROFILE_BUFFER_SAMPLES];
+};
+
+extern struct profile_buffer profile_buffers[CONFIG_MP_NUM_CPUS];
+
+/* called by the sample source from its interrupt */
+void profile_sample(uintptr_t pc, uintptr_t lr, u32_t flags);
+void profile_dump(bool_t reset);
+
+/* implemented by the sample source, see drivers/timer */
+void profile_timer_start(u32_t frequency);
+void profile_timer_stop(void);
+
+/*
+__syscall exception_t profile_control(word_t frequency)
+{
+	return EXCEPTION_NONE;
+}
+
+__syscall exception_t profile_print(word_t reset)
+{
+	return EXCEPTION_NONE;
+}
+*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef BENCHMARK_SCHED_STATS_H_
+#define BENCHMARK_SCHED_STATS_H_
+
+#include <types_def.h>
+#include <kernel_object.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* the intervals recorded by the scheduler */
+enum sched_stats_interval {
+	sched_stats_next_thread = 0,	/* next_thread() picking the thread to run */
+	sched_stats_refill_budget,		/* refill_budget_check() charging an exhausted budget */
+	sched_stats_swap,				/* arch_swap() ~ new thread switched in */
+	sched_stats_interval_number
+};
+
+/* one bucket per bit of the cycle count, nothing is clamped */
+#define SCHED_STATS_BUCKETS 	32
+
+/**
+ * @brief Distribution of one interval
+ *
+ * Bucket i counts the samples in [2^i, 2^(i+1)) cycles, bucket 0 also
+ * takes 0. This is what sched_stats_read copies out to the caller.
+ */
+struct sched_stats_hist {
+	u32_t count;
+	u32_t min;
+	u32_t max;
+	u64_t sum;
+	u32_t bucket[SCHED_STATS_BUCKETS];
+};
+
+#if defined(CONFIG_SCHED_LATENCY_STATS)
+u32_t sched_stats_cycle(void);
+void sched_stats_record(enum sched_stats_interval interval, u32_t start);
+void sched_stats_swap_start(void);
+void sched_stats_swap_end(void);
+#else
+#define sched_stats_cycle() 	(0U)
+#define sched_stats_record(interval, start) 	((void)(start))
+#define sched_stats_swap_start()
+#define sched_stats_swap_end()
+#endif
+
+/*
+__syscall exception_t sched_stats_read(word_t interval,
+	struct sched_stats_hist *hist, word_t reset)
+{
+	return EXCEPTION_NONE;
+}
+
+__syscall exception_t sched_stats_null(void)
+{
+	return EXCEPTION_NONE;
+}
+*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef BENCHMARK_STACK_USAGE_H_
+#define BENCHMARK_STACK_USAGE_H_
+
+#include <types_def.h>
+#include <kernel_object.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief High-water mark of one stack
+ *
+ * The stacks are filled with 0xaa when they are created
+ * (CONFIG_INIT_STACKS); the bytes at the low end that still hold it were
+ * never written. unused only shrinks as the scans find more of the stack
+ * written. recommend is the high-water mark plus
+ * CONFIG_STACK_USAGE_MARGIN percent, rounded up to STACK_USAGE_ALIGN.
+ * This is what stack_usage_read copies out to the caller.
+ */
+struct stack_usage {
+	uintptr_t start;
+	u32_t size;
+	u32_t unused;
+	u32_t recommend;
+};
+
+#define STACK_USAGE_ALIGN 	8
+
+#if defined(CONFIG_STACK_USAGE)
+void stack_usage_idle(void);
+void stack_usage_thread_exit(struct ktcb *thread);
+void stack_usage_dump(bool_t rescan);
+#else
+#define stack_usage_idle()
+#define stack_usage_thread_exit(thread)
+#define stack_usage_dump(rescan)
+#endif
+
+/*
+__syscall exception_t stack_usage_read(word_t dest_thread_id,
+	struct stack_usage *usage)
+{
+	return EXCEPTION_NONE;
+}
+
+__syscall exception_t stack_usage_print(word_t rescan)
+{
+	return EXCEPTION_NONE;
+}
+*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
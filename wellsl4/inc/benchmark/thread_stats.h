@@ -0,0 +1,53 @@
+#ifndef BENCHMARK_THREAD_STATS_H_
+#define BENCHMARK_THREAD_STATS_H_
+
+#include <types_def.h>
+#include <kernel_object.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_THREAD_RUNTIME_STATS)
+void thread_stats_init(struct ktcb *thread);
+void thread_stats_switched_in(struct ktcb *thread);
+void thread_stats_wait(struct ktcb *thread, word_t state);
+void thread_stats_dump(bool_t reset);
+
+static FORCE_INLINE void thread_stats_budget_overrun(struct ktcb *thread)
+{
+	thread->cold.runtime_stats.budget_overruns++;
+}
+
+/* at the sites where a thread gives up the cpu itself */
+static FORCE_INLINE void thread_stats_voluntary(struct ktcb *thread)
+{
+	thread->cold.switch_voluntary = TRUE;
+}
+#else
+#define thread_stats_init(thread)
+#define thread_stats_switched_in(thread)
+#define thread_stats_wait(thread, state)
+#define thread_stats_dump(reset)
+#define thread_stats_budget_overrun(thread)
+#define thread_stats_voluntary(thread)
+#endif
+
+/*
+__syscall exception_t thread_stats_read(word_t dest_thread_id,
+	struct thread_stats *stats, word_t reset)
+{
+	return EXCEPTION_NONE;
+}
+
+__syscall exception_t thread_stats_print(word_t reset)
+{
+	return EXCEPTION_NONE;
+}
+*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
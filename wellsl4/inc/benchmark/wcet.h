@@ -0,0 +1,83 @@
+#ifndef BENCHMARK_WCET_H_
+#define BENCHMARK_WCET_H_
+
+#include <types_def.h>
+#include <kernel_object.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* the ways into the kernel that are timed */
+enum wcet_path {
+	wcet_path_syscall = 0,		/* indexed by K_SYSCALL_* */
+	wcet_path_exception,		/* indexed by the exception number */
+	wcet_path_irq,				/* indexed by the IRQ number */
+	wcet_path_number
+};
+
+/* the exception numbers of the core, the IRQs follow them */
+#define WCET_EXCEPTIONS 	16
+
+/* registers kept of the worst sample, a syscall passes at most six */
+#define WCET_ARGS 			6
+
+/**
+ * @brief Worst case of one kernel entry
+ *
+ * Cycles from the entry to the exit of the kernel code of one path, and
+ * what the worst sample was entered with:
+ * - syscall: the six argument registers as the handler got them
+ * - exception: the faulting pc and lr
+ * - irq: whether the ISR asked for a reschedule, and the current thread
+ *   when it left
+ * This is what wcet_read copies out to the caller.
+ */
+struct wcet_record {
+	u32_t count;
+	u32_t max;
+	u64_t sum;
+	uintptr_t args[WCET_ARGS];
+};
+
+#if defined(CONFIG_WCET_STATS)
+void wcet_syscall_enter(word_t id, uintptr_t arg0, uintptr_t arg1,
+	uintptr_t arg2, uintptr_t arg3, uintptr_t arg4, uintptr_t arg5);
+void wcet_syscall_exit(word_t id);
+void wcet_syscall_defer(void);
+void wcet_syscall_deferred_exit(word_t id);
+void wcet_exception_enter(word_t num);
+void wcet_exception_exit(word_t num, uintptr_t pc, uintptr_t lr);
+void wcet_irq_enter(word_t num);
+void wcet_irq_exit(word_t num, bool_t is_resched);
+void wcet_dump(bool_t reset);
+#else
+#define wcet_syscall_enter(id, arg0, arg1, arg2, arg3, arg4, arg5)
+#define wcet_syscall_exit(id)
+#define wcet_syscall_defer()
+#define wcet_syscall_deferred_exit(id)
+#define wcet_exception_enter(num)
+#define wcet_exception_exit(num, pc, lr)
+#define wcet_irq_enter(num)
+#define wcet_irq_exit(num, is_resched)
+#define wcet_dump(reset)
+#endif
+
+/*
+__syscall exception_t wcet_read(word_t path, word_t num,
+	struct wcet_record *record, word_t reset)
+{
+	return EXCEPTION_NONE;
+}
+
+__syscall exception_t wcet_print(word_t reset)
+{
+	return EXCEPTION_NONE;
+}
+*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
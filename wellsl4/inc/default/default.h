@@ -3,7 +3,7 @@
 
 #define KIP_EXTRA_SIZE 128u
 #define KERNEL_WCET_SCALE   1u
-#define NUM_PRIORITIES   256u
+#define NUM_PRIORITIES   CONFIG_NUM_PRIORITIES
 /* roundrobin thread */
 #define MIN_REFILLS   2u 
 /* A word size is 32 ~ 2^5*/
@@ -11,9 +11,19 @@
 /* WORD_BITS = 32 */
 #define WORD_BITS (1u << WORD_SIZE)
 #define NUM_READY_QUEUES (CONFIG_NUM_DOMAINS * NUM_PRIORITIES)
-/*each domain sched_prior number ~ 256*/
+/* one level: a bit per sched_prior in the L1 word of the domain,
+ * two levels: a bit per L2 word in the L1 word, a bit per sched_prior
+ * in the L2 words */
+#define SCHED_BITMAP_LEVELS CONFIG_SCHED_BITMAP_LEVELS
+#if SCHED_BITMAP_LEVELS == 1 && NUM_PRIORITIES > WORD_BITS
+#error "a one level ready queue bitmap holds WORD_BITS priorities at most"
+#endif
 #define L2_BITMAP_BITS ((NUM_PRIORITIES + WORD_BITS - 1) / WORD_BITS)
 #define L1_BITMAP_BITS ((NUM_PRIORITIES + WORD_BITS - 1) / WORD_BITS)
+/* main starts at 31, or in the middle when there are not that many */
+#define MAIN_THREAD_PRIO ((NUM_PRIORITIES > 32u) ? 31u : (NUM_PRIORITIES / 2u - 1u))
+/* threads created by thread_control, see record_threads */
+#define THREAD_TABLE_SIZE CONFIG_THREAD_TABLE_SIZE
 #define MAX_NUM_WORUNITS_PER_PREEMPTION 20u
 #define SYSTIMER_MIN_TICKS 10u
 #define NUM_SCHED_REFILLS 8
@@ -0,0 +1,28 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DRIVERS_TIMER_ARM_ARCH_TIMER_H_
+#define DRIVERS_TIMER_ARM_ARCH_TIMER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Architected timer PPIs as GIC INTIDs, i.e. the PPI numbers of the
+ * devicetree binding plus the PPI base of 16.
+ */
+#define ARM_TIMER_SECURE_IRQ		29
+#define ARM_TIMER_NON_SECURE_IRQ	30
+#define ARM_TIMER_VIRTUAL_IRQ		27
+#define ARM_TIMER_HYP_IRQ		26
+
+#define ARM_TIMER_PRIO			0xa0
+/* Level sensitive, active high */
+#define ARM_TIMER_FLAGS			0x4
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRIVERS_TIMER_ARM_ARCH_TIMER_H_ */
@@ -0,0 +1,35 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef DRIVERS_TIMER_NATIVE_POSIX_TIMER_H_
+#define DRIVERS_TIMER_NATIVE_POSIX_TIMER_H_
+
+#include <types_def.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* posix_irq_raise() line of the simulated timer */
+#define NATIVE_POSIX_TIMER_IRQ		0
+
+/**
+ * @brief Let simulated time pass
+ *
+ * The counter of the native_posix timer only moves when told to, so a
+ * test sees the same ticks on every run. Every timeout programmed
+ * within the advanced span fires on its own cycle, in order.
+ *
+ * @param cycles hardware cycles to advance by
+ */
+void native_posix_timer_advance(u64_t cycles);
+
+/* cycles until the programmed timeout, 0 when none is programmed */
+u64_t native_posix_timer_pending(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DRIVERS_TIMER_NATIVE_POSIX_TIMER_H_ */
@@ -118,6 +118,17 @@ extern void update_timelist(s32_t ticks);
  */
 u32_t clock_elapsed(void);
 
+#if defined(CONFIG_SYSTEM_CLOCK_CYCLES_64)
+u64_t clock_cycle_get_64(void);
+#endif
+
+#if defined(CONFIG_SYSTEM_CLOCK_SUBTICK_DEADLINE)
+/* Arm a one-shot interrupt at an absolute cycle, 0 disarms */
+void clock_set_deadline_cycles(u64_t cycle);
+
+extern void update_cycle_timelist(u64_t now);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,10 +22,9 @@ enum obj_status
 	obj_allocated_obj = BIT(1), /* object other */
 	obj_granted_obj = BIT(2), /* access granted object for one thread */
 	obj_subsystem_obj = BIT(3),
+	obj_carved_obj = BIT(4), /* object carved from untyped memory, not from the heap */
 };
 
-typedef void (*wordlist_cb_func_t)(struct k_object *ko, void *ctx);
-
 word_t get_k_object_type(struct k_object *k_obj);
 bool_t is_arch_k_obj(struct k_object *k);
 bool_t is_empty_d_object(struct d_object *d);
@@ -43,7 +42,6 @@ void d_object_swap_of(struct d_object *d1, struct d_object *d2);
 exception_t d_object_revoke(struct d_object *d);
 exception_t d_object_delete(struct d_object *d);
 exception_t prepare_d_object_delete(struct d_object *d);
-void k_object_wordlist_foreach(wordlist_cb_func_t func, void *ctx_ptr);
 
 static FORCE_INLINE struct k_object obj_null_obj_new(void)
 {
@@ -37,6 +37,8 @@ extern "C" {
 #define SCHEDULER_BUDGET_MASK    		0xFFF00000
 #define SCHEDULER_PERIOD_MASK 			0x000FFF00
 #define SCHEDULER_MAX_REFILLS_MASK 		0x000000FF
+#define SCHEDULER_PROCESSOR_MASK		0x0000FFFF
+#define SCHEDULER_SLACK_MASK			0xFFFF0000
 
 #define HARD_PRIOR_ACTION 0xFF
 #define SOFT_PRIOR_ACTION 0x00
@@ -109,7 +111,7 @@ static FORCE_INLINE bool_t check_prio(prio_t prio, struct ktcb *thread)
     mcp = thread->base.mcp;
 
     /* system invariant: existing MCPs are bounded */
-    assert(mcp <= NUM_PRIORITIES);
+    assert(mcp < NUM_PRIORITIES);
 
     /* can't assign a sched_prior greater than our own mcp */
     if (prio > mcp) 
@@ -131,6 +133,17 @@ static FORCE_INLINE bool_t __PURE is_blocked(const struct ktcb *thread)
     }
 }
 
+#if SCHED_BITMAP_LEVELS == 1
+static inline void add_to_bitmap(word_t dom, word_t prio)
+{
+	ready_queues_l1_bitmap[dom] |= BIT(prio);
+}
+
+static inline void remove_from_bitmap(word_t dom, word_t prio)
+{
+	ready_queues_l1_bitmap[dom] &= ~ BIT(prio);
+}
+#else
 static inline void add_to_bitmap(word_t dom, word_t prio)
 {
 	word_t l1index;
@@ -160,6 +173,7 @@ static inline void remove_from_bitmap(word_t dom, word_t prio)
 		ready_queues_l1_bitmap[dom] &= ~ BIT(l1index);
 	}
 }
+#endif
 
 /* Add sched to the head of a scheduler queue */
 static inline void sched_enqueue(struct ktcb *thread)
@@ -398,11 +412,17 @@ static FORCE_INLINE struct tcb_queue message_dequeue(struct ktcb *thread, struct
 
 static FORCE_INLINE bool_t smp_idle_domain(void)
 {
-	prio_t prio = _idle_thread->base.sched_prior;
 	dom_t  dom = _idle_thread->base.domain;
+
+#if SCHED_BITMAP_LEVELS == 1
+	/* one word holds every sched_prior, the idle thread's as well */
+	return (ready_queues_l1_bitmap[dom] != 0) ? true : false;
+#else
+	prio_t prio = _idle_thread->base.sched_prior;
 	word_t l1index = prio_to_l1index(prio);
 
 	return (ready_queues_l1_bitmap[dom]    & BIT(l1index)) ? true : false;
+#endif
 }
 
 static FORCE_INLINE bool is_idle_thread_set(void *entry_point)
@@ -432,7 +452,7 @@ static FORCE_INLINE bool is_thread_pending(struct ktcb *thread)
 
 static FORCE_INLINE bool is_thread_not_running(struct ktcb *thread)
 {
-	byte_t state = thread->base.thread_state.obj_state;
+	word_t state = thread->base.thread_state.obj_state;
 
 	return (state & (state_send_blocked_state | state_recv_blocked_state | 
 			 state_notify_blocked_state |
@@ -558,6 +578,7 @@ static FORCE_INLINE bool is_prio_lower_or_equal(sword_t prio1, sword_t prio2)
 	return is_prio1_lower_than_or_equal_to_prio2(prio1, prio2);
 }
 
+void add_to_ready_q(struct ktcb *thread);
 
 static FORCE_INLINE void set_ready_thread(struct ktcb *thread)
 {
@@ -596,7 +617,6 @@ sword_t disable_thread_smp_cpu_mask(struct ktcb *thread, sword_t cpu);
 
 void set_prior(struct ktcb *thread, prio_t prio, prio_t mcp);
 void schedule(void);
-void add_to_ready_q(struct ktcb *thread);
 void add_to_end_ready_q(struct ktcb *thread);
 void move_to_end_ready_q(struct ktcb *thread);
 void remove_from_ready_q(struct ktcb *thread);
@@ -615,6 +635,7 @@ void commit_time(void);
 bool_t check_budget_restart(void);
 void reschedule_required(void);
 void possible_switchto(struct ktcb *thread);
+void direct_switchto(struct ktcb *thread);
 void awaken(void);
 sword_t postpone_cur_irqlock(word_t key);
 sword_t postpone_cur(spinlock_t *thread_swap_lock, spinlock_key_t key);
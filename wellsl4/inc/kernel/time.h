@@ -26,16 +26,33 @@ void set_next_timelist(sword_t ticks, bool_t idle);
 sword_t add_up_timelist(struct timer_event *timeout);
 void update_timelist(sword_t ticks);
 
-uint64_t get_current_tick(void);
+u64_t get_current_tick(void);
 u32_t get_current_tick_32(void);
 #ifndef CONFIG_SYS_CLOCK_EXISTS
 #define get_current_tick() (0)
 #define get_current_tick_32() (0)
 #endif
 void set_deadline(ticks_t deadline, word_t *deadline_gid);
+void set_deadline_slack(ticks_t deadline, word_t *deadline_gid, word_t slack);
+#if defined(CONFIG_SYSTEM_CLOCK_SUBTICK_DEADLINE)
+void add_to_cycle_timelist(struct cycle_event *ce, timer_handler_t handler, generptr_t data,
+	u64_t deadline);
+void remove_from_cycle_timelist(struct cycle_event *ce);
+void update_cycle_timelist(u64_t now);
+#endif
 u64_t get_uptime_64(void);
+#if defined(CONFIG_TIMER_SLACK)
+word_t get_timer_irqs_saved(void);
+#endif
+#if defined(CONFIG_USER_KIP_PAGE)
+void refresh_kip_clock(void);
+#endif
 void init_time_object(void);
 
+/* system_clock() stores the 64-bit cycle count when
+ * CONFIG_SYSTEM_CLOCK_CYCLES_64 is enabled, the tick count
+ * scaled to cycles otherwise.
+ */
 /*
 __syscall exception_t system_clock(dword_t *clock)
 {
@@ -44,9 +61,25 @@ __syscall exception_t system_clock(dword_t *clock)
 }
 */
 
+#if defined(CONFIG_TIMER_SLACK)
+/* timer_slack_print() prints how many timer interrupts the slack
+ * windows avoided, and starts the count again if reset is set.
+ */
+/*
+__syscall exception_t timer_slack_print(word_t reset)
+{
+	return EXCEPTION_NONE;
+
+}
+*/
+#endif
+
 static FORCE_INLINE void initialize_timelist(struct timer_event *to)
 {
 	sys_dnode_init(&to->index);
+#if defined(CONFIG_TIMER_SLACK)
+	to->slack = 0;
+#endif
 }
 
 static FORCE_INLINE bool is_inactive_timelist(struct timer_event *to)
@@ -206,6 +239,20 @@ static FORCE_INLINE word_t get_cycle_32(void)
 	return arch_k_cycle_get_32();
 }
 
+#if defined(CONFIG_SYSTEM_CLOCK_CYCLES_64)
+/**
+ * @brief Read the 64-bit monotonic hardware clock.
+ *
+ * Unlike get_cycle_32() this never wraps in practice.
+ *
+ * @return Cycles since boot.
+ */
+static FORCE_INLINE u64_t get_cycle_64(void)
+{
+	return arch_k_cycle_get_64();
+}
+#endif
+
 /**
  * @brief Generate null timeout delay.
  *
@@ -277,10 +324,11 @@ static FORCE_INLINE word_t get_cycle_32(void)
 /* Exhaustively enumerated, highly optimized time unit conversion API */
 
 #if defined(CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME)
+/* set by the timer driver from the hardware in clock_init() */
+extern sword_t clock_hw_cycles_per_sec;
+
 static FORCE_INLINE sword_t clock_hw_cycles_per_sec_runtime_get(void)
 {
-	extern sword_t clock_hw_cycles_per_sec;
-
 	return clock_hw_cycles_per_sec;
 }
 #endif
@@ -15,6 +15,8 @@
 struct ktcb;
 struct message;
 struct notifation;
+struct channel;
+struct channel_ring;
 struct partition;
 struct thread_page;
 struct k_object;
@@ -286,6 +288,12 @@ struct thread_stack_info {
 	 * that should be writable by the thread
 	 */
 	size_t size;
+
+#if defined(CONFIG_STACK_USAGE)
+	/* bytes at the start that were never written, as far as the idle
+	 * scan has looked, see benchmark/stack_usage.h */
+	size_t unused;
+#endif
 };
 
 typedef struct thread_stack_info thread_stack_info_t;
@@ -308,52 +316,39 @@ typedef struct thread_page_table thread_page_table_t;
 
 typedef void (*thread_abort_func_t)(void);
 
+/**
+ * @brief Cumulative accounting of one thread, in hardware cycles
+ *
+ * A wait runs from the thread blocking in IPC to it being switched in
+ * again, so it includes the time it then sat ready.
+ * Switching out is voluntary where the thread gives up the cpu itself,
+ * by waiting in IPC or yielding; any other switch (preempted, out of
+ * budget, suspended or aborted) is involuntary.
+ */
+struct thread_stats {
+	u64_t run_cycles;
+	u64_t send_wait_cycles;
+	u64_t recv_wait_cycles;
+	u32_t switches_in;
+	u32_t voluntary_switches;
+	u32_t involuntary_switches;
+	u32_t budget_overruns;
+};
+
 /* TBD */
 struct utcb {
-	word_t mr[8];   /* 8-15 */
+	word_t mr[8];   /* 3-10, 0-2 are in registers */
 	word_t br[8];   /* 0-7 */
 };
 
-struct ktcb {
-	/** thread base */
-	struct thread_base base;
-	
-	/** defined by the architecture, but all archs need these */
-	struct callee_save callee_saved;
-
-	/** defined thread id */
-	word_t thread_id;
-
-	/** user-level tcb */
-	struct utcb *user;
-
+/* Fields only touched on creation, deletion, faults, page mapping or
+ * debug paths. Kept behind the hot part so IPC and scheduling stay in the
+ * first cache lines of the tcb.
+ */
+struct ktcb_cold {
 	/** abort function */
 	thread_abort_func_t abort_handle;
 
-	/* notifation */
-	struct notifation *notifation_node;
-
-	/* message */
-	struct message *message_node;
-	
-	/* scheduling context that this tcb is running on, if it is NULL the tcb cannot be in the scheduler queues, 1 word */
-	struct thread_sched   *sched;
-
-	/* scheduling context that this tcb yielded to , 1words */
-	struct ktcb *yield;		
-
-	/* Previous and next pointers for scheduler queues , 1 words */
-	struct ktcb *ready_q_next;	
-	
-	/* Previous and next pointers for scheduler queues , 1 words */
-    struct ktcb *ready_q_prev; 	
-
-	/* message node next , 1words */
-	struct ktcb  *mesg_q_next;
-
-	/* message node prev , 1words */
-	struct ktcb  *mesg_q_prev;
-	
 #ifdef CONFIG_USERSPACE
 	/** Base address of thread stack */
 	struct thread_stack *userspace_stack_point;
@@ -377,6 +372,87 @@ struct ktcb {
 	struct thread_stack_info stack_info;
 #endif
 
+#ifdef CONFIG_THREAD_MONITOR
+	/** thread entry and parameters description */
+	monitor_function_t monitor_thread_function;
+
+	/** next item in list of all threads */
+	struct ktcb *monitor_thread_next;
+#endif
+
+#ifdef CONFIG_IRQ_LATENCY_STATS
+	/** IRQ number + 1 whose ISR woke this thread, 0 for none */
+	int32_t irq_wake_num;
+
+	/** entry cycle of that ISR */
+	u32_t irq_wake_cycle;
+#endif
+
+#ifdef CONFIG_TIMER_SLACK
+	/** ticks the thread's timeouts may be delayed to share an interrupt */
+	word_t timer_slack;
+#endif
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	/** runtime, wait and switch counters */
+	struct thread_stats runtime_stats;
+
+	/** cycle the current send or receive wait started at */
+	u64_t wait_start_cycle;
+
+	/** thread_state bits of that wait, 0 when not waiting */
+	word_t wait_state;
+
+	/** set at a wait or yield, the next switch out is voluntary */
+	bool_t switch_voluntary;
+#endif
+};
+
+typedef struct ktcb_cold ktcb_cold_t;
+
+/* Hot fields first, in the order the scheduler and the IPC path use them,
+ * so one IPC touches as few cache lines of the tcb as possible.
+ */
+struct ktcb {
+	/** thread base */
+	struct thread_base base;
+	
+	/** defined by the architecture, but all archs need these */
+	struct callee_save callee_saved;
+
+	/* scheduling context that this tcb is running on, if it is NULL the tcb cannot be in the scheduler queues, 1 word */
+	struct thread_sched   *sched;
+
+	/* Previous and next pointers for scheduler queues , 1 words */
+	struct ktcb *ready_q_next;	
+	
+	/* Previous and next pointers for scheduler queues , 1 words */
+	struct ktcb *ready_q_prev; 	
+
+	/* message */
+	struct message *message_node;
+
+	/* message node next , 1words */
+	struct ktcb  *mesg_q_next;
+
+	/* message node prev , 1words */
+	struct ktcb  *mesg_q_prev;
+
+	/* notifation */
+	struct notifation *notifation_node;
+
+	/* IRQs bound to this thread, acked on interrupt_respond */
+	struct interrupt *irq_owned;
+
+	/** user-level tcb */
+	struct utcb *user;
+
+	/** defined thread id */
+	word_t thread_id;
+
+	/* scheduling context that this tcb yielded to , 1words */
+	struct ktcb *yield;		
+
 #ifdef CONFIG_USE_SWITCH
 	/* When using __switch() a few previously arch-specific items
 	 * become part of the core OS */
@@ -387,16 +463,11 @@ struct ktcb {
 	void *swap_handler;
 #endif
 
-#ifdef CONFIG_THREAD_MONITOR
-	/** thread entry and parameters description */
-	monitor_function_t monitor_thread_function;
-
-	/** next item in list of all threads */
-	struct ktcb *monitor_thread_next;
-#endif
-
-	/** arch-specifics: must always be at the end */
+	/** arch-specifics: read and written by every context switch */
 	struct thread_arch arch;
+
+	/** cold part, see struct ktcb_cold */
+	struct ktcb_cold cold;
 };
 
 typedef struct ktcb ktcb_t;
@@ -433,8 +504,10 @@ enum thread_status {
 /* INTERRUPT DES_DEFINE */
 struct interrupt {
 	struct ktcb  *thread;
+	struct interrupt *owned_next;
 	int32_t  number;
 	uint16_t action;
+	uint16_t state;
 	/* uint16_t prior;   */
 	/* word_t   handler; */
 };
@@ -468,12 +541,25 @@ typedef struct message message_t;
 
 struct notifation {
 	notifation_state_t state; 			/* node state */
+	word_t         badge;			/* pending badge bits, ORed by every signal */
 	struct tcb_queue        queue;   		/* notice wait queue */
 	struct ktcb   *bindedtcb; 		/* record self schedcontext */
 };
 
 typedef struct notifation notifation_t;
 
+/* shared memory channel, the region is mapped into producer and consumer, 
+   the descriptor ring lives at the start of the region */
+struct channel {
+	struct ktcb   *producer;		/* the only thread can ring the doorbell */
+	struct ktcb   *consumer;		/* the thread bound to the doorbell notifation */
+	struct channel_ring *ring;		/* region base ~ ring header */
+	word_t         size;			/* region size */
+	word_t         doorbell_count;	/* number of rang doorbells */
+};
+
+typedef struct channel channel_t;
+
 enum obj_tag
 {
 	obj_any_obj = 0,
@@ -491,6 +577,7 @@ enum obj_tag
     obj_time_obj = 24,
     obj_device_obj = 26,
     obj_pager_obj = 28,
+    obj_channel_obj = 30,
     //obj_small_frame_obj = 1,
     obj_frame_obj = 3,
     //obj_asid_pool_obj = 5,
@@ -530,10 +617,21 @@ struct timer_event {
 	generptr_t 		data;   /*handler function para ~ tcb*/
 	timer_handler_t handler;/*handler function*/
 	timer_node_t    index;  /*timer queue index*/
+#if defined(CONFIG_TIMER_SLACK)
+	word_t          slack;  /*ticks the event may fire late*/
+#endif
 };
 
 typedef struct timer_event timer_event_t;
 
+/* Sub-tick timer event at an absolute cycle, storage owned by the caller */
+struct cycle_event {
+	u64_t			deadline; /*absolute cycle*/
+	generptr_t 		data;
+	timer_handler_t handler;  /*return value: period in cycles, 0 for once*/
+	timer_node_t    index;
+};
+
 typedef void (*ktcb_entry_t)(void *p1, void *p2, void *p3);
 
 struct pager_context {
@@ -554,6 +652,7 @@ enum ks_object_type {
 };
 
 typedef struct fastipc_path {
+	struct ktcb *caller;	/* do_exchange_ipc runs on the privilege thread */
 	word_t receive;
 	word_t send;
 	word_t timeout;
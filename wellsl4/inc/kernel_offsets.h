@@ -57,7 +57,11 @@
 	(__ktcb_t_arch_OFFSET + __thread_arch_t_esf_OFFSET)
 
 #define _thread_offset_to_stack_start \
-	(__ktcb_t_stack_info_OFFSET + __thread_stack_info_t_start_OFFSET)
+	(__ktcb_t_cold_OFFSET + __ktcb_cold_t_stack_info_OFFSET + \
+	 __thread_stack_info_t_start_OFFSET)
+
+#define _thread_offset_to_stack_info_start \
+	_thread_offset_to_stack_start
 /* end - threads */
 
 #endif
\ No newline at end of file
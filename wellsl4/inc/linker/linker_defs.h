@@ -253,6 +253,16 @@ extern char _nocache_ram_end[];
 extern char _nocache_ram_size[];
 #endif /* CONFIG_NOCACHE_MEMORY */
 
+/*
+ * Kernel interface page and clock snapshot, mapped read-only into every
+ * user thread. Everything tagged '__user_kip' is placed here.
+ */
+#ifdef CONFIG_USER_KIP_PAGE
+extern char _user_kip_ram_start[];
+extern char _user_kip_ram_end[];
+extern char _user_kip_ram_size[];
+#endif /* CONFIG_USER_KIP_PAGE */
+
 /* Memory owned by the kernel. Start and end will be aligned for memory
  * management/protection hardware for the target architecture.
  *
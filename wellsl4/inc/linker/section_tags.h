@@ -34,10 +34,34 @@
 #define __imx_boot_dcd_section	GENERIC_SECTION(IMX_BOOT_DCD)
 #endif /* CONFIG_ARM */
 
+#if defined(CONFIG_KERNEL_HOT_TEXT_RAMFUNC)
+#define __kernel_hot_text __ramfunc
+#else
+#define __kernel_hot_text
+#endif /* CONFIG_KERNEL_HOT_TEXT_RAMFUNC */
+
+#if defined(CONFIG_KERNEL_HOT_DATA_CCM)
+#define __kernel_hot_bss __ccm_bss_section
+#elif defined(CONFIG_KERNEL_HOT_DATA_DTCM)
+#define __kernel_hot_bss __dtcm_bss_section
+#else
+#define __kernel_hot_bss
+#endif /* CONFIG_KERNEL_HOT_DATA_CCM */
+
+#if defined(CONFIG_KERNEL_HOT_DATA_HEAP)
+#define __kernel_hot_heap __kernel_hot_bss
+#else
+#define __kernel_hot_heap
+#endif /* CONFIG_KERNEL_HOT_DATA_HEAP */
+
 #if defined(CONFIG_NOCACHE_MEMORY)
 #define __nocache __in_section_unique(_NOCACHE_SECTION_NAME)
 #endif /* CONFIG_NOCACHE_MEMORY */
 
+#if defined(CONFIG_USER_KIP_PAGE)
+#define __user_kip __in_section_unique(_USER_KIP_SECTION_NAME)
+#endif /* CONFIG_USER_KIP_PAGE */
+
 #endif /* !_ASMLANGUAGE */
 
 #endif /* LINKER_SECTION_TAGS_H_ */
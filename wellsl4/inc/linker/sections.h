@@ -38,6 +38,13 @@
 #define TEXT_START text /* beginning of TEXT section */
 #endif
 
+/* Exception entries of the syscall/IPC path, see KERNEL_HOT_PLACEMENT */
+#if defined(CONFIG_KERNEL_HOT_TEXT_RAMFUNC)
+#define HOT_TEXT ramfunc
+#else
+#define HOT_TEXT TEXT
+#endif
+
 /* Various data type section names */
 #define BSS bss
 #define RODATA rodata
@@ -71,6 +78,10 @@
 #define _NOCACHE_SECTION_NAME nocache
 #endif
 
+#ifdef CONFIG_USER_KIP_PAGE
+#define _USER_KIP_SECTION_NAME user_kip
+#endif
+
 #include <linker/section_tags.h>
 
 #endif /* LINKER_SECTIONS_H_ */
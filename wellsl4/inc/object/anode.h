@@ -3,7 +3,9 @@
 
 
 #include <types_def.h>
+#if defined(CONFIG_CPU_CORTEX_M)
 #include <arch/arm/aarch32/cortex_m/mpu/arm_mpu_anode.h>
+#endif
 #include <sys/dlist.h>
 #include <kernel_object.h>
 #include <api/errno.h>
@@ -127,6 +129,11 @@ void add_to_page_table(struct thread_page *domain, struct ktcb *thread);
  */
 void remove_from_page_table(struct ktcb *thread);
 
+/* the right of a map or grant item, 0rwx as in the message item */
+#define PAGE_RIGHT_NA 		0x0
+#define PAGE_RIGHT_RO 		0x4
+#define PAGE_RIGHT_RW 		0x6
+#define PAGE_RIGHT_RWX 		0x7
 
 exception_t do_guard_page(struct ktcb *s_thread, 
 	struct ktcb *d_thread, 
@@ -143,6 +150,8 @@ exception_t do_map_string(struct ktcb *thread,
 	word_t len,
 	word_t ptr);
 
+exception_t do_unmap_page(struct ktcb *thread);
+
 /*
 __syscall exception_t unmap_page(word_t control)
 {
@@ -0,0 +1,134 @@
+#ifndef BATCH_H_
+#define BATCH_H_
+
+#include <types_def.h>
+#include <kernel_object.h>
+#include <sys/errno.h>
+#include <api/errno.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* entries of both queues, a power of two so the indexes are masked */
+#define BATCH_RING_ENTRIES 		CONFIG_SYSCALL_BATCH_ENTRIES
+#define BATCH_RING_MASK 		(BATCH_RING_ENTRIES - 1)
+
+enum batch_op {
+	batch_nop_op = 0,
+	batch_dobject_alloc_op,			/* arg[0] type, arg[1] untyped size */
+	batch_dobject_free_op,			/* arg[0] object */
+	batch_retype_untyped_op,		/* arg[0] untyped, arg[1] type, arg[2] size */
+	batch_unmap_page_op,			/* arg[0] control */
+	batch_kobject_access_grant_op,	/* arg[0] object, arg[1] thread */
+	batch_last_op
+};
+
+/* submission entry, written by the caller */
+struct batch_sqe {
+	word_t op;
+	word_t user_data;
+	word_t arg[3];
+};
+
+/* completion entry, written by the kernel, user_data is copied back */
+struct batch_cqe {
+	word_t user_data;
+	word_t result;					/* object created by alloc and retype */
+	word_t status;					/* exception_t of the operation */
+	word_t error;					/* syscall error code when status is an error */
+};
+
+/**
+ * @brief Batched syscall ring
+ *
+ * The caller owns the region and passes it to batch_submit(). The
+ * indexes are free running and masked on access. The caller writes
+ * sq_tail and cq_head, the kernel writes sq_head and cq_tail, so the
+ * two sides never write the same word.
+ *
+ * One batch_submit() call consumes submissions in order until the
+ * submission queue is empty or the completion queue is full. There is a
+ * preemption point after every entry; a preempted call restarts from
+ * sq_head, the entry in progress is completed exactly once.
+ */
+struct batch_ring {
+	word_t sq_head;
+	word_t sq_tail;
+	word_t cq_head;
+	word_t cq_tail;
+	struct batch_sqe sqes[BATCH_RING_ENTRIES];
+	struct batch_cqe cqes[BATCH_RING_ENTRIES];
+};
+
+static FORCE_INLINE void batch_ring_init(struct batch_ring *ring)
+{
+	ring->sq_head = 0;
+	ring->sq_tail = 0;
+	ring->cq_head = 0;
+	ring->cq_tail = 0;
+}
+
+/**
+ * @brief Queue one submission
+ *
+ * @return 0 on success, -EAGAIN if the submission queue is full
+ */
+static FORCE_INLINE sword_t batch_ring_push(struct batch_ring *ring, word_t op,
+	word_t user_data, word_t arg0, word_t arg1, word_t arg2)
+{
+	word_t tail = ring->sq_tail;
+	struct batch_sqe *sqe;
+
+	if (tail - *(volatile word_t *)&ring->sq_head >= BATCH_RING_ENTRIES)
+	{
+		return -EAGAIN;
+	}
+
+	sqe = &ring->sqes[tail & BATCH_RING_MASK];
+	sqe->op = op;
+	sqe->user_data = user_data;
+	sqe->arg[0] = arg0;
+	sqe->arg[1] = arg1;
+	sqe->arg[2] = arg2;
+
+	compiler_barrier();
+	*(volatile word_t *)&ring->sq_tail = tail + 1;
+
+	return 0;
+}
+
+/**
+ * @brief Reap one completion
+ *
+ * @return 0 on success, -EAGAIN if the completion queue is empty
+ */
+static FORCE_INLINE sword_t batch_ring_reap(struct batch_ring *ring,
+	struct batch_cqe *cqe)
+{
+	word_t head = ring->cq_head;
+
+	if (head == *(volatile word_t *)&ring->cq_tail)
+	{
+		return -EAGAIN;
+	}
+
+	compiler_barrier();
+	*cqe = ring->cqes[head & BATCH_RING_MASK];
+	*(volatile word_t *)&ring->cq_head = head + 1;
+
+	return 0;
+}
+
+/*
+__syscall exception_t batch_submit(void *ring, word_t size)
+{
+	return EXCEPTION_NONE;
+}
+*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
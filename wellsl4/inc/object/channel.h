@@ -0,0 +1,167 @@
+#ifndef CHANNEL_H_
+#define CHANNEL_H_
+
+#include <types_def.h>
+#include <kernel_object.h>
+#include <sys/ring_buffer.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* descriptor item : offset and length of a payload inside the region */
+#define CHANNEL_DESC_TYPE 		0x4348u
+#define CHANNEL_DESC_WORDS 		2u
+
+/* the ring is sized in 32-bit words, one descriptor uses header + 2 words */
+#define CHANNEL_RING_WORDS 		CONFIG_CHANNEL_RING_WORDS
+#define CHANNEL_RING_BYTES 		(CHANNEL_RING_WORDS * sizeof(u32_t))
+
+/* badge bit signalled by the doorbell, the top bit so it does not
+   overlap the low IRQ badges of a consumer that also drives IRQs */
+#define CHANNEL_DOORBELL_BADGE 	BIT(BITS_PER_LONG - 1)
+
+/**
+ * @brief Shared memory channel layout
+ *
+ * The region handed to channel_create() starts with this header, the
+ * descriptor storage follows it, and the rest of the region is payload
+ * memory owned by the producer until the consumer takes the descriptor.
+ * Payload never passes through the kernel, the ring only carries offsets.
+ *
+ * The ring is single producer / single consumer, the producer only writes
+ * the tail and the consumer only writes the head, so no lock is needed.
+ */
+struct channel_ring {
+	struct ring_buf desc;
+	u32_t desc_storage[CHANNEL_RING_WORDS];
+};
+
+/* the header, the ring storage is part of it, and at least some payload */
+#define CHANNEL_REGION_MIN_SIZE 	(sizeof(struct channel_ring) + 1)
+
+/* the item header ring_buf_item_put() would write for a descriptor */
+#define CHANNEL_DESC_HEADER 		(CHANNEL_DESC_TYPE | (CHANNEL_DESC_WORDS << 16))
+
+/* The producer and the consumer may run on different cores, so ordering
+ * the ring words against the index that publishes them takes a real
+ * barrier, a dmb on ARM, not only a compiler one. */
+#define channel_ring_barrier() 	__atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+static FORCE_INLINE byte_t *channel_payload(struct channel_ring *ring)
+{
+	return (byte_t *)ring + sizeof(struct channel_ring);
+}
+
+static FORCE_INLINE word_t channel_payload_size(word_t region_size)
+{
+	return region_size - sizeof(struct channel_ring);
+}
+
+static FORCE_INLINE u32_t channel_ring_index(struct channel_ring *ring, u32_t index)
+{
+	return ring->desc.mask ? (index & ring->desc.mask) : (index % ring->desc.size);
+}
+
+/**
+ * @brief Publish one payload descriptor
+ *
+ * @param ring shared ring at the start of the region
+ * @param offset payload offset from channel_payload()
+ * @param length payload length in bytes
+ * @param doorbell set to TRUE if the consumer must be notified
+ *
+ * @return 0 on success, -EMSGSIZE if the ring is full
+ *
+ * The doorbell is only needed on the empty to non-empty transition, that is,
+ * when the consumer had already taken everything before this descriptor. The
+ * head is read after the tail is published, so a consumer that drained the
+ * ring concurrently is never left sleeping on a non-empty ring.
+ */
+static FORCE_INLINE sword_t channel_ring_put(struct channel_ring *ring,
+	word_t offset, word_t length, bool_t *doorbell)
+{
+	u32_t *words = ring->desc.buf.buf32;
+	u32_t tail = ring->desc.tail;
+
+	if (ring_buf_space_get(&ring->desc) < CHANNEL_DESC_WORDS + 1)
+	{
+		ring->desc.misc.item_mode.dropped_put_count++;
+		*doorbell = FALSE;
+		return -EMSGSIZE;
+	}
+
+	words[tail] = CHANNEL_DESC_HEADER;
+	words[channel_ring_index(ring, tail + 1)] = (u32_t)offset;
+	words[channel_ring_index(ring, tail + 2)] = (u32_t)length;
+
+	/* the descriptor is visible before the tail that covers it */
+	channel_ring_barrier();
+	*(volatile u32_t *)&ring->desc.tail = channel_ring_index(ring, 
+		tail + CHANNEL_DESC_WORDS + 1);
+
+	/* and the tail before the head is looked at for the doorbell */
+	channel_ring_barrier();
+	*doorbell = (*(volatile u32_t *)&ring->desc.head == tail);
+
+	return 0;
+}
+
+/**
+ * @brief Take one payload descriptor
+ *
+ * @return 0 on success, -EAGAIN if the ring is empty, -EMSGSIZE if the
+ * next item is not a descriptor
+ */
+static FORCE_INLINE sword_t channel_ring_get(struct channel_ring *ring,
+	word_t *offset, word_t *length)
+{
+	u32_t *words = ring->desc.buf.buf32;
+	u32_t head = ring->desc.head;
+
+	if (*(volatile u32_t *)&ring->desc.tail == head)
+	{
+		return -EAGAIN;
+	}
+
+	/* nothing of the descriptor is read before the tail that published it */
+	channel_ring_barrier();
+
+	if (words[head] != CHANNEL_DESC_HEADER)
+	{
+		return -EMSGSIZE;
+	}
+
+	*offset = words[channel_ring_index(ring, head + 1)];
+	*length = words[channel_ring_index(ring, head + 2)];
+
+	/* the slot is read before the producer may reuse it */
+	channel_ring_barrier();
+	*(volatile u32_t *)&ring->desc.head = channel_ring_index(ring, 
+		head + CHANNEL_DESC_WORDS + 1);
+
+	return 0;
+}
+
+struct channel *do_channel_create(word_t base, word_t size,
+	struct ktcb *producer, struct ktcb *consumer);
+void do_channel_doorbell(struct channel *ch);
+
+/*
+__syscall exception_t channel_create(void **channel, word_t base, 
+	word_t size, word_t producer_id, word_t consumer_id)
+{
+	return EXCEPTION_NONE;
+}
+
+__syscall exception_t channel_doorbell(void *channel)
+{
+	return EXCEPTION_NONE;
+}
+*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -61,6 +61,7 @@ typedef struct k_object_map obj_map_t;
 uintptr_t get_thread_k_object_data(void *object);
 void k_object_access_grant(void *object, struct ktcb *thread);
 void k_object_access_revoke(void *object, struct ktcb *thread);
+void do_kobject_access_grant(void *object, struct ktcb *thread);
 sword_t k_object_access_validate(struct k_object *ko, struct ktcb *thread,
 						enum obj_tag otype);
 
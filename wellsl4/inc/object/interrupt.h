@@ -6,7 +6,9 @@ extern "C" {
 #endif
 
 #include <types_def.h>
+#if defined(CONFIG_CPU_CORTEX_M)
 #include <arch/arm/aarch32/cortex_m/cmsis.h>
+#endif
 #include <kernel_object.h>
 #include <arch/irq.h>
 
@@ -25,6 +27,7 @@ enum interrupt_action {
 	interrupt_timer_enable,
     interrupt_disable,
     interrupt_free,
+	interrupt_direct_enable,
     interrupt_action_number
 };
 
@@ -32,21 +35,51 @@ enum interrupt_state {
 	interrupt_irq_inactive = 0,
 	interrupt_irq_signal,
 	interrupt_irq_timer,
+	interrupt_irq_direct,
 	interrupt_irq_reserved
 };
 
 typedef enum interrupt_state interrupt_state_t;
 
-static FORCE_INLINE void interrupt_array_init(struct interrupt **array)
+/* badge bit an IRQ sets in the notifation word of its thread, lines
+   that are BITS_PER_LONG apart share a bit */
+static FORCE_INLINE word_t interrupt_badge(int32_t num)
 {
-	for(word_t it = 0; it < CONFIG_NUM_IRQS; it ++)	
-	{
-		array[it] = NULL;
-	}
+	return BIT((word_t)num & (BITS_PER_LONG - 1));
 }
 
+/* IRQ objects are preallocated, one per line; with GEN_IRQ_OBJECT_TABLE
+ * the table is emitted by gen_isr_tables.py */
+#if defined(CONFIG_GEN_IRQ_OBJECT_TABLE)
+extern struct interrupt irq_object_table[IRQ_TABLE_SIZE];
+#endif
+
+/*
+ * Direct delivery (CONFIG_IRQ_DIRECT_DELIVERY)
+ *
+ * An IRQ enabled with interrupt_direct_enable is owned by a thread at
+ * priority NUM_PRIORITIES - 1 that waits on its notifation node. On the
+ * interrupt the ISR masks the line, hands the badge to the thread in MR1,
+ * puts the interrupted thread back on its ready queue and makes the
+ * handler the ready thread; PendSV then switches to it. No timestamp is
+ * taken, no budget is checked or charged and schedule() does not run.
+ *
+ * No handler context is precomputed: the handler is blocked in its wait,
+ * so the switch that blocked it already saved everything PendSV restores.
+ * The thread and its notifation node are fixed when the IRQ is enabled
+ * and the badge goes to a fixed MR slot, the ISR computes nothing else.
+ *
+ * Worst case latency from the interrupt to the first handler instruction
+ * is exception entry + handle_interrupt up to interrupt_direct (no loops,
+ * one ipc_lock and one thread_swap_lock section) + the tail-chained PendSV
+ * context switch + the longest irq_lock section of the kernel. It does not
+ * depend on the number of threads, bound IRQs or pending refills. The time
+ * the handler runs is charged to the sched context of whichever thread is
+ * current at the next kernel entry.
+ */
 void interrupt_request(struct ktcb *send);
 void interrupt_respond(struct ktcb *recv);
+void interrupt_release(struct ktcb *thread);
 bool_t do_interrupt_service(int32_t num);
 void handle_interrupt(void);
 
@@ -15,7 +15,7 @@ extern "C" {
 #define PLUS_32
 #endif
 
-#define MESSAGE_REGISTER_NUM 16  										
+#define MESSAGE_REGISTER_NUM 11  						/* MR0-2 in registers, MR3-10 in the utcb */
 #define STRING_ITEM 	(1UL << 3) 						/*0-TRUE*/
 #define MAP_ITEM    	(1UL << 3) 						/*1-TRUE*/
 #define GRANT_ITEM  	(1UL << 3 | 1UL << 1) 			/*1-TRUE*/
@@ -225,7 +225,7 @@ static FORCE_INLINE word_t load_message_registers(struct ktcb *from, word_t msg_
 			message_word = from->callee_saved.mr[7];
 			break;
 		default:
-			message_word = from->user->mr[msg_num - 8];
+			message_word = from->user->mr[msg_num - 3];
 			break;
 	}
 
@@ -245,7 +245,7 @@ static FORCE_INLINE void store_message_registers(struct ktcb *to, word_t msg_num
 			to->callee_saved.mr[7] = msg_data;
 			break;
 		default:
-			to->user->mr[msg_num - 8] = msg_data;
+			to->user->mr[msg_num - 3] = msg_data;
 			break;
 	}
 }
@@ -270,15 +270,26 @@ static FORCE_INLINE word_t get_message_ipcflag(struct ktcb *thread)
 	return message_get_tag_flag(tag);
 }
 
+/* the badge word is handed to the signalled thread in this message register */
+#define NOTIFATION_BADGE_MR 1
+
+static FORCE_INLINE void deliver_signal_badge(struct ktcb *thread, word_t badge)
+{
+	store_message_registers(thread, NOTIFATION_BADGE_MR, badge);
+}
+
 void send_ipc(struct ktcb *thread, bool_t blocking, bool_t candonate, message_t *node);
 void cancel_ipc(struct ktcb *thread);
 void receive_ipc(struct ktcb *thread, bool_t blocking, message_t *node);
 void reorder_message_node(struct ktcb *thread);
 void reorder_noticenode(struct ktcb *thread);
 void complete_signal(struct ktcb *thread, notifation_t *node);
+void direct_signal(struct ktcb *thread, notifation_t *node, word_t badge);
 void cancel_signal(struct ktcb *thread, notifation_t *node);
 void recevie_signal(struct ktcb *thread, notifation_t *node, bool_t blocking);
-void send_signal(notifation_t *node);
+void send_signal(notifation_t *node, word_t badge);
+struct notifation *notifation_node_alloc(struct ktcb *thread);
+void notifation_node_free(struct ktcb *thread);
 
 /*
 __syscall exception_t exchange_ipc(
@@ -293,6 +304,7 @@ __syscall exception_t exchange_ipc(
 */
 
 exception_t do_exchange_ipc(	
+	struct ktcb *caller,
 	word_t recv_gid, 
 	word_t send_gid,
 	word_t timeout,
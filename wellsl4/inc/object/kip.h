@@ -147,9 +147,44 @@ struct kip_info {
 
 typedef struct kip_info kip_t;
 
+/* Clock snapshot published next to the KIP. The writer bumps seq to
+ * an odd value, updates the fields and bumps it back to even; readers
+ * retry while seq is odd or changed under them (see kip_clock_read).
+ */
+struct kip_clock {
+	word_t  seq;
+	word_t  reserved;
+	dword_t clock;	/* system_clock() value at the last update */
+	dword_t tick;	/* tick count at the last update */
+};
+
+typedef struct kip_clock kip_clock_t;
+
 /* KIP declarations */
 extern struct kip_info kip;
 
+#if defined(CONFIG_USER_KIP_PAGE)
+extern struct kip_clock kip_clock;
+
+void update_kip_clock(dword_t clock, dword_t tick);
+
+static inline dword_t kip_clock_read(const volatile struct kip_clock *kc)
+{
+	word_t  seq;
+	dword_t clock;
+
+	do
+	{
+		seq = kc->seq;
+		compiler_barrier();
+		clock = kc->clock;
+		compiler_barrier();
+	} while ((seq & 1) || seq != kc->seq);
+
+	return clock;
+}
+#endif
+
 /*
 __syscall word_t kernel_interface(
 	word_t *version, 
@@ -3,6 +3,7 @@
 
 #include <types_def.h>
 #include <sys/mempool.h>
+#include <sys/tlsf.h>
 #include <arch/cpu.h>
 #include <kernel_object.h>
 
@@ -29,11 +30,31 @@ struct slot
 	void *data;
 };
 
+#if defined(CONFIG_HEAP_MEM_POOL_TLSF)
+struct k_mem_pool
+{
+	struct sys_tlsf_pool base;
+};
+
+/* tlsf blocks are described by offset, level is always 0 */
+#define k_mem_pool_base_init(base) 		sys_tlsf_pool_init(base)
+#define k_mem_pool_block_alloc(base, size, level_p, block_p, data_p) \
+	sys_tlsf_block_alloc(base, size, level_p, block_p, data_p)
+#define k_mem_pool_block_free(base, level, block) \
+	sys_tlsf_block_free(base, level, block)
+#else
 struct k_mem_pool
 {
 	struct sys_mem_pool_base base;
 };
 
+#define k_mem_pool_base_init(base) 		sys_mem_pool_base_init(base)
+#define k_mem_pool_block_alloc(base, size, level_p, block_p, data_p) \
+	sys_mem_pool_block_alloc(base, size, level_p, block_p, data_p)
+#define k_mem_pool_block_free(base, level, block) \
+	sys_mem_pool_block_free(base, level, block)
+#endif
+
 /**
  * @brief Statically define and initialize a memory pool.
  *
@@ -42,6 +63,9 @@ struct k_mem_pool
  * quarters, down to blocks of @a min_size bytes long. The buffer is aligned
  * to a @a align -byte boundary.
  *
+ * With CONFIG_HEAP_MEM_POOL_TLSF the buffer is one tlsf pool of
+ * @a max_size * @a n_max bytes and @a min_size is ignored.
+ *
  * If the pool is to be accessed outside the module where it is defined, it
  * can be declared via
  *
@@ -54,6 +78,19 @@ struct k_mem_pool
  * @param align Alignment of the pool's buffer (power of 2).
  * @req K-MPOOL-001
  */
+#if defined(CONFIG_HEAP_MEM_POOL_TLSF)
+#define MEM_POOL_DEFINE(name, minsz, maxsz, nmax, align)		\
+	char __aligned(MAX(WB_UP(align), TLSF_ALIGN)) 			\
+		_mpool_buf_##name[WB_UP(maxsz) * nmax]; 		\
+	STRUCT_SECTION_ITERABLE(k_mem_pool, name) = { \
+		.base = {						\
+			.buf = _mpool_buf_##name,			\
+			.size = WB_UP(maxsz) * nmax,			\
+			.flag = SYS_MEM_POOL_KERNEL			\
+		} \
+	}; \
+	BUILD_ASSERT(WB_UP(maxsz) * nmax < SYS_TLSF_MAX_POOL_SIZE)
+#else
 #define MEM_POOL_DEFINE(name, minsz, maxsz, nmax, align)		\
 	char __aligned(WB_UP(align)) _mpool_buf_##name[WB_UP(maxsz) * nmax \
 				  + _MPOOL_BITS_SIZE(maxsz, minsz, nmax)]; \
@@ -69,6 +106,7 @@ struct k_mem_pool
 		} \
 	}; \
 	BUILD_ASSERT(WB_UP(maxsz) >= _MPOOL_MINBLK)
+#endif
 
 extern struct k_mem_pool _k_mem_pool_list_start[];
 extern struct k_mem_pool _k_mem_pool_list_start[];
@@ -83,6 +121,10 @@ static FORCE_INLINE word_t poolptr_to_offset(struct k_mem_pool *pool_ptr)
 	return pool_ptr - &_k_mem_pool_list_start[0];
 }
 
+typedef void (*wordlist_cb_func_t)(struct k_object *ko, void *ctx);
+
+void k_object_wordlist_foreach(wordlist_cb_func_t func, void *ctx_ptr);
+
 static FORCE_INLINE void k_object_right_set(struct k_object *k, uintptr_t r)
 {
 	sys_bitfield_set_bit((maddr_t)&k->right, r);
@@ -93,9 +135,14 @@ static FORCE_INLINE void k_object_right_clear(struct k_object *k, uintptr_t r)
 	sys_bitfield_clear_bit((maddr_t)&k->right, r);
 }
 
+static FORCE_INLINE void k_object_right_clear_cb(struct k_object *k, void *r)
+{
+	k_object_right_clear(k, (uintptr_t)r);
+}
+
 static FORCE_INLINE void k_object_right_clear_all(uintptr_t r)
 {
-	k_object_wordlist_foreach(k_object_right_clear, r);
+	k_object_wordlist_foreach(k_object_right_clear_cb, (void *)r);
 }
 
 static FORCE_INLINE sword_t k_object_right_test(struct k_object *k, uintptr_t r)
@@ -113,9 +160,14 @@ static FORCE_INLINE void k_object_data_clear(struct k_object *k, uintptr_t d)
 	sys_bitfield_clear_bit((maddr_t)&k->data, d);
 }
 
+static FORCE_INLINE void k_object_data_clear_cb(struct k_object *k, void *d)
+{
+	k_object_data_clear(k, (uintptr_t)d);
+}
+
 static FORCE_INLINE void k_object_data_clear_all(uintptr_t d)
 {
-	k_object_wordlist_foreach(k_object_data_clear, d);
+	k_object_wordlist_foreach(k_object_data_clear_cb, (void *)d);
 }
 
 static FORCE_INLINE sword_t k_object_data_test(struct k_object *k, uintptr_t d)
@@ -132,6 +184,7 @@ bool_t is_same_objecttype(struct k_object *k1, struct k_object *k2);
 bool_t is_same_object(struct k_object *k1, struct k_object *k2);
 void *d_object_alloc(enum obj_tag type, word_t untyped_obj_size);
 void d_object_free(void *obj);
+void *d_object_carve(void *memory, enum obj_tag type);
 void k_object_update_data(bool_t is_set,
 				uintptr_t data, struct k_object *k);
 void k_object_mask_right(bool_t is_set,
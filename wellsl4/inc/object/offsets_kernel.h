@@ -117,6 +117,7 @@ GEN_OFFSET_SYM(thread_base_t, swap_data);
 GEN_OFFSET_SYM(ktcb_t, base);
 GEN_OFFSET_SYM(ktcb_t, callee_saved);
 GEN_OFFSET_SYM(ktcb_t, arch);
+GEN_OFFSET_SYM(ktcb_t, cold);
 
 #if defined(CONFIG_USE_SWITCH) 
 GEN_OFFSET_SYM(ktcb_t, swap_handler);
@@ -126,15 +127,18 @@ GEN_OFFSET_SYM(ktcb_t, swap_handler);
 GEN_OFFSET_SYM(thread_stack_info_t, start);
 GEN_OFFSET_SYM(thread_stack_info_t, size);
 
-GEN_OFFSET_SYM(ktcb_t, stack_info);
+GEN_OFFSET_SYM(ktcb_cold_t, stack_info);
 #endif
 
 #if defined(CONFIG_THREAD_MONITOR)
-GEN_OFFSET_SYM(ktcb_t, monitor_thread_next);
+GEN_OFFSET_SYM(ktcb_cold_t, monitor_thread_next);
 #endif
 
 GEN_ABSOLUTE_SYM(THREAD_SIZEOF, sizeof(struct ktcb));
 
+/* bytes of the tcb touched by scheduling, ipc and context switch */
+GEN_ABSOLUTE_SYM(THREAD_HOT_SIZEOF, offsetof(struct ktcb, cold));
+
 /* size of the device structure. Used by linker scripts */
 GEN_ABSOLUTE_SYM(DEVICE_STRUCT_SIZEOF, sizeof(struct device));
 
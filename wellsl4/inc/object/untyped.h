@@ -6,6 +6,7 @@
 #include <kernel/cspace.h>
 #include <arch/thread.h>
 #include <kernel_object.h>
+#include <sys/assert.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -45,8 +46,50 @@ sword_t do_user_from_copy(void *dst, const void *src, size_t size);
 sword_t do_user_to_copy(void *dst, const void *src, size_t size);
 
 
-exception_t retype_untyped_object(struct d_object *dest, enum obj_tag user_type,
+/* head of every untyped object, the carved memory follows it */
+struct untyped_region {
+	word_t size;		/* bytes that can be carved */
+	word_t free_offset;	/* next carve offset */
+	word_t zeroed;		/* [free_offset, zeroed) is already cleared for the next carve */
+	word_t watermark;	/* highest offset ever carved, memory above it was never used */
+	word_t children;	/* carved objects still live, no reset or free before they are gone */
+};
+
+/* in front of every carved object, the untyped it was carved from */
+struct untyped_child {
+	struct untyped_region *parent;
+};
+
+static FORCE_INLINE struct untyped_region *untyped_region_of(struct d_object *d)
+{
+	return (struct untyped_region *)d->k_obj_self;
+}
+
+static FORCE_INLINE byte_t *untyped_region_memory(struct untyped_region *region)
+{
+	return (byte_t *)(region + 1);
+}
+
+static FORCE_INLINE bool_t untyped_has_children(struct d_object *d)
+{
+	return untyped_region_of(d)->children != 0;
+}
+
+/* a carved object was freed, its memory goes back with the untyped */
+static FORCE_INLINE void untyped_child_release(struct d_object *d)
+{
+	struct untyped_region *parent = ((struct untyped_child *)d - 1)->parent;
+
+	assert(parent->children != 0);
+	parent->children--;
+}
+
+void untyped_region_init(struct untyped_region *region, word_t size);
+
+exception_t retype_untyped_object(void **object, enum obj_tag user_type,
 	bool_t reset, size_t user_size, struct d_object *src);
+exception_t retype_untyped_bulk_object(struct d_object *src, enum obj_tag user_type,
+	size_t user_size, word_t number, void **objects);
 
 /*
 __syscall exception_t retype_untyped(void *kobject, 
@@ -54,6 +97,13 @@ __syscall exception_t retype_untyped(void *kobject,
 {
 	return EXCEPTION_NONE;
 
+}
+
+__syscall exception_t retype_untyped_bulk(void *kobject, enum obj_tag user_type,
+	size_t user_size, word_t number, void **objects)
+{
+	return EXCEPTION_NONE;
+
 }
 */
 
@@ -5,10 +5,11 @@
 
 #include <types_def.h>
 #include <kernel_object.h>
+#include <kernel/stack.h>
 #include <default/default.h>
 
 extern fastipc_path_t fastipc_caller;
-extern struct ktcb *record_threads[256];
+extern struct ktcb *record_threads[THREAD_TABLE_SIZE];
 extern word_t record_thread_count;
 
 extern word_t work_units_completed;
@@ -44,7 +45,9 @@ extern bool_t reprogram;
 
 /* ready queue bitmap by sched_prior */
 extern word_t ready_queues_l1_bitmap[CONFIG_NUM_DOMAINS];
+#if SCHED_BITMAP_LEVELS > 1
 extern word_t ready_queues_l2_bitmap[CONFIG_NUM_DOMAINS][L2_BITMAP_BITS];
+#endif
 
 /* time */
 /* the amount of time passed since the kernel time was last updated */
@@ -53,6 +56,12 @@ extern ticks_t consume_time;	/*usage time length*/
 /* the _current_thread kernel time (recorded on kernel entry) */
 extern ticks_t current_time;	/*_current_thread time point*/
 
+#if defined(CONFIG_SCHED_BUDGET_CYCLES)
+/* cycle count at the last kernel entry and the sub-tick part of consume_time */
+extern u64_t current_cycle_time;
+extern u64_t consume_cycle;
+#endif
+
 /* Domain timeslice remaining */
 extern ticks_t current_domain_time;	/*domain can use time*/
 
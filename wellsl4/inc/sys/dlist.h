@@ -447,10 +447,10 @@ static FORCE_INLINE void sys_dlist_prepend(sys_dlist_t *list, sys_dnode_t *node)
  */
 static FORCE_INLINE void sys_dlist_insert(sys_dnode_t *successor, sys_dnode_t *node)
 {
-	node->next = successor->next;
-	node->prev = successor;
-	successor->next->prev = node;
-	successor->next = node;
+	node->prev = successor->prev;
+	node->next = successor;
+	successor->prev->next = node;
+	successor->prev = node;
 }
 
 /**
@@ -13,9 +13,6 @@
 extern "C" {
 #endif
 
-#include <toolchain/xcc_missing_defs.h>
-
-
 #define UCHAR_MAX	__UINT8_MAX__
 #define SCHAR_MAX	__INT8_MAX__
 #define SCHAR_MIN	(-SCHAR_MAX - 1)
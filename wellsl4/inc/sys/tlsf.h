@@ -0,0 +1,82 @@
+#ifndef SYS_TLSF_H_
+#define SYS_TLSF_H_
+
+#include <types_def.h>
+#include <toolchain.h>
+#include <sys/util.h>
+#include <sys/mempool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Two-level segregated fit allocator
+ *
+ * The first level splits free blocks by power of two, the second level splits
+ * each power of two into TLSF_SL_COUNT linear ranges. One bitmap per level
+ * records which lists are non-empty, so finding, splitting and merging a
+ * block is a fixed number of bit scans and list operations whatever the pool
+ * state is.
+ */
+
+#define TLSF_ALIGN_LOG2 	3
+#define TLSF_ALIGN 			BIT(TLSF_ALIGN_LOG2)
+#define TLSF_SL_LOG2 		4
+#define TLSF_SL_COUNT 		BIT(TLSF_SL_LOG2)
+#define TLSF_FL_SHIFT 		(TLSF_SL_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_FL_MAX 		20
+#define TLSF_FL_COUNT 		(TLSF_FL_MAX - TLSF_FL_SHIFT + 1)
+#define TLSF_SMALL_BLOCK 	BIT(TLSF_FL_SHIFT)
+
+/* largest pool a single tlsf pool can manage */
+#define SYS_TLSF_MAX_POOL_SIZE 	BIT(TLSF_FL_MAX)
+
+struct sys_tlsf_block {
+	struct sys_tlsf_block *prev_phys; /* physical previous block */
+	word_t size;					  /* payload size | TLSF_BLOCK_* flags */
+	struct sys_tlsf_block *next_free; /* free list, only valid while free */
+	struct sys_tlsf_block *prev_free;
+};
+
+struct sys_tlsf_stats {
+	size_t total_bytes;		/* bytes managed by the pool, headers included */
+	size_t used_bytes;		/* payload bytes currently allocated */
+	size_t max_used_bytes;	/* high water mark of used_bytes */
+	size_t free_bytes;		/* payload bytes currently free */
+	size_t largest_free;	/* largest single free block */
+	u32_t  free_blocks;		/* number of free blocks */
+	u32_t  fragmentation;	/* 0..100, 100 - largest_free * 100 / free_bytes */
+};
+
+struct sys_tlsf_pool {
+	void *buf;
+	size_t size;
+	u32_t fl_bitmap;
+	u32_t sl_bitmap[TLSF_FL_COUNT];
+	struct sys_tlsf_block *blocks[TLSF_FL_COUNT][TLSF_SL_COUNT];
+	size_t used_bytes;
+	size_t max_used_bytes;
+	byte_t flag;
+};
+
+void sys_tlsf_pool_init(struct sys_tlsf_pool *p);
+
+/**
+ * @brief Allocate a block, same contract as sys_mem_pool_block_alloc()
+ *
+ * The level is always 0, the block is the payload offset in TLSF_ALIGN units,
+ * so a struct slot_desc can describe a tlsf block as well as a buddy block.
+ */
+sword_t sys_tlsf_block_alloc(struct sys_tlsf_pool *p, size_t size,
+			      u32_t *level_p, u32_t *block_p, void **data_p);
+void sys_tlsf_block_free(struct sys_tlsf_pool *p, u32_t level,
+			      u32_t block);
+
+void sys_tlsf_pool_stats_get(struct sys_tlsf_pool *p, struct sys_tlsf_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -66,7 +66,7 @@ static inline void L4_StoreMR(L4_Word_t i, L4_Word_t *w)
 		/* case 7: *w = L4_MR7; break; */
 		default:
 			if (i >= 0 && i < L4_NUM_MRS)
-				*w = L4_UTCB()->mr[i - 8];
+				*w = L4_UTCB()->mr[i - 3];
 			else
 				*w = 0;
 	}
@@ -86,7 +86,7 @@ static inline void L4_LoadMR(L4_Word_t i, L4_Word_t w)
 		/* case 7: L4_MR7 = w; break; */
 		default:
 			if (i >= 0 && i < L4_NUM_MRS)
-				L4_UTCB()->mr[i - 8] = w;
+				L4_UTCB()->mr[i - 3] = w;
 	}
 }
 
@@ -0,0 +1,54 @@
+#ifndef L4_BATCH_H_
+#define L4_BATCH_H_
+
+#include <inc_l4/types.h>
+#include <object/batch.h>
+#include <syscalls/batch.h>
+
+/* L4_BatchSubmit : batched syscall function
+   Run the queued object and mapping operations of the ring in order, one
+   completion is written for every submission taken
+
+  output:
+   1. result:The result is 1 if the operation succeeded, otherwise the result is 0 and the ErrorCode TCR
+  		   indicates the failure reason. A failed entry does not fail the call, it is
+  		   reported in the status and error of its completion.
+
+  input:
+   1. ring:Region owned by the caller, initialized with L4_BatchInit
+   2. size
+
+  pagefaults:
+   none
+
+  ErrorCode:
+   TCR_INVAL_PARA
+*/
+static inline L4_Word_t L4_BatchSubmit(struct batch_ring *ring, L4_Word_t size)
+{
+	L4_Word_t except;
+
+	except = batch_submit(ring, size);
+
+	return except ? L4_False : L4_True;
+}
+
+static inline void L4_BatchInit(struct batch_ring *ring)
+{
+	batch_ring_init(ring);
+}
+
+/* L4_BatchQueue : queue one operation, the kernel is not entered */
+static inline L4_Word_t L4_BatchQueue(struct batch_ring *ring, L4_Word_t op,
+	L4_Word_t user_data, L4_Word_t arg0, L4_Word_t arg1, L4_Word_t arg2)
+{
+	return batch_ring_push(ring, op, user_data, arg0, arg1, arg2) ? L4_False : L4_True;
+}
+
+/* L4_BatchReap : take the next completion, returns 0 when none is left */
+static inline L4_Word_t L4_BatchReap(struct batch_ring *ring, struct batch_cqe *cqe)
+{
+	return batch_ring_reap(ring, cqe) ? L4_False : L4_True;
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef L4_CHANNEL_H_
+#define L4_CHANNEL_H_
+
+#include <inc_l4/types.h>
+#include <inc_l4/ipc.h>
+#include <object/channel.h>
+#include <syscalls/channel.h>
+
+/* L4_ChannelCreate : shared memory channel syscall function
+   Validate a region owned by the caller, map it into producer and consumer and
+   bind the consumer notifation as the channel doorbell
+
+  output:
+   1. result:The result is 1 if the operation succeeded, otherwise the result is 0 and the ErrorCode TCR
+  		   indicates the failure reason.
+   2. channel:The channel handle used by the producer to ring the doorbell
+
+  input:
+   1. region:Power of two sized, size aligned, at least CHANNEL_REGION_MIN_SIZE bytes
+   2. size
+   3. producer
+   4. consumer
+
+  pagefaults:
+   none
+
+  ErrorCode:
+   TCR_INVAL_PARA, TCR_INVAL_THREAD, TCR_OUT_OF_MEM
+*/
+static inline L4_Word_t L4_ChannelCreate(void **channel, void *region, 
+	L4_Word_t size, L4_ThreadId_t producer, L4_ThreadId_t consumer)
+{
+	L4_Word_t except;
+
+	except = channel_create(channel, (word_t)region, size, 
+		producer.raw, consumer.raw);
+
+	return except ? L4_False : L4_True;
+}
+
+static inline void *L4_ChannelPayload(void *region)
+{
+	return channel_payload((struct channel_ring *)region);
+}
+
+/* L4_ChannelSend : publish a payload already written into the region, 
+   the kernel is only entered when the consumer may be waiting */
+static inline L4_Word_t L4_ChannelSend(void *channel, void *region, 
+	L4_Word_t offset, L4_Word_t length)
+{
+	bool_t doorbell;
+
+	if (channel_ring_put((struct channel_ring *)region, offset, length, &doorbell))
+		return L4_False;
+
+	if (doorbell)
+		channel_doorbell(channel);
+
+	return L4_True;
+}
+
+/* L4_ChannelReceive : take the next payload, wait on the doorbell only when the ring is empty */
+static inline void L4_ChannelReceive(void *region, 
+	L4_Word_t *offset, L4_Word_t *length)
+{
+	L4_ThreadId_t from;
+
+	while (channel_ring_get((struct channel_ring *)region, offset, length))
+	{
+		L4_Wait(&from);
+	}
+}
+
+#endif
@@ -250,6 +250,16 @@ static inline L4_MsgTag_t L4_Wait(L4_ThreadId_t *FromAny)
 	return L4_Wait_Timeout(L4_NEVER, FromAny);
 }
 
+/* badge bits of every signal coalesced since the last wakeup, 
+   the kernel hands the notifation word over in MR1 and clears it */
+static inline L4_Word_t L4_NotifyBadge(void)
+{
+	L4_Word_t badge;
+
+	L4_StoreMR(1, &badge);
+	return badge;
+}
+
 static inline void L4_Sleep(L4_Time_t Period)
 {
 	L4_ThreadId_t FromAny;
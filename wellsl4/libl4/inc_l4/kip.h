@@ -2,6 +2,7 @@
 #define L4_KIP_H_
 
 #include <inc_l4/types.h>
+#include <object/kip.h>
 #include <syscalls/kip.h>
 
 typedef union {
@@ -331,7 +332,7 @@ enum L4_MemoryType {
   to enable unrestricted structural changes of the kernel interface page in future versions, and (b) to enable secure detection
   of the kernel’s endian mode (little/big) and word width (32/64).
 
-  [Slow Systemcall]
+  [Slow Systemcall, plain loads with CONFIG_USER_KIP_PAGE]
   output:
   	1. kernel interface page(return)
   	2. API Version
@@ -347,7 +348,15 @@ void *L4_KernelInterface(L4_Word_t *api_version,
 	L4_Word_t *api_flags,
 	L4_Word_t *kernel_id)
 {
+#if defined(CONFIG_USER_KIP_PAGE)
+	*api_version = kip.apiv.raw;
+	*api_flags = kip.apif.raw;
+	*kernel_id = kip.kid;
+
+	return (void *)&kip;
+#else
 	return (void *)kernel_interface(api_version, api_flags, kernel_id);
+#endif
 }
 
 /* L4_KernelInterface derived functions */
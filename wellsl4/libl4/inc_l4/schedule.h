@@ -5,6 +5,7 @@
 #include <syscalls/time.h>
 #include <syscalls/registers.h>
 #include <syscalls/tcb.h>
+#include <object/kip.h>
 
 /* L4_ProcessorControl : processer configuration syscall function
    Control the internal frequency, external frequency, or voltage for a system processor
@@ -105,6 +106,8 @@ L4_Word_t L4_SpaceControl(L4_ThreadId_t space_specifier,
 
 /* L4_SystemClock : get system clock syscall function
    Delivers the current system clock. Typically, the operation does not enter kernel mode.
+   With CONFIG_USER_KIP_PAGE it reads the clock snapshot in the KIP partition, that is
+   the time of the last kernel entry.
    
    [Systemcall]
    output:
@@ -120,7 +123,11 @@ L4_Clock_t L4_SystemClock(void)
 		.raw = 0,
 	};
 
+#if defined(CONFIG_USER_KIP_PAGE)
+	temp.raw = kip_clock_read(&kip_clock);
+#else
 	system_clock(&(temp.raw));
+#endif
 	return temp;
 }
 
@@ -190,6 +197,14 @@ L4_Word_t L4_ThreadSwitch(L4_ThreadId_t dest)
 */
 
 
+/* ProcessorControl word: processor number in the low half, timer slack
+   in ticks in the high half (honoured with CONFIG_TIMER_SLACK) */
+static inline L4_Word_t L4_ProcessorControlSlack(L4_Word_t processor,
+	L4_Word_t slack_ticks)
+{
+	return (slack_ticks << 16) | (processor & 0xFFFF);
+}
+
 L4_Word_t L4_Schedule(L4_ThreadId_t dest,
    L4_Word_t time_control,
    L4_Word_t processor_control,
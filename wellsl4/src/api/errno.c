@@ -11,6 +11,6 @@ const int _k_neg_eagain = -EAGAIN;
 #if defined(CONFIG_ERRNO) 
 int *get_errno(void)
 {
-	return &_current_thread->errno_var;
+	return &_current_thread->cold.errno_var;
 }
 #endif
@@ -13,6 +13,7 @@
 #include <arch/registers.h>
 #include <object/untyped.h>
 #include <syscall_list.h>
+#include <benchmark/wcet.h>
 
 #include <syscalls/device_binding_mrsh.c>
 #include <syscalls/dobject_alloc_mrsh.c>
@@ -24,6 +25,7 @@
 #include <syscalls/kobject_access_revoke_mrsh.c>
 #include <syscalls/processor_control_mrsh.c>
 #include <syscalls/retype_untyped_mrsh.c>
+#include <syscalls/retype_untyped_bulk_mrsh.c>
 #include <syscalls/schedule_control_mrsh.c>
 #include <syscalls/space_control_mrsh.c>
 #include <syscalls/switch_thread_mrsh.c>
@@ -32,6 +34,60 @@
 #include <syscalls/unmap_page_mrsh.c>
 #include <syscalls/uprintk_string_out_mrsh.c>
 
+#if defined(CONFIG_IRQ_LATENCY_STATS)
+#include <benchmark/irq_stats.h>
+#include <syscalls/irq_stats_print_mrsh.c>
+#endif
+
+#if defined(CONFIG_TIMER_SLACK)
+#include <syscalls/timer_slack_print_mrsh.c>
+#endif
+
+#if defined(CONFIG_SCHED_LATENCY_STATS)
+#include <benchmark/sched_stats.h>
+#include <syscalls/sched_stats_read_mrsh.c>
+#include <syscalls/sched_stats_null_mrsh.c>
+#endif
+
+#if defined(CONFIG_THREAD_RUNTIME_STATS)
+#include <benchmark/thread_stats.h>
+#include <syscalls/thread_stats_read_mrsh.c>
+#include <syscalls/thread_stats_print_mrsh.c>
+#endif
+
+#if defined(CONFIG_WCET_STATS)
+#include <syscalls/wcet_read_mrsh.c>
+#include <syscalls/wcet_print_mrsh.c>
+#endif
+
+#if defined(CONFIG_STACK_USAGE)
+#include <benchmark/stack_usage.h>
+#include <syscalls/stack_usage_read_mrsh.c>
+#include <syscalls/stack_usage_print_mrsh.c>
+#endif
+
+#if defined(CONFIG_TRACING)
+#include <benchmark/trace.h>
+#include <syscalls/trace_ring_print_mrsh.c>
+#endif
+
+#if defined(CONFIG_PROFILER)
+#include <benchmark/profile.h>
+#include <syscalls/profile_control_mrsh.c>
+#include <syscalls/profile_print_mrsh.c>
+#endif
+
+#if defined(CONFIG_CHANNEL)
+#include <object/channel.h>
+#include <syscalls/channel_create_mrsh.c>
+#include <syscalls/channel_doorbell_mrsh.c>
+#endif
+
+#if defined(CONFIG_SYSCALL_BATCH)
+#include <object/batch.h>
+#include <syscalls/batch_submit_mrsh.c>
+#endif
+
 extern void arch_syscall_oops(void *ssf);
 uintptr_t handle_invaild_handler(uintptr_t arg1, uintptr_t arg2,
 				     uintptr_t arg3, uintptr_t arg4,
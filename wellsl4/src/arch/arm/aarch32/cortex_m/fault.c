@@ -16,6 +16,7 @@
 #include <sys/string.h>
 #include <arch/arm/aarch32/cortex_m/cmsis.h>
 #include <arch/syscall.h>
+#include <benchmark/wcet.h>
 /*
  * This is used by some architectures to define code ranges which may
  * perform operations that could generate a CPU exception that should not
@@ -1046,6 +1047,8 @@ void arm_fault(u32_t msp, u32_t psp, u32_t exc_return)
 	 */
 	arch_esf_t esf_copy;
 
+	wcet_exception_enter(fault);
+
 	/* Force unlock interrupts */
 	arch_irq_unlock(0);
 
@@ -1057,6 +1060,7 @@ void arm_fault(u32_t msp, u32_t psp, u32_t exc_return)
 		"ESF could not be retrieved successfully. Shall never occur.");
 
 	reason = fault_handle(esf, fault, &recoverable);
+	wcet_exception_exit(fault, esf->basic.pc, esf->basic.lr);
 	if (recoverable) 
 	{
 		return;
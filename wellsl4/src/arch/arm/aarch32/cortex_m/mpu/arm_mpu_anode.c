@@ -74,6 +74,14 @@ void arm_configure_static_mpu_regions(void)
 		.attr = MEM_PARTITION_P_RX_U_RX,
 	};
 #endif /* CONFIG_ARCH_HAS_RAMFUNC_SUPPORT */
+#if defined(CONFIG_USER_KIP_PAGE)
+	const struct partition user_kip_region =
+	{
+		.start = (u32_t)&_user_kip_ram_start,
+		.size = (u32_t)&_user_kip_ram_size,
+		.attr = MEM_PARTITION_P_RW_U_RO,
+	};
+#endif /* CONFIG_USER_KIP_PAGE */
 
 	/* Define a constant array of partition k_objects
 	 * to hold the configuration of the respective static
@@ -88,8 +96,11 @@ void arm_configure_static_mpu_regions(void)
 		&nocache_region,
 #endif /* CONFIG_NOCACHE_MEMORY */
 #if defined(CONFIG_ARCH_HAS_RAMFUNC_SUPPORT)
-		&ramfunc_region
+		&ramfunc_region,
 #endif /* CONFIG_ARCH_HAS_RAMFUNC_SUPPORT */
+#if defined(CONFIG_USER_KIP_PAGE)
+		&user_kip_region,
+#endif /* CONFIG_USER_KIP_PAGE */
 	};
 
 	/* Configure the static MPU regions within firmware SRAM boundaries.
@@ -147,7 +158,7 @@ void arm_configure_dynamic_mpu_regions(struct ktcb *thread)
 	struct partition thread_stack;
 
 	/* Memory domain */
-	struct thread_page *pagetable_item = thread->userspace_fpage_table.pagetable_item;
+	struct thread_page *pagetable_item = thread->cold.userspace_fpage_table.pagetable_item;
 
 	if (pagetable_item) 
 	{
@@ -182,8 +193,8 @@ void arm_configure_dynamic_mpu_regions(struct ktcb *thread)
 	/* Thread user stack */
 	if (thread->arch.priv_stack_start)
 	{
-		u32_t base = (u32_t)thread->userspace_stack_point;
-		u32_t size = thread->stack_info.size + (thread->stack_info.start - base);
+		u32_t base = (u32_t)thread->cold.userspace_stack_point;
+		u32_t size = thread->cold.stack_info.size + (thread->cold.stack_info.start - base);
 
 		assert_info(region_num < MAX_DYNAMIC_MPU_REGIONS_NUM,
 			"Out-of-bounds error for dynamic region map.");
@@ -219,14 +230,14 @@ void arm_configure_dynamic_mpu_regions(struct ktcb *thread)
 	} 
 	else 
 	{
-		guard_start = thread->stack_info.start - guard_size;
+		guard_start = thread->cold.stack_info.start - guard_size;
 
-		assert_info((u32_t)thread->userspace_stack_point == guard_start,
+		assert_info((u32_t)thread->cold.userspace_stack_point == guard_start,
 		"Guard start (0x%x) not beginning at stack object (0x%x)\n",
-		guard_start, (u32_t)thread->userspace_stack_point);
+		guard_start, (u32_t)thread->cold.userspace_stack_point);
 	}
 #else
-	guard_start = thread->stack_info.start - guard_size;
+	guard_start = thread->cold.stack_info.start - guard_size;
 #endif /* CONFIG_USERSPACE */
 
 	assert_info(region_num < MAX_DYNAMIC_MPU_REGIONS_NUM,
@@ -277,7 +288,7 @@ void arm_core_page_partition_remove(struct thread_page *page_f, u32_t partition_
 	 */
 	partition_attr_t reset_attr = MEM_PARTITION_P_RW_U_NA;
 
-	if (_current_thread->userspace_fpage_table.pagetable_item != page_f)
+	if (_current_thread->cold.userspace_fpage_table.pagetable_item != page_f)
 	{
 		return;
 	}
@@ -294,7 +305,7 @@ void arm_core_page_destroy(struct thread_page *page_f)
 	s32_t i;
 	struct partition partition;
 
-	if (_current_thread->userspace_fpage_table.pagetable_item != page_f) 
+	if (_current_thread->cold.userspace_fpage_table.pagetable_item != page_f) 
 	{
 		return;
 	}
@@ -340,7 +351,7 @@ void arm_core_page_table_remove(struct ktcb *thread)
 		return;
 	}
 
-	arm_core_page_destroy(thread->userspace_fpage_table.pagetable_item);
+	arm_core_page_destroy(thread->cold.userspace_fpage_table.pagetable_item);
 }
 
 s32_t arm_core_buffer_validate(void *addr, size_t size, s32_t write)
@@ -157,7 +157,7 @@ FUNC_NORETURN void arch_user_mode_enter(thread_entry_t user_entry,
 
 	/* Set up privileged stack before entering user mode */
 	_current_thread->arch.priv_stack_start =
-		(word_t)priv_stack_find(_current_thread->userspace_stack_point);
+		(word_t)priv_stack_find(_current_thread->cold.userspace_stack_point);
 #if defined(CONFIG_MPU_STACK_GUARD)
 	/* Stack right area reserved at the bottom of the thread's
 	 * privileged stack. Adjust the available (writable) stack
@@ -172,8 +172,8 @@ FUNC_NORETURN void arch_user_mode_enter(thread_entry_t user_entry,
 #endif
 #endif
 	arm_userspace_enter(user_entry, p1, p2, p3,
-		(word_t)_current_thread->stack_info.start,
-		_current_thread->stack_info.size);
+		(word_t)_current_thread->cold.stack_info.start,
+		_current_thread->cold.stack_info.size);
 	CODE_UNREACHABLE;
 }
 
@@ -242,13 +242,13 @@ void configure_builtin_stack_guard(struct ktcb *thread)
 	word_t guard_start =
 		((thread->arch.priv_stack_start) && (__get_PSP() >= thread->arch.priv_stack_start)) ?
 		(word_t)thread->arch.priv_stack_start :
-		(word_t)thread->userspace_stack_point;
+		(word_t)thread->cold.userspace_stack_point;
 
-	assert_info(thread->stack_info.start == ((word_t)thread->userspace_stack_point),
+	assert_info(thread->cold.stack_info.start == ((word_t)thread->cold.userspace_stack_point),
 		"stack_info.start does not point to the start of the"
 		"thread allocated area.");
 #else
-	word_t guard_start = thread->stack_info.start;
+	word_t guard_start = thread->cold.stack_info.start;
 #endif
 #if defined(CONFIG_CPU_CORTEX_M_HAS_SPLIM)
 	__set_PSPLIM(guard_start);
@@ -335,29 +335,29 @@ word_t checktcb_stack_fail(const word_t fault_addr, const word_t psp)
 		}
 		else
 		{
-			if (psp < (word_t)thread->userspace_stack_point) 
+			if (psp < (word_t)thread->cold.userspace_stack_point) 
 			{
 				/* Thread's user stack corruption */
-				return (word_t)thread->userspace_stack_point;
+				return (word_t)thread->cold.userspace_stack_point;
 			}
 		}
 	}
 	else 
 	{
 		/* Supervisor thread */
-		if (IS_MPU_GUARD_VIOLATION(thread->stack_info.start - guard_len,
+		if (IS_MPU_GUARD_VIOLATION(thread->cold.stack_info.start - guard_len,
 				guard_len, fault_addr, psp)) 
 		{
 			/* Supervisor thread stack corruption */
-			return thread->stack_info.start;
+			return thread->cold.stack_info.start;
 		}
 	}
 #else /* CONFIG_USERSPACE */
-	if (IS_MPU_GUARD_VIOLATION(thread->stack_info.start - guard_len,
+	if (IS_MPU_GUARD_VIOLATION(thread->cold.stack_info.start - guard_len,
 		guard_len, fault_addr, psp))
 	{
 		/* Thread stack corruption */
-		return thread->stack_info.start;
+		return thread->cold.stack_info.start;
 	}
 #endif
 
@@ -8,6 +8,7 @@
 #include <linker/sections.h>
 #include <arch/irq.h>
 #include <arch/cpu.h>
+#include <kernel_object.h>
 
 
 /* These values are not included in the resulting binary, but instead form the
@@ -46,3 +47,9 @@ struct isr_table_entry __sw_isr_table sw_isr_table[IRQ_TABLE_SIZE] = {
 	[0 ...(IRQ_TABLE_SIZE - 1)] = {(void *)0x42, (void *)&irq_spurious},
 };
 #endif
+
+#ifdef CONFIG_GEN_IRQ_OBJECT_TABLE
+struct interrupt irq_object_table[IRQ_TABLE_SIZE] = {
+	[0 ...(IRQ_TABLE_SIZE - 1)] = {NULL, NULL, 0, 0, 0},
+};
+#endif
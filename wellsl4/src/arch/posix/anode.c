@@ -0,0 +1,61 @@
+/**
+ * @file
+ * @brief Memory access of the POSIX (host) arch
+ *
+ * There is no MPU on the host, every thread already reaches all memory.
+ * Mapping succeeds without doing anything and every buffer is valid, so
+ * IPC of map, grant and string items runs its portable part only.
+ */
+
+#include <types_def.h>
+#include <object/tcb.h>
+#include <object/anode.h>
+#include <arch/thread.h>
+#include <api/errno.h>
+
+exception_t do_guard_page(struct ktcb *s_thread,
+	struct ktcb *d_thread,
+	word_t addr,
+	word_t len,
+	word_t right)
+{
+	return EXCEPTION_NONE;
+}
+
+exception_t do_map_page(struct ktcb *thread,
+	word_t addr,
+	word_t len,
+	word_t right)
+{
+	return EXCEPTION_NONE;
+}
+
+exception_t do_map_string(struct ktcb *thread,
+	word_t len,
+	word_t ptr)
+{
+	return EXCEPTION_NONE;
+}
+
+exception_t do_unmap_page(struct ktcb *thread)
+{
+	return EXCEPTION_NONE;
+}
+
+s32_t arm_core_buffer_validate(void *addr, size_t size, s32_t write)
+{
+	return 0;
+}
+
+size_t arch_user_string_nlen(const char *s, size_t maxsize, s32_t *err)
+{
+	size_t len = 0;
+
+	while (len < maxsize && s[len] != '\0')
+	{
+		len++;
+	}
+
+	*err = 0;
+	return len;
+}
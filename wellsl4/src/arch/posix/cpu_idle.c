@@ -0,0 +1,39 @@
+#include <arch/cpu.h>
+#include <kernel/time.h>
+#if defined(CONFIG_NATIVE_POSIX_TIMER)
+#include <drivers/timer/native_posix_timer.h>
+#endif
+
+/* Waiting for the next interrupt means waiting for the next timeout,
+ * the only interrupt that comes by itself. Simulated time jumps there
+ * instead of the host sleeping.
+ */
+static void posix_wait_for_interrupt(void)
+{
+#if defined(CONFIG_NATIVE_POSIX_TIMER)
+	native_posix_timer_advance(native_posix_timer_pending());
+#endif
+}
+
+void arch_cpu_idle(void)
+{
+	arch_irq_unlock(0);
+	posix_wait_for_interrupt();
+}
+
+void arch_cpu_atomic_idle(word_t key)
+{
+	arch_irq_unlock(key);
+	posix_wait_for_interrupt();
+}
+
+/* A busy wait lets the same span of simulated time pass */
+void arch_busy_wait(u32_t usec_to_wait)
+{
+#if defined(CONFIG_NATIVE_POSIX_TIMER)
+	native_posix_timer_advance((u64_t)usec_to_wait *
+		sys_clock_hw_cycles_per_sec() / USEC_PER_SEC);
+#else
+	ARG_UNUSED(usec_to_wait);
+#endif
+}
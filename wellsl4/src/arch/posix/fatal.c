@@ -0,0 +1,10 @@
+#include <types_def.h>
+#include <sys/assert.h>
+#include <arch/posix/posix_host.h>
+
+/* The host process is the whole system, a failed assertion ends it with
+ * a non-zero exit status, which is what the test runner looks for. */
+void assert_post_action(void)
+{
+	posix_print_error_and_exit("assertion failed, exiting\n");
+}
@@ -0,0 +1,80 @@
+/**
+ * @file
+ * @brief POSIX (host) interrupt management
+ *
+ * A table of handlers and enable bits stands in for the interrupt
+ * controller. Nothing asserts a line by itself, posix_irq_raise() runs
+ * the handler from the caller's context.
+ */
+
+#include <arch/cpu.h>
+#include <arch/irq.h>
+#include <sys/assert.h>
+#include <toolchain.h>
+
+struct posix_irq_entry {
+	void (*isr)(generptr_t arg);
+	generptr_t arg;
+	bool_t enabled;
+};
+
+static struct posix_irq_entry posix_irq_table[CONFIG_NUM_IRQS];
+
+word_t posix_irq_locked;
+word_t posix_irq_nest;
+
+/* A raised line is handled before posix_irq_raise() returns, so none is
+ * ever left pending */
+word_t arch_is_irq_pending(void)
+{
+	return CONFIG_NUM_IRQS;
+}
+
+void arch_irq_enable(word_t irq)
+{
+	assert(irq < CONFIG_NUM_IRQS);
+	posix_irq_table[irq].enabled = true;
+}
+
+void arch_irq_disable(word_t irq)
+{
+	assert(irq < CONFIG_NUM_IRQS);
+	posix_irq_table[irq].enabled = false;
+}
+
+sword_t arch_irq_is_enabled(word_t irq)
+{
+	assert(irq < CONFIG_NUM_IRQS);
+	return posix_irq_table[irq].enabled;
+}
+
+void posix_irq_connect(word_t irq, void (*isr)(generptr_t), generptr_t arg)
+{
+	assert(irq < CONFIG_NUM_IRQS);
+	posix_irq_table[irq].isr = isr;
+	posix_irq_table[irq].arg = arg;
+}
+
+/* A line that is disabled or has no handler drops the request, there is
+ * no pending state */
+void posix_irq_raise(word_t irq)
+{
+	struct posix_irq_entry *entry;
+	word_t key;
+
+	assert(irq < CONFIG_NUM_IRQS);
+	entry = &posix_irq_table[irq];
+
+	if (!entry->enabled || entry->isr == NULL)
+	{
+		return;
+	}
+
+	key = arch_irq_lock();
+	posix_irq_nest++;
+
+	entry->isr(entry->arg);
+
+	posix_irq_nest--;
+	arch_irq_unlock(key);
+}
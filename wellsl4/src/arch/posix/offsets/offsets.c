@@ -0,0 +1,14 @@
+/**
+ * @file
+ * @brief POSIX (host) kernel structure member offset definition file
+ *
+ * Nothing on the host is written in assembly, only the offsets shared by
+ * every arch are generated so that kernel_offsets.h resolves.
+ */
+
+#include <object/offsets_macro.h>
+#include <object/offsets_kernel.h>
+#include <arch/cpu.h>
+
+GEN_OFFSET_SYM(thread_arch_t, swap_return_value);
+GEN_ABS_SYM_END
@@ -0,0 +1,98 @@
+/**
+ * @file
+ * @brief Host side of the POSIX arch
+ *
+ * Built against the host C library, not the kernel headers: this is the
+ * real main() of the process, and where kernel output reaches stdout and
+ * stderr.
+ */
+
+/* undo posix_cheats.h, this main() is the host one */
+#undef main
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <arch/posix/posix_host.h>
+
+extern void cstart(void);
+
+static int host_argc;
+static char **host_argv;
+
+int main(int argc, char *argv[])
+{
+	host_argc = argc;
+	host_argv = argv;
+
+	/* the console is line buffered even into a pipe, so the output of a
+	 * run that hangs or crashes is not lost */
+	setvbuf(stdout, NULL, _IOLBF, 0);
+
+	/* does not return, the process ends with the main thread */
+	cstart();
+
+	return 1;
+}
+
+int posix_argc(void)
+{
+	return host_argc;
+}
+
+char **posix_argv(void)
+{
+	return host_argv;
+}
+
+int posix_putchar(int c)
+{
+	return putchar(c);
+}
+
+void posix_exit(int exit_code)
+{
+	fflush(stdout);
+	exit(exit_code);
+}
+
+unsigned long long posix_host_time_ns(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (unsigned long long)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+void posix_print_error_and_exit(const char *format, ...)
+{
+	va_list vargs;
+
+	fflush(stdout);
+	va_start(vargs, format);
+	vfprintf(stderr, format, vargs);
+	va_end(vargs);
+
+	exit(1);
+}
+
+void posix_print_warning(const char *format, ...)
+{
+	va_list vargs;
+
+	va_start(vargs, format);
+	vfprintf(stderr, format, vargs);
+	va_end(vargs);
+}
+
+void posix_print_trace(const char *format, ...)
+{
+	va_list vargs;
+
+	va_start(vargs, format);
+	vfprintf(stdout, format, vargs);
+	va_end(vargs);
+}
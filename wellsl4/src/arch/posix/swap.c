@@ -0,0 +1,18 @@
+#include <types_def.h>
+#include <state/statedata.h>
+#include <arch/cpu.h>
+#include <sys/errno.h>
+
+/* The host has one context only, nothing is switched here: the thread
+ * schedule() made current carries on in the caller. As on ARM the
+ * result is -EAGAIN unless the kernel gave the thread another one by
+ * the time it runs again, which on the host is at once.
+ */
+sword_t arch_swap(word_t key)
+{
+	_current_thread->arch.swap_return_value = -EAGAIN;
+
+	arch_irq_unlock(key);
+
+	return _current_thread->arch.swap_return_value;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file
+ * @brief New thread creation for the POSIX (host) arch
+ *
+ * No thread of its own is ever run on the host: a new thread only gets
+ * its control block initialised, so the scheduler and IPC code can work
+ * on it. The entry point is kept for a debugger to look at.
+ */
+
+#include <types_def.h>
+#include <kernel/thread.h>
+#include <kernel/stack.h>
+#include <object/tcb.h>
+#include <arch/thread.h>
+#include <arch/cpu.h>
+#include <state/statedata.h>
+#include <arch/posix/posix_host.h>
+
+#define STACK_ROUND_DOWN(x) ROUND_DOWN(x, THREAD_STACK_ALIGN_SIZE)
+
+void arch_new_thread(struct ktcb *thread, struct thread_stack *stack,
+	size_t stack_size, thread_entry_t entry_ptr, void *para1, void *para2,
+	void *para3, word_t options)
+{
+	char *stack_start = THREAD_STACK_BUFFER(stack);
+
+	ARG_UNUSED(para1);
+	ARG_UNUSED(para2);
+	ARG_UNUSED(para3);
+
+	thread_init(thread, (s8_t *)stack_start, stack_size, options);
+
+	thread->callee_saved.psp = (u64_t)(uintptr_t)STACK_ROUND_DOWN(stack_start + stack_size);
+	thread->callee_saved.pc = (u64_t)(uintptr_t)entry_ptr;
+	thread->arch.swap_return_value = 0;
+}
+
+void arch_thread_swap_retval_set(struct ktcb *thread, u32_t value)
+{
+	thread->arch.swap_return_value = value;
+}
+
+/* The main thread runs on the host stack the process started on, and
+ * the process ends with it. */
+void arch_switch_to_main_thread(struct ktcb *_main_thread,
+	struct thread_stack *_main_stack,
+	size_t _main_stack_size,
+	thread_entry_t _main)
+{
+	ARG_UNUSED(_main_stack);
+	ARG_UNUSED(_main_stack_size);
+
+	_current_thread = _main_thread;
+
+	arch_irq_unlock(0);
+	_main(NULL, NULL, NULL);
+
+	posix_exit(0);
+}
@@ -0,0 +1,36 @@
+/**
+ * @file
+ * @brief POSIX (host) thread_abort() routine
+ *
+ * As on Cortex-M, but there is no handler mode to leave and no context
+ * to switch to: a thread aborting itself is taken off the scheduler and
+ * the caller carries on as whatever thread the scheduler picked.
+ */
+
+#include <kernel/thread.h>
+#include <object/tcb.h>
+#include <toolchain.h>
+#include <sys/assert.h>
+#include <arch/irq.h>
+#include <state/statedata.h>
+
+
+extern void thread_single_abort(struct ktcb *thread);
+
+void thread_abort(struct ktcb *thread)
+{
+	word_t key;
+
+	key = irq_lock();
+
+	assert_info(!(thread->base.option & option_essential_option),
+		"essential thread aborted");
+
+	thread_single_abort(thread);
+#if defined(CONFIG_THREAD_MONITOR)
+	thread_foreach_exit(thread);
+#endif
+
+	/* The abort handler might have altered the ready queue. */
+	reschedule_irqlock(key);
+}
@@ -0,0 +1,19 @@
+#ifdef CONFIG_BENCHMARK_CYCLES
+
+#include <benchmark/cycles.h>
+#include <device.h>
+
+/* one start of CYCCNT for every user of benchmark_cycles() */
+static s32_t benchmark_cycles_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+#if defined(CONFIG_CPU_CORTEX_M_HAS_DWT)
+	(void)arm_dwt_cycle_count_enable();
+#endif
+	return 0;
+}
+
+SYS_INIT(benchmark_cycles_init, pre_kernel_1, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#endif
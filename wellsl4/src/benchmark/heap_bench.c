@@ -0,0 +1,237 @@
+#include <types_def.h>
+#include <device.h>
+#include <kernel_object.h>
+#include <kernel/time.h>
+#include <object/objecttype.h>
+#include <sys/mempool.h>
+#include <sys/tlsf.h>
+#include <sys/printk.h>
+#include <sys/util.h>
+#include <sys/string.h>
+
+/* both pools get the same buffer size, the buddy one also needs its level bitmaps */
+#define BENCH_POOL_MAX_SIZE 	1024
+#define BENCH_POOL_MIN_SIZE 	16
+#define BENCH_POOL_NUMBER 		8
+#define BENCH_POOL_BYTES 		(BENCH_POOL_MAX_SIZE * BENCH_POOL_NUMBER)
+
+#define BENCH_LIVE_SLOTS 		32
+#define BENCH_ROUNDS 			CONFIG_HEAP_MEM_POOL_BENCHMARK_ROUNDS
+
+static char __aligned(TLSF_ALIGN) buddy_buf[BENCH_POOL_BYTES
+	+ _MPOOL_BITS_SIZE(BENCH_POOL_MAX_SIZE, BENCH_POOL_MIN_SIZE, BENCH_POOL_NUMBER)];
+static struct sys_mem_pool_lvl buddy_lvls[MPOOL_LVLS(BENCH_POOL_MAX_SIZE, BENCH_POOL_MIN_SIZE)];
+static struct sys_mem_pool_base buddy_pool = {
+	.buf = buddy_buf,
+	.max_sz = BENCH_POOL_MAX_SIZE,
+	.n_max = BENCH_POOL_NUMBER,
+	.n_levels = MPOOL_LVLS(BENCH_POOL_MAX_SIZE, BENCH_POOL_MIN_SIZE),
+	.levels = buddy_lvls,
+	.flag = SYS_MEM_POOL_KERNEL
+};
+
+static char __aligned(TLSF_ALIGN) tlsf_buf[BENCH_POOL_BYTES];
+static struct sys_tlsf_pool tlsf_pool = {
+	.buf = tlsf_buf,
+	.size = BENCH_POOL_BYTES,
+	.flag = SYS_MEM_POOL_KERNEL
+};
+
+/* what d_object_alloc() actually asks the heap for */
+#define BENCH_OBJECT_SIZE(type) \
+	(WB_UP(sizeof(struct slot_desc)) + sizeof(struct d_object) + sizeof(type))
+
+static const size_t bench_size_mix[] = {
+	BENCH_OBJECT_SIZE(struct ktcb),
+	BENCH_OBJECT_SIZE(struct message),
+	BENCH_OBJECT_SIZE(struct message),
+	BENCH_OBJECT_SIZE(struct notifation),
+	BENCH_OBJECT_SIZE(struct notifation),
+	BENCH_OBJECT_SIZE(struct thread_sched),
+	BENCH_OBJECT_SIZE(struct timer_event),
+	BENCH_OBJECT_SIZE(struct timer_event),
+	BENCH_OBJECT_SIZE(struct timer_event),
+	BENCH_OBJECT_SIZE(struct interrupt),
+	BENCH_OBJECT_SIZE(struct pager_context),
+	BENCH_OBJECT_SIZE(dschedule_t),
+};
+
+struct bench_slot {
+	void *data;
+	u32_t level;
+	u32_t block;
+	size_t size;
+};
+
+struct bench_result {
+	u32_t alloc_min;
+	u32_t alloc_max;
+	u64_t alloc_total;
+	u32_t free_min;
+	u32_t free_max;
+	u64_t free_total;
+	u32_t allocs;
+	u32_t frees;
+	u32_t failures;
+	size_t requested;	/* bytes live at the end */
+	size_t consumed;	/* bytes the allocator reserved for them */
+};
+
+typedef sword_t (*bench_alloc_t)(void *pool, size_t size, u32_t *level_p,
+	u32_t *block_p, void **data_p);
+typedef void (*bench_free_t)(void *pool, u32_t level, u32_t block);
+typedef void (*bench_sample_t)(void *pool);
+
+static struct bench_slot bench_slots[BENCH_LIVE_SLOTS];
+
+static sword_t buddy_alloc(void *pool, size_t size, u32_t *level_p,
+	u32_t *block_p, void **data_p)
+{
+	return sys_mem_pool_block_alloc(pool, size, level_p, block_p, data_p);
+}
+
+static void buddy_free(void *pool, u32_t level, u32_t block)
+{
+	sys_mem_pool_block_free(pool, level, block);
+}
+
+static sword_t tlsf_alloc(void *pool, size_t size, u32_t *level_p,
+	u32_t *block_p, void **data_p)
+{
+	return sys_tlsf_block_alloc(pool, size, level_p, block_p, data_p);
+}
+
+static void tlsf_free(void *pool, u32_t level, u32_t block)
+{
+	sys_tlsf_block_free(pool, level, block);
+}
+
+/* the pool as it was when the most bytes were live */
+static struct sys_tlsf_stats tlsf_peak;
+
+static void tlsf_sample(void *pool)
+{
+	sys_tlsf_pool_stats_get(pool, &tlsf_peak);
+}
+
+static void bench_record(u32_t cycles, u32_t *min, u32_t *max, u64_t *total)
+{
+	*min = MIN(*min, cycles);
+	*max = MAX(*max, cycles);
+	*total += cycles;
+}
+
+/* Same pseudo random sequence for both allocators. sample is called,
+ * outside the timed calls, each time the live bytes reach a new peak,
+ * once everything is freed the pool says nothing about fragmentation. */
+static void bench_run(void *pool, bench_alloc_t alloc, bench_free_t release,
+	size_t (*block_bytes)(struct bench_slot *), bench_sample_t sample,
+	struct bench_result *res)
+{
+	u32_t seed = 0x2545f491u;
+	u32_t round, index, start, cycles;
+	size_t live = 0, peak = 0;
+	struct bench_slot *slot;
+
+	(void)memset(res, 0, sizeof(*res));
+	(void)memset(bench_slots, 0, sizeof(bench_slots));
+	res->alloc_min = UINT32_MAX;
+	res->free_min = UINT32_MAX;
+
+	for (round = 0; round < BENCH_ROUNDS; round++)
+	{
+		seed = seed * 1103515245u + 12345u;
+		slot = &bench_slots[(seed >> 16) % BENCH_LIVE_SLOTS];
+
+		if (slot->data)
+		{
+			start = get_cycle_32();
+			release(pool, slot->level, slot->block);
+			cycles = get_cycle_32() - start;
+
+			bench_record(cycles, &res->free_min, &res->free_max, &res->free_total);
+			res->frees++;
+			live -= slot->size;
+			slot->data = NULL;
+			continue;
+		}
+
+		index = (seed >> 8) % ARRAY_SIZE(bench_size_mix);
+		slot->size = bench_size_mix[index];
+
+		start = get_cycle_32();
+		if (alloc(pool, slot->size, &slot->level, &slot->block, &slot->data) != 0)
+		{
+			res->failures++;
+			slot->data = NULL;
+			continue;
+		}
+		cycles = get_cycle_32() - start;
+
+		bench_record(cycles, &res->alloc_min, &res->alloc_max, &res->alloc_total);
+		res->allocs++;
+
+		live += slot->size;
+		if (sample && live > peak)
+		{
+			peak = live;
+			sample(pool);
+		}
+	}
+
+	for (index = 0; index < BENCH_LIVE_SLOTS; index++)
+	{
+		slot = &bench_slots[index];
+		if (slot->data)
+		{
+			res->requested += slot->size;
+			res->consumed += block_bytes(slot);
+			release(pool, slot->level, slot->block);
+			slot->data = NULL;
+		}
+	}
+}
+
+static size_t buddy_block_bytes(struct bench_slot *slot)
+{
+	return BENCH_POOL_MAX_SIZE >> (2 * slot->level);
+}
+
+static size_t tlsf_block_bytes(struct bench_slot *slot)
+{
+	return ROUND_UP(slot->size, TLSF_ALIGN) + 2 * sizeof(word_t);
+}
+
+static void bench_report(const char *name, struct bench_result *res)
+{
+	printk("heap %s: alloc min %u max %u avg %u, free min %u max %u avg %u cycles\n",
+		name, res->alloc_min, res->alloc_max,
+		res->allocs ? (u32_t)(res->alloc_total / res->allocs) : 0,
+		res->free_min, res->free_max,
+		res->frees ? (u32_t)(res->free_total / res->frees) : 0);
+	printk("heap %s: %u allocs %u frees %u failures, %u bytes live use %u bytes\n",
+		name, res->allocs, res->frees, res->failures,
+		(u32_t)res->requested, (u32_t)res->consumed);
+}
+
+static sword_t init_heap_benchmark_module(struct device *dev)
+{
+	struct bench_result res;
+
+	ARG_UNUSED(dev);
+
+	sys_mem_pool_base_init(&buddy_pool);
+	bench_run(&buddy_pool, buddy_alloc, buddy_free, buddy_block_bytes, NULL, &res);
+	bench_report("buddy", &res);
+
+	sys_tlsf_pool_init(&tlsf_pool);
+	bench_run(&tlsf_pool, tlsf_alloc, tlsf_free, tlsf_block_bytes, tlsf_sample, &res);
+	bench_report("tlsf", &res);
+
+	printk("heap tlsf: at peak %u bytes used, %u free blocks, fragmentation %u%%\n",
+		(u32_t)tlsf_peak.used_bytes, tlsf_peak.free_blocks, tlsf_peak.fragmentation);
+
+	return 0;
+}
+
+SYS_INIT(init_heap_benchmark_module, post_kernel, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -0,0 +1,177 @@
+#ifdef CONFIG_IRQ_LATENCY_STATS
+
+#include <benchmark/irq_stats.h>
+#include <state/statedata.h>
+#include <kernel/time.h>
+#include <sys/printk.h>
+#include <sys/string.h>
+#include <benchmark/cycles.h>
+#include <api/syscall.h>
+#include <kernel/thread.h>
+
+/* Every cpu only writes its own slots, and every interval of an IRQ has a
+ * single writer on that cpu (the ISR of that IRQ, or PendSV for the
+ * wakeup interval), so recording takes no lock. Dumping reads the slots
+ * racily, a sample may be torn between count and sum. */
+struct irq_stats_cpu {
+	u32_t entry_cycle[CONFIG_NUM_IRQS];
+	struct irq_stats irq[CONFIG_NUM_IRQS];
+};
+
+static struct irq_stats_cpu irq_stats_cpus[CONFIG_MP_NUM_CPUS];
+
+static FORCE_INLINE struct irq_stats_cpu *irq_stats_this_cpu(void)
+{
+	return &irq_stats_cpus[_current_cpu_index];
+}
+
+static FORCE_INLINE bool_t irq_stats_is_vaild(int32_t num)
+{
+	return num >= 0 && num < CONFIG_NUM_IRQS;
+}
+
+static void irq_stats_record(struct irq_stats_hist *hist, u32_t cycles)
+{
+	word_t idx = benchmark_cycles_bucket(cycles);
+
+	if (idx >= IRQ_STATS_BUCKETS)
+	{
+		idx = IRQ_STATS_BUCKETS - 1;
+	}
+
+	if (hist->count == 0 || cycles < hist->min)
+	{
+		hist->min = cycles;
+	}
+	if (cycles > hist->max)
+	{
+		hist->max = cycles;
+	}
+
+	hist->sum += cycles;
+	hist->count++;
+
+	if (hist->bucket[idx] != UINT16_MAX)
+	{
+		hist->bucket[idx]++;
+	}
+}
+
+void irq_stats_isr_enter(int32_t num)
+{
+	if (irq_stats_is_vaild(num))
+	{
+		irq_stats_this_cpu()->entry_cycle[num] = benchmark_cycles();
+	}
+}
+
+void irq_stats_isr_exit(int32_t num)
+{
+	if (irq_stats_is_vaild(num))
+	{
+		struct irq_stats_cpu *cpu = irq_stats_this_cpu();
+
+		irq_stats_record(&cpu->irq[num].interval[irq_stats_isr_duration],
+			benchmark_cycles() - cpu->entry_cycle[num]);
+	}
+}
+
+/* the hardware does not timestamp the assertion; a driver that latches
+ * the event time (input capture, a timer compare value) reports it here
+ * from its ISR */
+void irq_stats_asserted(int32_t num, u32_t assert_cycle)
+{
+	if (irq_stats_is_vaild(num))
+	{
+		struct irq_stats_cpu *cpu = irq_stats_this_cpu();
+
+		irq_stats_record(&cpu->irq[num].interval[irq_stats_entry_latency],
+			cpu->entry_cycle[num] - assert_cycle);
+	}
+}
+
+void irq_stats_thread_woken(int32_t num, struct ktcb *thread)
+{
+	if (irq_stats_is_vaild(num) && thread)
+	{
+		thread->cold.irq_wake_num = num + 1;
+		thread->cold.irq_wake_cycle = irq_stats_this_cpu()->entry_cycle[num];
+	}
+}
+
+/* called by arm_pendsv once the new thread is current */
+void irq_stats_thread_switched_in(void)
+{
+	struct ktcb *thread = _current_thread;
+	int32_t num = thread->cold.irq_wake_num - 1;
+
+	if (irq_stats_is_vaild(num))
+	{
+		thread->cold.irq_wake_num = 0;
+		irq_stats_record(&irq_stats_this_cpu()->irq[num].interval[irq_stats_wakeup_latency],
+			benchmark_cycles() - thread->cold.irq_wake_cycle);
+	}
+}
+
+static const char *const irq_stats_interval_str[irq_stats_interval_number] = {
+	"entry", "wakeup", "isr"
+};
+
+void irq_stats_dump(bool_t reset)
+{
+	for (word_t cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++)
+	{
+		for (int32_t num = 0; num < CONFIG_NUM_IRQS; num++)
+		{
+			struct irq_stats *stats = &irq_stats_cpus[cpu].irq[num];
+
+			for (word_t it = 0; it < irq_stats_interval_number; it++)
+			{
+				struct irq_stats_hist *hist = &stats->interval[it];
+
+				if (hist->count == 0)
+				{
+					continue;
+				}
+
+				printk("cpu %u irq %d %s: n %u min %u max %u mean %u\n", 
+					(u32_t)cpu, num, irq_stats_interval_str[it], hist->count, 
+					hist->min, hist->max, (u32_t)(hist->sum / hist->count));
+
+				for (word_t b = 0; b < IRQ_STATS_BUCKETS; b++)
+				{
+					if (hist->bucket[b])
+					{
+						printk("  < 2^%u: %u\n", (u32_t)(b + 1), hist->bucket[b]);
+					}
+				}
+			}
+
+			if (reset)
+			{
+				(void)memset(stats, 0, sizeof(*stats));
+			}
+		}
+	}
+}
+
+exception_t syscall_irq_stats_print(word_t reset)
+{
+	bool_t is_sufficient = false;
+	
+	update_timestamp(false);
+	is_sufficient = check_budget_restart();
+
+	if (is_sufficient)
+	{
+		irq_stats_dump(reset != 0);
+	
+		schedule();
+		/* reschedule_unlocked(); */
+		return EXCEPTION_NONE;
+	}
+
+	return EXCEPTION_FAULT;
+}
+
+#endif
@@ -0,0 +1,143 @@
+#ifdef CONFIG_PROFILER
+
+#include <benchmark/profile.h>
+#include <state/statedata.h>
+#include <kernel/thread.h>
+#include <sys/printk.h>
+#include <device.h>
+#include <api/syscall.h>
+#include <api/errno.h>
+
+BUILD_ASSERT_MSG((PROFILE_BUFFER_SAMPLES & (PROFILE_BUFFER_SAMPLES - 1)) == 0,
+	"CONFIG_PROFILER_BUFFER_SAMPLES must be a power of two");
+
+struct profile_buffer profile_buffers[CONFIG_MP_NUM_CPUS];
+
+void profile_sample(uintptr_t pc, uintptr_t lr, u32_t flags)
+{
+	struct profile_buffer *buffer = &profile_buffers[_current_cpu_index];
+	struct profile_sample *sample = &buffer->sample[buffer->head & (PROFILE_BUFFER_SAMPLES - 1)];
+	struct ktcb *thread = _current_thread;
+
+	sample->pc = pc;
+	sample->lr = lr;
+	sample->thread_id = thread ? (u32_t)thread->thread_id : 0;
+	sample->flags = flags;
+
+	buffer->head++;
+}
+
+static void profile_set_frequency(u32_t frequency)
+{
+	for (word_t cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++)
+	{
+		profile_buffers[cpu].frequency = frequency;
+	}
+
+	if (frequency)
+	{
+		profile_timer_start(frequency);
+	}
+	else
+	{
+		profile_timer_stop();
+	}
+}
+
+/* One "PROF s" line per sample, oldest first. Sampling goes on while
+ * printing, a sample overwritten meanwhile is printed in its new state,
+ * which a flat profile does not mind. */
+void profile_dump(bool_t reset)
+{
+	for (word_t cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++)
+	{
+		struct profile_buffer *buffer = &profile_buffers[cpu];
+		u32_t head = buffer->head;
+		u32_t first = head > PROFILE_BUFFER_SAMPLES ? head - PROFILE_BUFFER_SAMPLES : 0;
+
+		printk("PROF buf cpu=%u head=%u samples=%u hz=%u\n",
+			(u32_t)cpu, head, (u32_t)PROFILE_BUFFER_SAMPLES, buffer->frequency);
+
+		for (u32_t idx = first; idx != head; idx++)
+		{
+			struct profile_sample *sample = &buffer->sample[idx & (PROFILE_BUFFER_SAMPLES - 1)];
+
+			printk("PROF s %lx %lx %x %x\n", (unsigned long)sample->pc,
+				(unsigned long)sample->lr, sample->thread_id, sample->flags);
+		}
+
+		if (reset)
+		{
+			buffer->head = 0;
+		}
+	}
+
+	printk("PROF end\n");
+}
+
+exception_t syscall_profile_control(word_t frequency)
+{
+	bool_t is_sufficient = false;
+
+	update_timestamp(false);
+	is_sufficient = check_budget_restart();
+
+	if (is_sufficient)
+	{
+		if (frequency > CONFIG_PROFILER_MAX_FREQUENCY)
+		{
+			user_error("Profile: Invalid frequency.");
+			current_syscall_error_code = TCR_INVAL_PARA;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+
+		profile_set_frequency(frequency);
+
+		schedule();
+		/* reschedule_unlocked(); */
+		return EXCEPTION_NONE;
+	}
+
+	return EXCEPTION_FAULT;
+}
+
+exception_t syscall_profile_print(word_t reset)
+{
+	bool_t is_sufficient = false;
+
+	update_timestamp(false);
+	is_sufficient = check_budget_restart();
+
+	if (is_sufficient)
+	{
+		profile_dump(reset != 0);
+
+		schedule();
+		/* reschedule_unlocked(); */
+		return EXCEPTION_NONE;
+	}
+
+	return EXCEPTION_FAULT;
+}
+
+static s32_t profile_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	for (word_t cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++)
+	{
+		struct profile_buffer *buffer = &profile_buffers[cpu];
+
+		buffer->magic = PROFILE_BUFFER_MAGIC;
+		buffer->sample_size = sizeof(struct profile_sample);
+		buffer->samples = PROFILE_BUFFER_SAMPLES;
+		buffer->cpu = cpu;
+	}
+
+	profile_set_frequency(CONFIG_PROFILER_FREQUENCY);
+	return 0;
+}
+
+SYS_INIT(profile_init, post_kernel, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#endif
@@ -0,0 +1,167 @@
+#ifdef CONFIG_SCHED_LATENCY_STATS
+
+#include <benchmark/sched_stats.h>
+#include <state/statedata.h>
+#include <kernel/time.h>
+#include <sys/printk.h>
+#include <sys/string.h>
+#include <benchmark/cycles.h>
+#include <api/syscall.h>
+#include <api/errno.h>
+#include <kernel/thread.h>
+
+/* Every cpu only writes its own slots. schedule() also runs from ISRs
+ * (the deadline handler), so a sample taken there can interleave with
+ * one taken in thread mode on the same cpu and a count may be off by
+ * one; reading is racy the same way. */
+struct sched_stats_cpu {
+	u32_t swap_start;
+	bool_t swap_pending;
+	struct sched_stats_hist interval[sched_stats_interval_number];
+};
+
+static struct sched_stats_cpu sched_stats_cpus[CONFIG_MP_NUM_CPUS];
+
+static FORCE_INLINE struct sched_stats_cpu *sched_stats_this_cpu(void)
+{
+	return &sched_stats_cpus[_current_cpu_index];
+}
+
+static void sched_stats_hist_record(struct sched_stats_hist *hist, u32_t cycles)
+{
+	word_t idx = benchmark_cycles_bucket(cycles);
+
+	if (hist->count == 0 || cycles < hist->min)
+	{
+		hist->min = cycles;
+	}
+	if (cycles > hist->max)
+	{
+		hist->max = cycles;
+	}
+
+	hist->sum += cycles;
+	hist->count++;
+	hist->bucket[idx]++;
+}
+
+u32_t sched_stats_cycle(void)
+{
+	return benchmark_cycles();
+}
+
+void sched_stats_record(enum sched_stats_interval interval, u32_t start)
+{
+	u32_t cycles = benchmark_cycles() - start;
+
+	sched_stats_hist_record(&sched_stats_this_cpu()->interval[interval], cycles);
+}
+
+/* called by read_timer_start_of_swap, only cooperative swaps go through it */
+void sched_stats_swap_start(void)
+{
+	struct sched_stats_cpu *cpu = sched_stats_this_cpu();
+
+	cpu->swap_start = benchmark_cycles();
+	cpu->swap_pending = TRUE;
+}
+
+/* called by read_timer_end_of_swap once the new thread is current, a
+ * switch out of an ISR has no start and is not counted */
+void sched_stats_swap_end(void)
+{
+	struct sched_stats_cpu *cpu = sched_stats_this_cpu();
+
+	if (cpu->swap_pending)
+	{
+		cpu->swap_pending = FALSE;
+		sched_stats_hist_record(&cpu->interval[sched_stats_swap],
+			benchmark_cycles() - cpu->swap_start);
+	}
+}
+
+static void sched_stats_merge(struct sched_stats_hist *to,
+	const struct sched_stats_hist *from)
+{
+	if (from->count == 0)
+	{
+		return;
+	}
+
+	if (to->count == 0 || from->min < to->min)
+	{
+		to->min = from->min;
+	}
+	if (from->max > to->max)
+	{
+		to->max = from->max;
+	}
+
+	to->count += from->count;
+	to->sum += from->sum;
+
+	for (word_t b = 0; b < SCHED_STATS_BUCKETS; b++)
+	{
+		to->bucket[b] += from->bucket[b];
+	}
+}
+
+/* the interval summed over every cpu, optionally cleared afterwards */
+exception_t syscall_sched_stats_read(word_t interval,
+	struct sched_stats_hist *hist, word_t reset)
+{
+	bool_t is_sufficient = false;
+
+	update_timestamp(false);
+	is_sufficient = check_budget_restart();
+
+	if (is_sufficient)
+	{
+		struct sched_stats_hist sum;
+
+		if (interval >= sched_stats_interval_number || !hist)
+		{
+			user_error("Sched Stats: Invalid interval or histogram.");
+			current_syscall_error_code = TCR_INVAL_PARA;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+
+#if defined(CONFIG_USERSPACE)
+		if (SYSCALL_MEMORY_WRITE(hist, sizeof(*hist)))
+		{
+			user_error("Sched Stats: Illegal operation attempted.");
+			current_syscall_error_code = TCR_INVAL_PARA;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+#endif
+
+		(void)memset(&sum, 0, sizeof(sum));
+		for (word_t cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++)
+		{
+			struct sched_stats_hist *from = &sched_stats_cpus[cpu].interval[interval];
+
+			sched_stats_merge(&sum, from);
+			if (reset)
+			{
+				(void)memset(from, 0, sizeof(*from));
+			}
+		}
+
+		*hist = sum;
+
+		schedule();
+		/* reschedule_unlocked(); */
+		return EXCEPTION_NONE;
+	}
+
+	return EXCEPTION_FAULT;
+}
+
+/* No work, no timestamp and no scheduler pass: the caller times the
+ * trap into the kernel and back. */
+exception_t syscall_sched_stats_null(void)
+{
+	return EXCEPTION_NONE;
+}
+
+#endif
@@ -0,0 +1,342 @@
+#ifdef CONFIG_STACK_USAGE
+
+#include <benchmark/stack_usage.h>
+#include <state/statedata.h>
+#include <kernel/time.h>
+#include <kernel/thread.h>
+#include <object/tcb.h>
+#include <model/spinlock.h>
+#include <sys/printk.h>
+#include <sys/string.h>
+#include <sys/util.h>
+#include <device.h>
+#include <api/syscall.h>
+#include <api/errno.h>
+
+/* what CONFIG_INIT_STACKS fills every stack with */
+#define STACK_USAGE_FILL_BYTE 	0xaa
+#define STACK_USAGE_FILL 		(~(word_t)0 / 0xff * STACK_USAGE_FILL_BYTE)
+
+/* the lowest word of a thread stack is the sentinel, it is never used */
+#if defined(CONFIG_STACK_SENTINEL)
+#define STACK_USAGE_SKIP 		sizeof(word_t)
+#else
+#define STACK_USAGE_SKIP 		0
+#endif
+
+/* Where the scan is. A pass looks at the ISR stacks first and then
+ * follows the monitor list of the threads. Every step looks at no more
+ * than CONFIG_STACK_USAGE_SCAN_BYTES of one stack, from the low end up
+ * to the first word that is not the fill any more, and only as far as
+ * an earlier pass has not already found the stack written. */
+struct stack_usage_scan {
+	bool_t active;
+	word_t isr;
+	struct ktcb *thread;
+	size_t offset;
+	u64_t pass_start;
+};
+
+static struct stack_usage_scan scan;
+static spinlock_t stack_usage_lock;
+
+static size_t isr_unused[CONFIG_MP_NUM_CPUS];
+
+static FORCE_INLINE uintptr_t isr_stack_start(word_t cpu)
+{
+	return (uintptr_t)_kernel.cpus[cpu].int_stack_point - CONFIG_ISR_STACK_SIZE;
+}
+
+/* true once the stack is done with, unused is lowered if it was written */
+static bool_t stack_usage_scan_chunk(uintptr_t start, size_t *unused)
+{
+	size_t end = MIN(scan.offset + CONFIG_STACK_USAGE_SCAN_BYTES, *unused);
+
+	for (; scan.offset < end; scan.offset += sizeof(word_t))
+	{
+		if (*(word_t *)(start + scan.offset) != STACK_USAGE_FILL)
+		{
+			*unused = scan.offset;
+			return TRUE;
+		}
+	}
+
+	return scan.offset >= *unused;
+}
+
+static void stack_usage_next_thread(void)
+{
+	scan.thread = scan.thread->cold.monitor_thread_next;
+	scan.offset = STACK_USAGE_SKIP;
+}
+
+static void stack_usage_start(u64_t now)
+{
+	spinlock_key_t key = lock_spin_lock(&stack_usage_lock);
+
+	if (!scan.active)
+	{
+		scan.active = TRUE;
+		scan.isr = 0;
+		scan.thread = _kernel.monitor_thread;
+		scan.offset = 0;
+		scan.pass_start = now;
+	}
+
+	unlock_spin_unlock(&stack_usage_lock, key);
+}
+
+/* one chunk with the lock held, false when the pass is over */
+static bool_t stack_usage_step(void)
+{
+	spinlock_key_t key = lock_spin_lock(&stack_usage_lock);
+	bool_t more;
+
+	if (!scan.active)
+	{
+		more = FALSE;
+	}
+	else if (scan.isr < CONFIG_MP_NUM_CPUS)
+	{
+		if (_kernel.cpus[scan.isr].int_stack_point == NULL ||
+			stack_usage_scan_chunk(isr_stack_start(scan.isr), &isr_unused[scan.isr]))
+		{
+			scan.isr++;
+			scan.offset = (scan.isr < CONFIG_MP_NUM_CPUS) ? 0 : STACK_USAGE_SKIP;
+		}
+		more = TRUE;
+	}
+	else if (scan.thread != NULL)
+	{
+		struct thread_stack_info *info = &scan.thread->cold.stack_info;
+
+		/* the dummy thread has no stack of its own */
+		if (info->start == 0 ||
+			stack_usage_scan_chunk(info->start, &info->unused))
+		{
+			stack_usage_next_thread();
+		}
+		more = TRUE;
+	}
+	else
+	{
+		scan.active = FALSE;
+		more = FALSE;
+	}
+
+	unlock_spin_unlock(&stack_usage_lock, key);
+	return more;
+}
+
+/* Called by the idle thread every time round. Interrupts are only locked
+ * for one chunk, so a thread that becomes ready preempts the scan as it
+ * would preempt idle; the next time idle runs it goes on from there. */
+void stack_usage_idle(void)
+{
+#if CONFIG_STACK_USAGE_INTERVAL_MS > 0
+	u64_t now = get_uptime_64();
+
+	if (!scan.active && now - scan.pass_start >= CONFIG_STACK_USAGE_INTERVAL_MS)
+	{
+		stack_usage_start(now);
+	}
+#endif
+
+	while (stack_usage_step())
+	{
+	}
+}
+
+/* with thread_conf_lock held, before the thread leaves the monitor list
+ * and its stack may be given back */
+void stack_usage_thread_exit(struct ktcb *thread)
+{
+	spinlock_key_t key = lock_spin_lock(&stack_usage_lock);
+
+	if (scan.active && scan.thread == thread)
+	{
+		stack_usage_next_thread();
+	}
+
+	unlock_spin_unlock(&stack_usage_lock, key);
+}
+
+static void stack_usage_get(uintptr_t start, size_t size, size_t unused,
+	struct stack_usage *usage)
+{
+	u32_t used = (u32_t)(size - unused);
+
+	usage->start = start;
+	usage->size = (u32_t)size;
+	usage->unused = (u32_t)unused;
+	usage->recommend = (u32_t)ROUND_UP(used + used * CONFIG_STACK_USAGE_MARGIN / 100U,
+		STACK_USAGE_ALIGN);
+}
+
+static void stack_usage_print_one(const char *name, uintptr_t start,
+	size_t size, size_t unused)
+{
+	struct stack_usage usage;
+
+	stack_usage_get(start, size, unused, &usage);
+	printk("STACK name=%s start=%lx size=%u used=%u recommend=%u\n", name,
+		(unsigned long)usage.start, usage.size, usage.size - usage.unused,
+		usage.recommend);
+}
+
+static void stack_usage_dump_thread(const struct ktcb *thread, void *data)
+{
+	const struct thread_stack_info *info = &thread->cold.stack_info;
+	char name[16];
+
+	ARG_UNUSED(data);
+
+	if (info->start == 0)
+	{
+		return;
+	}
+
+	if (thread == &main_thread)
+	{
+		(void)snprintk(name, sizeof(name), "main");
+	}
+	else if (thread == &privilege_thread)
+	{
+		(void)snprintk(name, sizeof(name), "privilege");
+	}
+	else if (thread == &idle_thread)
+	{
+		(void)snprintk(name, sizeof(name), "idle");
+	}
+	else
+	{
+		(void)snprintk(name, sizeof(name), "thread_%x", (u32_t)thread->thread_id);
+	}
+
+	stack_usage_print_one(name, info->start, info->size, info->unused);
+}
+
+/* One line per stack, in the form tool/scripts/stack_report.py reads.
+ * With rescan a whole pass is made first, by the caller. */
+void stack_usage_dump(bool_t rescan)
+{
+	char name[16];
+
+	if (rescan)
+	{
+		stack_usage_start(get_uptime_64());
+		while (stack_usage_step())
+		{
+		}
+	}
+
+	for (word_t cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++)
+	{
+		if (_kernel.cpus[cpu].int_stack_point == NULL)
+		{
+			continue;
+		}
+
+		(void)snprintk(name, sizeof(name), "isr%u", (u32_t)cpu);
+		stack_usage_print_one(name, isr_stack_start(cpu), CONFIG_ISR_STACK_SIZE,
+			isr_unused[cpu]);
+	}
+
+	thread_foreach(stack_usage_dump_thread, NULL);
+}
+
+/* what the scans found so far, the thread's stack is not looked at again */
+exception_t syscall_stack_usage_read(word_t dest_thread_id,
+	struct stack_usage *usage)
+{
+	bool_t is_sufficient = false;
+
+	update_timestamp(false);
+	is_sufficient = check_budget_restart();
+
+	if (is_sufficient)
+	{
+		struct ktcb *thread = _current_thread;
+		struct thread_stack_info *info;
+
+		if (dest_thread_id != GLOBALID_NILTHREAD)
+		{
+			thread = get_thread(dest_thread_id);
+		}
+
+		if (!thread)
+		{
+			user_error("Stack Usage: Illegal operation parameter.");
+			current_syscall_error_code = TCR_INVAL_THREAD;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+
+		if (!usage)
+		{
+			user_error("Stack Usage: Invalid usage.");
+			current_syscall_error_code = TCR_INVAL_PARA;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+
+#if defined(CONFIG_USERSPACE)
+		if (SYSCALL_MEMORY_WRITE(usage, sizeof(*usage)))
+		{
+			user_error("Stack Usage: Illegal operation attempted.");
+			current_syscall_error_code = TCR_INVAL_PARA;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+#endif
+
+		info = &thread->cold.stack_info;
+		stack_usage_get(info->start, info->size, info->unused, usage);
+
+		schedule();
+		/* reschedule_unlocked(); */
+		return EXCEPTION_NONE;
+	}
+
+	return EXCEPTION_FAULT;
+}
+
+exception_t syscall_stack_usage_print(word_t rescan)
+{
+	bool_t is_sufficient = false;
+
+	update_timestamp(false);
+	is_sufficient = check_budget_restart();
+
+	if (is_sufficient)
+	{
+		stack_usage_dump(rescan != 0);
+
+		schedule();
+		/* reschedule_unlocked(); */
+		return EXCEPTION_NONE;
+	}
+
+	return EXCEPTION_FAULT;
+}
+
+static s32_t stack_usage_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	for (word_t cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++)
+	{
+		/* the boot cpu fills its own at reset, it is running on it now */
+		if (cpu != 0 && _kernel.cpus[cpu].int_stack_point != NULL)
+		{
+			(void)memset((void *)isr_stack_start(cpu), STACK_USAGE_FILL_BYTE,
+				CONFIG_ISR_STACK_SIZE);
+		}
+		isr_unused[cpu] = CONFIG_ISR_STACK_SIZE;
+	}
+
+	return 0;
+}
+
+/* post kernel, when the ISR stacks are known and the other cpus are not
+ * up yet */
+SYS_INIT(stack_usage_init, post_kernel, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#endif
@@ -0,0 +1,274 @@
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+
+#include <benchmark/thread_stats.h>
+#include <state/statedata.h>
+#include <kernel/time.h>
+#include <kernel/thread.h>
+#include <object/tcb.h>
+#include <sys/printk.h>
+#include <sys/string.h>
+#include <api/syscall.h>
+#include <api/errno.h>
+
+#if defined(CONFIG_SYSTEM_CLOCK_CYCLES_64)
+#define THREAD_STATS_CYCLE() 			get_cycle_64()
+#define THREAD_STATS_DELTA(now, then) 	((now) - (then))
+#else
+/* a wait longer than one wrap of the 32 bit counter is undercounted */
+#define THREAD_STATS_CYCLE() 			((u64_t)get_cycle_32())
+#define THREAD_STATS_DELTA(now, then) 	((u64_t)(u32_t)((now) - (then)))
+#endif
+
+/* the thread each cpu last switched in, and when */
+struct thread_stats_cpu {
+	struct ktcb *thread;
+	u64_t switched_in_cycle;
+};
+
+static struct thread_stats_cpu thread_stats_cpus[CONFIG_MP_NUM_CPUS];
+
+/* start of the window the dump reports percentages over */
+static u64_t thread_stats_since;
+
+void thread_stats_init(struct ktcb *thread)
+{
+	(void)memset(&thread->cold.runtime_stats, 0, sizeof(thread->cold.runtime_stats));
+	thread->cold.wait_start_cycle = 0;
+	thread->cold.wait_state = 0;
+	thread->cold.switch_voluntary = FALSE;
+}
+
+/* Called where a thread blocks in send_ipc, receive_ipc or
+ * recevie_signal. That is not always when it is switched out: the
+ * caller of exchange_ipc leaves for the privilege thread first, which
+ * then blocks it.
+ */
+void thread_stats_wait(struct ktcb *thread, word_t state)
+{
+	thread->cold.wait_state = state;
+	thread->cold.wait_start_cycle = THREAD_STATS_CYCLE();
+}
+
+/* Called on every switch with the thread about to run, from
+ * set_current_thread or the arch swap code. The thread switched in last
+ * on this cpu is the one leaving, so no hook is needed on the way out.
+ * Whether it left voluntarily was recorded where it waited or yielded;
+ * a yielding thread is still ready, so its state does not tell. A mark
+ * is only good until the thread runs again, one made while it was not
+ * running (an IPC wait set up by the privilege thread) is dropped here.
+ * A wait ends here too, also when it ended before the thread was
+ * switched out at all.
+ */
+void thread_stats_switched_in(struct ktcb *thread)
+{
+	struct thread_stats_cpu *cpu = &thread_stats_cpus[_current_cpu_index];
+	struct ktcb *prev = cpu->thread;
+	u64_t now = THREAD_STATS_CYCLE();
+
+	if (thread->cold.wait_state & state_send_blocked_state)
+	{
+		thread->cold.runtime_stats.send_wait_cycles +=
+			THREAD_STATS_DELTA(now, thread->cold.wait_start_cycle);
+	}
+	else if (thread->cold.wait_state)
+	{
+		thread->cold.runtime_stats.recv_wait_cycles +=
+			THREAD_STATS_DELTA(now, thread->cold.wait_start_cycle);
+	}
+
+	thread->cold.wait_state = 0;
+	thread->cold.switch_voluntary = FALSE;
+
+	if (prev == thread)
+	{
+		return;
+	}
+
+	if (prev != NULL)
+	{
+		prev->cold.runtime_stats.run_cycles += THREAD_STATS_DELTA(now, cpu->switched_in_cycle);
+
+		if (prev->cold.switch_voluntary)
+		{
+			prev->cold.runtime_stats.voluntary_switches++;
+		}
+		else
+		{
+			prev->cold.runtime_stats.involuntary_switches++;
+		}
+		prev->cold.switch_voluntary = FALSE;
+	}
+
+	thread->cold.runtime_stats.switches_in++;
+
+	cpu->thread = thread;
+	cpu->switched_in_cycle = now;
+}
+
+/* the counters plus the slice the thread is running right now */
+static void thread_stats_get(const struct ktcb *thread, struct thread_stats *stats, u64_t now)
+{
+	*stats = thread->cold.runtime_stats;
+
+	for (word_t cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++)
+	{
+		if (thread_stats_cpus[cpu].thread == thread)
+		{
+			stats->run_cycles += THREAD_STATS_DELTA(now, thread_stats_cpus[cpu].switched_in_cycle);
+		}
+	}
+}
+
+static void thread_stats_reset(struct ktcb *thread, u64_t now)
+{
+	(void)memset(&thread->cold.runtime_stats, 0, sizeof(thread->cold.runtime_stats));
+
+	if (thread->cold.wait_state)
+	{
+		thread->cold.wait_start_cycle = now;
+	}
+
+	for (word_t cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++)
+	{
+		if (thread_stats_cpus[cpu].thread == thread)
+		{
+			thread_stats_cpus[cpu].switched_in_cycle = now;
+		}
+	}
+}
+
+struct thread_stats_dump_ctx {
+	u64_t now;
+	u64_t window;
+	bool_t reset;
+};
+
+/* printk has no 64 bit decimal on 32 bit cpus, print milliseconds */
+static void thread_stats_print_ms(u64_t cycles)
+{
+	u64_t us = cycles * 1000000U / sys_clock_hw_cycles_per_sec();
+
+	printk(" %8u.%03u", (u32_t)(us / 1000U), (u32_t)(us % 1000U));
+}
+
+static void thread_stats_dump_one(const struct ktcb *thread, void *user_data)
+{
+	struct thread_stats_dump_ctx *ctx = user_data;
+	struct thread_stats stats;
+	u32_t permille = 0;
+
+	thread_stats_get(thread, &stats, ctx->now);
+
+	if (ctx->window)
+	{
+		permille = (u32_t)(stats.run_cycles * 1000U / ctx->window);
+	}
+
+	printk("%8x %4u %3u.%u%%", (u32_t)thread->thread_id,
+		(u32_t)thread->base.sched_prior, permille / 10, permille % 10);
+	thread_stats_print_ms(stats.run_cycles);
+	thread_stats_print_ms(stats.send_wait_cycles);
+	thread_stats_print_ms(stats.recv_wait_cycles);
+	printk(" %8u %8u %8u\n", stats.voluntary_switches,
+		stats.involuntary_switches, stats.budget_overruns);
+
+	if (ctx->reset)
+	{
+		thread_stats_reset((struct ktcb *)thread, ctx->now);
+	}
+}
+
+/* One line per thread known to thread_foreach, with its share of the cpu
+ * since boot or the last reset. Times are in milliseconds. */
+void thread_stats_dump(bool_t reset)
+{
+	struct thread_stats_dump_ctx ctx;
+
+	ctx.now = THREAD_STATS_CYCLE();
+	ctx.window = THREAD_STATS_DELTA(ctx.now, thread_stats_since);
+	ctx.reset = reset;
+
+	printk("  thread prio    cpu       run ms  send wait ms  recv wait ms      vol    invol  overrun\n");
+	thread_foreach(thread_stats_dump_one, &ctx);
+
+	if (reset)
+	{
+		thread_stats_since = ctx.now;
+	}
+}
+
+exception_t syscall_thread_stats_read(word_t dest_thread_id,
+	struct thread_stats *stats, word_t reset)
+{
+	bool_t is_sufficient = false;
+
+	update_timestamp(false);
+	is_sufficient = check_budget_restart();
+
+	if (is_sufficient)
+	{
+		struct ktcb *thread = _current_thread;
+		u64_t now = THREAD_STATS_CYCLE();
+
+		if (dest_thread_id != GLOBALID_NILTHREAD)
+		{
+			thread = get_thread(dest_thread_id);
+		}
+
+		if (!thread)
+		{
+			user_error("Thread Stats: Illegal operation parameter.");
+			current_syscall_error_code = TCR_INVAL_THREAD;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+
+		if (!stats)
+		{
+			user_error("Thread Stats: Invalid stats.");
+			current_syscall_error_code = TCR_INVAL_PARA;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+
+#if defined(CONFIG_USERSPACE)
+		if (SYSCALL_MEMORY_WRITE(stats, sizeof(*stats)))
+		{
+			user_error("Thread Stats: Illegal operation attempted.");
+			current_syscall_error_code = TCR_INVAL_PARA;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+#endif
+
+		thread_stats_get(thread, stats, now);
+		if (reset)
+		{
+			thread_stats_reset(thread, now);
+		}
+
+		schedule();
+		/* reschedule_unlocked(); */
+		return EXCEPTION_NONE;
+	}
+
+	return EXCEPTION_FAULT;
+}
+
+exception_t syscall_thread_stats_print(word_t reset)
+{
+	bool_t is_sufficient = false;
+
+	update_timestamp(false);
+	is_sufficient = check_budget_restart();
+
+	if (is_sufficient)
+	{
+		thread_stats_dump(reset != 0);
+
+		schedule();
+		/* reschedule_unlocked(); */
+		return EXCEPTION_NONE;
+	}
+
+	return EXCEPTION_FAULT;
+}
+
+#endif
@@ -2,6 +2,7 @@
 
 #include <state/statedata.h>
 #include <benchmark/timing.h>
+#include <benchmark/sched_stats.h>
 #include <kernel/time.h>
 
 
@@ -71,6 +72,8 @@
 
 void read_timer_start_of_swap(void)
 {
+	sched_stats_swap_start();
+
 	if (arch_timing_value_swap_end == 1U)
 	{
 		TIMING_INFO_PRE_READ();
@@ -80,6 +83,8 @@ void read_timer_start_of_swap(void)
 
 void read_timer_end_of_swap(void)
 {
+	sched_stats_swap_end();
+
 	if (arch_timing_value_swap_end == 1U)
 	{
 		TIMING_INFO_PRE_READ();
@@ -2,141 +2,237 @@
 
 #include <benchmark/trace.h>
 #include <object/tcb.h>
+#include <state/statedata.h>
+#include <kernel/time.h>
+#include <kernel/thread.h>
+#include <sys/printk.h>
+#include <sys/string.h>
+#include <device.h>
+#include <api/syscall.h>
+#include <benchmark/cycles.h>
+
+#if defined(CONFIG_CPU_CORTEX_M)
+#include <arch/arm/aarch32/cortex_m/cmsis.h>
+#endif
 
-void sys_trace_thread_switched_out(void)
+BUILD_ASSERT_MSG((TRACE_RING_RECORDS & (TRACE_RING_RECORDS - 1)) == 0,
+	"CONFIG_TRACING_BUFFER_RECORDS must be a power of two");
+
+struct trace_ring trace_rings[CONFIG_MP_NUM_CPUS];
+
+/* Every cpu only writes its own ring. A writer takes its slot with one
+ * atomic increment of head, so an ISR nesting over a thread (or over a
+ * lower priority ISR) gets the next slot and neither waits. seq is first
+ * set to a value no reader expects and written again last, a reader
+ * drops any slot whose seq does not match the index it looked it up by. */
+static FORCE_INLINE void trace_ring_put(u16_t event, u32_t thread_id, u32_t arg)
 {
-	struct ktcb *thread = _current_thread;
+	struct trace_ring *ring = &trace_rings[_current_cpu_index];
+	u32_t idx = (u32_t)atomic_inc(&ring->head);
+	struct trace_record *rec = &ring->record[idx & (TRACE_RING_RECORDS - 1)];
+
+	rec->seq = (u16_t)(idx ^ 0x8000);
+	compiler_barrier();
+
+	rec->timestamp = benchmark_cycles();
+	rec->thread_id = thread_id;
+	rec->arg = arg;
+	rec->event = event;
 
-	trace_thread_switched_out((u32_t)thread->thread_id);
+	compiler_barrier();
+	rec->seq = (u16_t)idx;
 }
 
-void sys_trace_thread_switched_in(void)
+static FORCE_INLINE u32_t trace_current_id(void)
 {
 	struct ktcb *thread = _current_thread;
 
-	trace_thread_switched_in((u32_t)thread->thread_id);
+	return thread ? (u32_t)thread->thread_id : 0;
 }
 
-void sys_trace_thread_priority_set(struct ktcb *thread)
+void sys_trace_thread_switched_out(void)
 {
-	trace_thread_priority_set((u32_t)thread->thread_id,
-				    thread->base.sched_prior);
+	trace_ring_put(TRACE_EVENT_THREAD_SWITCHED_OUT, trace_current_id(), 0);
 }
 
-void sys_trace_thread_create(struct ktcb *thread)
+void sys_trace_thread_switched_in(void)
 {
-	string_t name = { "Unnamed thread" };
-
-#if defined(CONFIG_THREAD_NAME)
-	const char *tname = thread_get_name(thread);
+	trace_ring_put(TRACE_EVENT_THREAD_SWITCHED_IN, trace_current_id(), 0);
+}
 
-	if (tname != NULL) 
-	{
-		strncpy(name.buf, tname, sizeof(name.buf));
-		/* strncpy may not always null-terminate */
-		name.buf[sizeof(name.buf) - 1] = 0;
-	}
-#endif
+void sys_trace_thread_priority_set(struct ktcb *thread)
+{
+	trace_ring_put(TRACE_EVENT_THREAD_PRIORITY_SET, (u32_t)thread->thread_id,
+		thread->base.sched_prior);
+}
 
-	trace_thread_create(
-		(u32_t)thread->thread_id,
-		thread->base.sched_prior,
-		name
-		);
+void sys_trace_thread_create(struct ktcb *thread)
+{
+	trace_ring_put(TRACE_EVENT_THREAD_CREATE, (u32_t)thread->thread_id,
+		thread->base.sched_prior);
 
-#if defined(CONFIG_THREAD_STACK_INFO)
-	trace_thread_info(
-		(u32_t)thread->thread_id,
-		thread->stack_info.size,
-		thread->stack_info.start
-		);
-#endif
+	sys_trace_thread_info(thread);
 }
 
 void sys_trace_thread_abort(struct ktcb *thread)
 {
-	trace_thread_abort((u32_t)thread->thread_id);
+	trace_ring_put(TRACE_EVENT_THREAD_ABORT, (u32_t)thread->thread_id, 0);
 }
 
 void sys_trace_thread_suspend(struct ktcb *thread)
 {
-	trace_thread_suspend((u32_t)thread->thread_id);
+	trace_ring_put(TRACE_EVENT_THREAD_SUSPEND, (u32_t)thread->thread_id, 0);
 }
 
 void sys_trace_thread_resume(struct ktcb *thread)
 {
-	trace_thread_resume((u32_t)thread->thread_id);
+	trace_ring_put(TRACE_EVENT_THREAD_RESUME, (u32_t)thread->thread_id, 0);
 }
 
 void sys_trace_thread_ready(struct ktcb *thread)
 {
-	trace_thread_ready((u32_t)thread->thread_id);
+	trace_ring_put(TRACE_EVENT_THREAD_READY, (u32_t)thread->thread_id, 0);
 }
 
 void sys_trace_thread_pend(struct ktcb *thread)
 {
-	trace_thread_pend((u32_t)thread->thread_id);
+	trace_ring_put(TRACE_EVENT_THREAD_PENDING, (u32_t)thread->thread_id, 0);
 }
 
 void sys_trace_thread_info(struct ktcb *thread)
 {
 #if defined(CONFIG_THREAD_STACK_INFO)
-	trace_thread_info(
-		(u32_t)thread->thread_id,
-		thread->stack_info.size,
-		thread->stack_info.start
-		);
+	trace_ring_put(TRACE_EVENT_THREAD_INFO, (u32_t)thread->thread_id,
+		thread->cold.stack_info.size);
 #endif
 }
 
+/* the first four bytes of the name go in arg */
 void sys_trace_thread_name_set(struct ktcb *thread)
 {
 #if defined(CONFIG_THREAD_NAME)
-	string_t name = { "Unnamed thread" };
 	const char *tname = thread_get_name(thread);
+	u32_t name = 0;
 
-	if (tname != NULL) 
+	if (tname != NULL)
 	{
-		strncpy(name.buf, tname, sizeof(name.buf));
-		/* strncpy may not always null-terminate */
-		name.buf[sizeof(name.buf) - 1] = 0;
+		strncpy((char *)&name, tname, sizeof(name));
 	}
-	
-	trace_thread_name_set(
-		(u32_t)thread->thread_id,
-		name
-		);
+
+	trace_ring_put(TRACE_EVENT_THREAD_NAME_SET, (u32_t)thread->thread_id, name);
 #endif
 }
 
+/* arg is the exception number where the core tells us cheaply */
 void sys_trace_isr_enter(void)
 {
-	trace_isr_enter();
+#if defined(CONFIG_CPU_CORTEX_M)
+	trace_ring_put(TRACE_EVENT_ISR_ENTER, trace_current_id(), __get_IPSR());
+#else
+	trace_ring_put(TRACE_EVENT_ISR_ENTER, trace_current_id(), 0);
+#endif
 }
 
 void sys_trace_isr_exit(void)
 {
-	trace_isr_exit();
+	trace_ring_put(TRACE_EVENT_ISR_EXIT, trace_current_id(), 0);
 }
 
 void sys_trace_isr_exit_to_scheduler(void)
 {
-	trace_isr_exit_to_scheduler();
+	trace_ring_put(TRACE_EVENT_ISR_EXIT_TO_SCHEDULER, trace_current_id(), 0);
 }
 
 void sys_trace_idle(void)
 {
-	trace_idle();
+	trace_ring_put(TRACE_EVENT_IDLE, trace_current_id(), 0);
 }
 
 void sys_trace_void(u32_t id)
 {
-	trace_void(id);
+	trace_ring_put(TRACE_EVENT_ID_START_CALL, trace_current_id(), id);
 }
 
 void sys_trace_end_call(u32_t id)
 {
-	trace_end_call(id);
+	trace_ring_put(TRACE_EVENT_ID_END_CALL, trace_current_id(), id);
 }
 
+/* One "TRACE rec" line per record, the four words as they lie in memory,
+ * oldest first. Records still being written are skipped, records written
+ * while dumping are left for the next dump. */
+void trace_ring_dump(bool_t reset)
+{
+	for (word_t cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++)
+	{
+		struct trace_ring *ring = &trace_rings[cpu];
+		u32_t head = (u32_t)atomic_get(&ring->head);
+		u32_t first = head > TRACE_RING_RECORDS ? head - TRACE_RING_RECORDS : 0;
+
+		printk("TRACE ring cpu=%u head=%u records=%u hz=%u\n",
+			(u32_t)cpu, head, (u32_t)TRACE_RING_RECORDS, ring->hz);
+
+		for (u32_t idx = first; idx != head; idx++)
+		{
+			struct trace_record *rec = &ring->record[idx & (TRACE_RING_RECORDS - 1)];
+			const u32_t *word = (const u32_t *)rec;
+
+			if (rec->seq != (u16_t)idx)
+			{
+				continue;
+			}
+
+			printk("TRACE rec %08x %08x %08x %08x\n",
+				word[0], word[1], word[2], word[3]);
+		}
+
+		if (reset)
+		{
+			(void)atomic_set(&ring->head, 0);
+		}
+	}
+
+	printk("TRACE end\n");
+}
+
+exception_t syscall_trace_ring_print(word_t reset)
+{
+	bool_t is_sufficient = false;
+
+	update_timestamp(false);
+	is_sufficient = check_budget_restart();
+
+	if (is_sufficient)
+	{
+		trace_ring_dump(reset != 0);
+
+		schedule();
+		/* reschedule_unlocked(); */
+		return EXCEPTION_NONE;
+	}
+
+	return EXCEPTION_FAULT;
+}
+
+static s32_t trace_ring_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	for (word_t cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++)
+	{
+		struct trace_ring *ring = &trace_rings[cpu];
+
+		ring->magic = TRACE_RING_MAGIC;
+		ring->record_size = sizeof(struct trace_record);
+		ring->records = TRACE_RING_RECORDS;
+		ring->cpu = cpu;
+		/* the DWT counts core clocks, as does the SysTick */
+		ring->hz = sys_clock_hw_cycles_per_sec();
+	}
+
+	return 0;
+}
+
+SYS_INIT(trace_ring_init, pre_kernel_1, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
 #endif
@@ -0,0 +1,307 @@
+#ifdef CONFIG_WCET_STATS
+
+#include <benchmark/wcet.h>
+#include <state/statedata.h>
+#include <kernel/time.h>
+#include <kernel/thread.h>
+#include <sys/printk.h>
+#include <sys/string.h>
+#include <benchmark/cycles.h>
+#include <api/syscall.h>
+#include <api/errno.h>
+#include <syscall_list.h>
+
+/* Every cpu only writes its own slots. A syscall or an exception does
+ * not nest in itself, an IRQ of a higher priority nests in another one,
+ * so those are started per IRQ. The time a path was preempted for is
+ * counted in, which is what a thread waiting for it sees. Reading is
+ * racy, a record may be torn between max and args. */
+struct wcet_cpu {
+	u32_t syscall_start;
+	uintptr_t syscall_args[WCET_ARGS];
+	bool_t syscall_defer;
+	bool_t deferred_pending;
+	u32_t deferred_start;
+	uintptr_t deferred_args[WCET_ARGS];
+	u32_t exception_start;
+	u32_t irq_start[CONFIG_NUM_IRQS];
+	struct wcet_record syscall[K_SYSCALL_NUM];
+	struct wcet_record exception[WCET_EXCEPTIONS];
+	struct wcet_record irq[CONFIG_NUM_IRQS];
+};
+
+static struct wcet_cpu wcet_cpus[CONFIG_MP_NUM_CPUS];
+
+static const word_t wcet_path_size[wcet_path_number] = {
+	K_SYSCALL_NUM, WCET_EXCEPTIONS, CONFIG_NUM_IRQS
+};
+
+static const char *const wcet_path_str[wcet_path_number] = {
+	"syscall", "exception", "irq"
+};
+
+static FORCE_INLINE struct wcet_cpu *wcet_this_cpu(void)
+{
+	return &wcet_cpus[_current_cpu_index];
+}
+
+static struct wcet_record *wcet_record_of(word_t cpu, word_t path, word_t num)
+{
+	switch (path)
+	{
+		case wcet_path_syscall:
+			return &wcet_cpus[cpu].syscall[num];
+		case wcet_path_exception:
+			return &wcet_cpus[cpu].exception[num];
+		default:
+			return &wcet_cpus[cpu].irq[num];
+	}
+}
+
+/* true when the sample is a new worst case, the caller then keeps its args */
+static bool_t wcet_record(struct wcet_record *record, u32_t cycles)
+{
+	record->sum += cycles;
+	record->count++;
+
+	if (cycles <= record->max)
+	{
+		return FALSE;
+	}
+
+	record->max = cycles;
+	return TRUE;
+}
+
+void wcet_syscall_enter(word_t id, uintptr_t arg0, uintptr_t arg1,
+	uintptr_t arg2, uintptr_t arg3, uintptr_t arg4, uintptr_t arg5)
+{
+	struct wcet_cpu *cpu = wcet_this_cpu();
+
+	ARG_UNUSED(id);
+
+	cpu->syscall_args[0] = arg0;
+	cpu->syscall_args[1] = arg1;
+	cpu->syscall_args[2] = arg2;
+	cpu->syscall_args[3] = arg3;
+	cpu->syscall_args[4] = arg4;
+	cpu->syscall_args[5] = arg5;
+	/* last, so storing the args is not counted */
+	cpu->syscall_start = benchmark_cycles();
+}
+
+void wcet_syscall_exit(word_t id)
+{
+	u32_t end = benchmark_cycles();
+	struct wcet_cpu *cpu = wcet_this_cpu();
+
+	/* the window stays open until the privilege thread is done */
+	if (cpu->syscall_defer)
+	{
+		cpu->syscall_defer = FALSE;
+		cpu->deferred_pending = TRUE;
+		cpu->deferred_start = cpu->syscall_start;
+		(void)memcpy(cpu->deferred_args, cpu->syscall_args,
+			sizeof(cpu->syscall_args));
+		return;
+	}
+
+	if (id < K_SYSCALL_NUM &&
+		wcet_record(&cpu->syscall[id], end - cpu->syscall_start))
+	{
+		(void)memcpy(cpu->syscall[id].args, cpu->syscall_args,
+			sizeof(cpu->syscall_args));
+	}
+}
+
+/* A call the privilege thread finishes, such as exchange_ipc, is timed
+ * from its entry until wcet_syscall_deferred_exit() after that work, so
+ * the switches to and from the privilege thread are counted in. */
+void wcet_syscall_defer(void)
+{
+	wcet_this_cpu()->syscall_defer = TRUE;
+}
+
+void wcet_syscall_deferred_exit(word_t id)
+{
+	u32_t end = benchmark_cycles();
+	struct wcet_cpu *cpu = wcet_this_cpu();
+
+	if (!cpu->deferred_pending)
+	{
+		return;
+	}
+
+	cpu->deferred_pending = FALSE;
+	if (id < K_SYSCALL_NUM &&
+		wcet_record(&cpu->syscall[id], end - cpu->deferred_start))
+	{
+		(void)memcpy(cpu->syscall[id].args, cpu->deferred_args,
+			sizeof(cpu->deferred_args));
+	}
+}
+
+void wcet_exception_enter(word_t num)
+{
+	ARG_UNUSED(num);
+
+	wcet_this_cpu()->exception_start = benchmark_cycles();
+}
+
+/* before a fatal exception aborts the thread, that is never returned from */
+void wcet_exception_exit(word_t num, uintptr_t pc, uintptr_t lr)
+{
+	u32_t end = benchmark_cycles();
+	struct wcet_cpu *cpu = wcet_this_cpu();
+
+	if (num < WCET_EXCEPTIONS &&
+		wcet_record(&cpu->exception[num], end - cpu->exception_start))
+	{
+		(void)memset(cpu->exception[num].args, 0, sizeof(cpu->exception[num].args));
+		cpu->exception[num].args[0] = pc;
+		cpu->exception[num].args[1] = lr;
+	}
+}
+
+void wcet_irq_enter(word_t num)
+{
+	if (num < CONFIG_NUM_IRQS)
+	{
+		wcet_this_cpu()->irq_start[num] = benchmark_cycles();
+	}
+}
+
+void wcet_irq_exit(word_t num, bool_t is_resched)
+{
+	u32_t end = benchmark_cycles();
+	struct wcet_cpu *cpu = wcet_this_cpu();
+
+	if (num < CONFIG_NUM_IRQS &&
+		wcet_record(&cpu->irq[num], end - cpu->irq_start[num]))
+	{
+		(void)memset(cpu->irq[num].args, 0, sizeof(cpu->irq[num].args));
+		cpu->irq[num].args[0] = is_resched;
+		cpu->irq[num].args[1] = (uintptr_t)_current_thread;
+	}
+}
+
+/* One line per entry point that was taken, then the worst of all of
+ * them against the kernel WCET the sporadic budgets are sized with. */
+void wcet_dump(bool_t reset)
+{
+	u32_t worst = 0;
+
+	for (word_t cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++)
+	{
+		for (word_t path = 0; path < wcet_path_number; path++)
+		{
+			for (word_t num = 0; num < wcet_path_size[path]; num++)
+			{
+				struct wcet_record *record = wcet_record_of(cpu, path, num);
+				const uintptr_t *args = record->args;
+
+				if (record->count == 0)
+				{
+					continue;
+				}
+
+				printk("cpu %u %s %u: n %u max %u mean %u args %lx %lx %lx %lx %lx %lx\n",
+					(u32_t)cpu, wcet_path_str[path], (u32_t)num, record->count,
+					record->max, (u32_t)(record->sum / record->count),
+					(unsigned long)args[0], (unsigned long)args[1],
+					(unsigned long)args[2], (unsigned long)args[3],
+					(unsigned long)args[4], (unsigned long)args[5]);
+
+				worst = MAX(worst, record->max);
+				if (reset)
+				{
+					(void)memset(record, 0, sizeof(*record));
+				}
+			}
+		}
+	}
+
+	printk("worst kernel entry %u cycles, %u us, assumed %u us\n", worst,
+		k_cyc_to_us_floor32(worst),
+		(u32_t)(get_kernel_wcet_us() * KERNEL_WCET_SCALE));
+}
+
+/* the record of one entry point summed over every cpu, the args are
+ * those of the worst cpu */
+exception_t syscall_wcet_read(word_t path, word_t num,
+	struct wcet_record *record, word_t reset)
+{
+	bool_t is_sufficient = false;
+
+	update_timestamp(false);
+	is_sufficient = check_budget_restart();
+
+	if (is_sufficient)
+	{
+		struct wcet_record sum;
+
+		if (path >= wcet_path_number || num >= wcet_path_size[path] || !record)
+		{
+			user_error("WCET: Invalid path, number or record.");
+			current_syscall_error_code = TCR_INVAL_PARA;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+
+#if defined(CONFIG_USERSPACE)
+		if (SYSCALL_MEMORY_WRITE(record, sizeof(*record)))
+		{
+			user_error("WCET: Illegal operation attempted.");
+			current_syscall_error_code = TCR_INVAL_PARA;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+#endif
+
+		(void)memset(&sum, 0, sizeof(sum));
+		for (word_t cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++)
+		{
+			struct wcet_record *from = wcet_record_of(cpu, path, num);
+
+			if (from->max > sum.max)
+			{
+				sum.max = from->max;
+				(void)memcpy(sum.args, from->args, sizeof(sum.args));
+			}
+			sum.count += from->count;
+			sum.sum += from->sum;
+
+			if (reset)
+			{
+				(void)memset(from, 0, sizeof(*from));
+			}
+		}
+
+		*record = sum;
+
+		schedule();
+		/* reschedule_unlocked(); */
+		return EXCEPTION_NONE;
+	}
+
+	return EXCEPTION_FAULT;
+}
+
+exception_t syscall_wcet_print(word_t reset)
+{
+	bool_t is_sufficient = false;
+
+	update_timestamp(false);
+	is_sufficient = check_budget_restart();
+
+	if (is_sufficient)
+	{
+		wcet_dump(reset != 0);
+
+		schedule();
+		/* reschedule_unlocked(); */
+		return EXCEPTION_NONE;
+	}
+
+	return EXCEPTION_FAULT;
+}
+
+#endif
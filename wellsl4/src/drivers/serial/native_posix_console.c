@@ -0,0 +1,17 @@
+#include <types_def.h>
+#include <arch/cpu.h>
+#include <arch/posix/posix_host.h>
+
+/* The console of native_posix is the stdout of the host process */
+static sword_t debug_block_out(sword_t str)
+{
+	posix_putchar((byte_t)str);
+	return 0;
+}
+
+void init_serial_object(void)
+{
+	extern void arch_printk_set_hook(sword_t (*fn)(sword_t));
+
+	arch_printk_set_hook(debug_block_out);
+}
@@ -0,0 +1,37 @@
+#include <types_def.h>
+#include <arch/cpu.h>
+#include <generated_dts_board.h>
+
+/* ARM CMSDK APB UART, as found on the MPS2 images */
+#define UART_DATA		0x00
+#define UART_STATE		0x04
+#define UART_CTRL		0x08
+#define UART_BAUDDIV	0x10
+
+#define UART_STATE_TX_FULL	BIT(0)
+#define UART_CTRL_TX_EN		BIT(0)
+
+#define UART_BASE		DT_UART_CMSDK_APB_CONSOLE_BASE_ADDRESS
+
+/* The UART is clocked from the system clock, the divider must be >= 16 */
+#define UART_BAUDDIV_VAL	(CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC / \
+				 DT_UART_CMSDK_APB_CONSOLE_BAUD_RATE)
+
+static sword_t debug_block_out(sword_t str)
+{
+	while (sys_read32(UART_BASE + UART_STATE) & UART_STATE_TX_FULL)
+	{
+	}
+
+	sys_write32((byte_t)str, UART_BASE + UART_DATA);
+	return 0;
+}
+
+void init_serial_object(void)
+{
+	extern void arch_printk_set_hook(sword_t (*fn)(sword_t));
+
+	sys_write32(UART_BAUDDIV_VAL, UART_BASE + UART_BAUDDIV);
+	sys_write32(UART_CTRL_TX_EN, UART_BASE + UART_CTRL);
+	arch_printk_set_hook(debug_block_out);
+}
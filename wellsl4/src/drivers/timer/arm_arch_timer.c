@@ -0,0 +1,171 @@
+#include <drivers/timer/system_timer.h>
+#include <sys/util.h>
+#include <sys/limits.h>
+#include <model/spinlock.h>
+#include <kernel/time.h>
+#include <arch/irq.h>
+#include <arch/arm/aarch64/timer.h>
+
+static spinlock_t time_lock;
+
+#define LOCKED(lck) \
+		for (spinlock_key_t __i = {},	\
+		     __key = lock_spin_lock(lck);	\
+		     !__i.key;					\
+             unlock_spin_unlock(lck, __key),\
+             __i.key = 1)
+
+/* The counter is 64 bits wide and never wraps in practice, so unlike
+ * SysTick there is no overflow bookkeeping and no upper bound on the
+ * programmed delay other than the s32_t tick count of the kernel.
+ */
+#define CYC_PER_TICK    ((u64_t)sys_clock_hw_cycles_per_sec() / CONFIG_SYS_CLOCK_TICKS_PER_SEC)
+#define MAX_TICKS       INT_MAX
+#define MIN_DELAY       (1000)
+#define TICKLESS        (IS_ENABLED(CONFIG_TICKLESS_KERNEL))
+
+/*
+ * Counter value of the last announced tick boundary. The counter is
+ * shared by all CPUs, only the compare registers are banked per CPU.
+ */
+static volatile u64_t announced_cycle;
+
+static void clock_isr(generptr_t arg)
+{
+	u32_t dticks = 0;
+
+	ARG_UNUSED(arg);
+
+	LOCKED(&time_lock)
+	{
+		u64_t now = arm_arch_timer_count();
+
+		dticks = (u32_t)((now - announced_cycle) / CYC_PER_TICK);
+		announced_cycle += dticks * CYC_PER_TICK;
+
+		if (!TICKLESS)
+		{
+			u64_t next = announced_cycle + CYC_PER_TICK;
+
+			if ((s64_t)(next - now) < MIN_DELAY)
+			{
+				next += CYC_PER_TICK;
+			}
+			arm_arch_timer_set_compare(next);
+		}
+		else
+		{
+			/* Another CPU may own the next timeout; keep this compare
+			 * quiet until clock_set_timeout() is called here again.
+			 */
+			arm_arch_timer_set_compare(UINT64_MAX);
+		}
+	}
+
+	/* In tickless mode update_timelist() reprograms the compare of
+	 * this CPU for the next event through clock_set_timeout().
+	 */
+	update_timelist(TICKLESS ? dticks : 1);
+}
+
+void clock_init(void)
+{
+#if defined(CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME)
+	clock_hw_cycles_per_sec = arm_arch_timer_freq();
+#endif
+
+	IRQ_DYNC_CONNECT(ARM_ARCH_TIMER_IRQ, ARM_TIMER_PRIO, clock_isr, NULL, ARM_TIMER_FLAGS);
+
+	announced_cycle = arm_arch_timer_count();
+	arm_arch_timer_set_compare(announced_cycle + CYC_PER_TICK);
+	arm_arch_timer_enable(true);
+	irq_enable(ARM_ARCH_TIMER_IRQ);
+}
+
+/* The timer PPI and the compare registers are banked, so every
+ * secondary CPU has to enable its own copy.
+ */
+void smp_timer_init(void)
+{
+	arm_arch_timer_set_compare(TICKLESS ? UINT64_MAX :
+		announced_cycle + CYC_PER_TICK);
+	arm_arch_timer_enable(true);
+	irq_enable(ARM_ARCH_TIMER_IRQ);
+}
+
+void clock_set_timeout(sword_t ticks, bool idle)
+{
+#if defined(CONFIG_TICKLESS_KERNEL)
+	if (IS_ENABLED(CONFIG_TICKLESS_IDLE) && idle && ticks == FOREVER)
+	{
+		/* Nothing to wake up for; the counter keeps running, so
+		 * there is no wrap to catch and the compare can be parked.
+		 */
+		arm_arch_timer_set_compare(UINT64_MAX);
+		return;
+	}
+
+	ticks = (ticks == FOREVER) ? MAX_TICKS : ticks;
+	ticks = MAX(MIN(ticks - 1, (sword_t)MAX_TICKS), 0);
+
+	LOCKED(&time_lock)
+	{
+		u64_t now = arm_arch_timer_count();
+		u64_t delay = (u64_t)ticks * CYC_PER_TICK;
+
+		/* Round up to the next tick boundary */
+		delay += (now - announced_cycle) + (CYC_PER_TICK - 1);
+		delay = (delay / CYC_PER_TICK) * CYC_PER_TICK;
+
+		if ((s64_t)(announced_cycle + delay - now) < MIN_DELAY)
+		{
+			delay += CYC_PER_TICK;
+		}
+
+		arm_arch_timer_set_compare(announced_cycle + delay);
+	}
+#else
+	ARG_UNUSED(ticks);
+	ARG_UNUSED(idle);
+#endif
+}
+
+u32_t clock_elapsed(void)
+{
+	u32_t ticks = 0;
+
+	if (!TICKLESS)
+	{
+		return 0;
+	}
+
+	LOCKED(&time_lock)
+	{
+		ticks = (u32_t)((arm_arch_timer_count() - announced_cycle) / CYC_PER_TICK);
+	}
+
+	return ticks;
+}
+
+u32_t clock_cycle_get_32(void)
+{
+	return (u32_t)arm_arch_timer_count();
+}
+
+#if defined(CONFIG_SYSTEM_CLOCK_CYCLES_64)
+u64_t clock_cycle_get_64(void)
+{
+	return arm_arch_timer_count();
+}
+#endif
+
+void clock_idle_exit(void)
+{
+	/* The next clock_set_timeout() rearms the parked compare */
+}
+
+void clock_disable(void)
+{
+	arm_arch_timer_enable(false);
+	irq_disable(ARM_ARCH_TIMER_IRQ);
+}
@@ -0,0 +1,90 @@
+#include <types_def.h>
+#include <arch/cpu.h>
+#include <arch/irq.h>
+#include <drivers/timer/arm_arch_timer.h>
+#include <benchmark/profile.h>
+
+/* The sample source of the profiler on ARM64: an overflow interrupt of
+ * the PMU cycle counter every 1 / frequency seconds. Only the cpu that
+ * called profile_timer_start() is sampled.
+ */
+
+/* PMU overflow PPI as a GIC INTID */
+#define ARM_PMU_IRQ			23
+#define PMU_IRQ				((ARM_PMU_IRQ + 1) << 8)
+
+#define PMCR_E				BIT(0)
+#define PMCR_C				BIT(2)
+#define PMCR_LC				BIT(6)
+#define PMU_CYCLE_COUNTER	BIT(31)
+
+/* the counter overflows at 32 bits with PMCR_EL0.LC clear */
+static u64_t pmu_reload;
+
+static void pmu_profile_isr(generptr_t arg)
+{
+	u64_t el, pc, spsr;
+	u32_t flags = 0;
+
+	ARG_UNUSED(arg);
+
+	__asm__ volatile("msr pmovsclr_el0, %0" : : "r" ((u64_t)PMU_CYCLE_COUNTER));
+	__asm__ volatile("msr pmccntr_el0, %0" : : "r" (pmu_reload));
+
+	/* IRQs stay masked in the ISR wrapper, so ELR and SPSR still hold
+	 * the interrupted context */
+	__asm__ volatile("mrs %0, CurrentEL" : "=r" (el));
+
+	switch (GET_EL(el)) {
+	case MODE_EL2:
+		__asm__ volatile("mrs %0, elr_el2" : "=r" (pc));
+		__asm__ volatile("mrs %0, spsr_el2" : "=r" (spsr));
+		break;
+	case MODE_EL3:
+		__asm__ volatile("mrs %0, elr_el3" : "=r" (pc));
+		__asm__ volatile("mrs %0, spsr_el3" : "=r" (spsr));
+		break;
+	default:
+		__asm__ volatile("mrs %0, elr_el1" : "=r" (pc));
+		__asm__ volatile("mrs %0, spsr_el1" : "=r" (spsr));
+		break;
+	}
+
+	if (GET_EL(spsr) == MODE_EL0)
+	{
+		flags |= PROFILE_SAMPLE_USER;
+	}
+
+	/* the interrupted x30 is not at hand here, no caller */
+	profile_sample(pc, 0, flags);
+}
+
+void profile_timer_start(u32_t frequency)
+{
+	u64_t pmcr;
+
+	pmu_reload = (u32_t)(0U - CONFIG_ARM_PMU_PROFILE_CYCLES_PER_SEC / frequency);
+
+	IRQ_DYNC_CONNECT(PMU_IRQ, ARM_TIMER_PRIO, pmu_profile_isr, NULL, ARM_TIMER_FLAGS);
+
+	__asm__ volatile("mrs %0, pmcr_el0" : "=r" (pmcr));
+	pmcr = (pmcr | PMCR_E | PMCR_C) & ~(u64_t)PMCR_LC;
+	__asm__ volatile("msr pmcr_el0, %0" : : "r" (pmcr));
+
+	__asm__ volatile("msr pmccntr_el0, %0" : : "r" (pmu_reload));
+	__asm__ volatile("msr pmovsclr_el0, %0" : : "r" ((u64_t)PMU_CYCLE_COUNTER));
+	__asm__ volatile("msr pmintenset_el1, %0" : : "r" ((u64_t)PMU_CYCLE_COUNTER));
+	__asm__ volatile("msr pmcntenset_el0, %0" : : "r" ((u64_t)PMU_CYCLE_COUNTER));
+	__asm__ volatile("isb" : : : "memory");
+
+	irq_enable(PMU_IRQ);
+}
+
+void profile_timer_stop(void)
+{
+	irq_disable(PMU_IRQ);
+
+	__asm__ volatile("msr pmintenclr_el1, %0" : : "r" ((u64_t)PMU_CYCLE_COUNTER));
+	__asm__ volatile("msr pmcntenclr_el0, %0" : : "r" ((u64_t)PMU_CYCLE_COUNTER));
+	__asm__ volatile("msr pmovsclr_el0, %0" : : "r" ((u64_t)PMU_CYCLE_COUNTER));
+}
@@ -0,0 +1,87 @@
+#include <types_def.h>
+#include <arch/cpu.h>
+#include <arch/irq.h>
+#include <generated_dts_board.h>
+#include <benchmark/profile.h>
+#include <arch/arm/aarch32/cortex_m/cmsis.h>
+
+/* ARM CMSDK APB timer, the sample source of the profiler on MPS2 */
+#define TIMER_CTRL		0x00
+#define TIMER_VALUE		0x04
+#define TIMER_RELOAD	0x08
+#define TIMER_INTCLEAR	0x0c
+
+#define TIMER_CTRL_EN		BIT(0)
+#define TIMER_CTRL_IRQ_EN	BIT(3)
+
+#define TIMER_BASE		DT_CMSDK_APB_PROFILE_TIMER_BASE_ADDRESS
+#define TIMER_IRQ		DT_CMSDK_APB_PROFILE_TIMER_IRQ
+
+/* EXC_RETURN: the interrupted context used the process stack, and was
+ * in thread mode */
+#define EXC_RETURN_SPSEL		BIT(2)
+#define EXC_RETURN_THREAD_MODE	BIT(3)
+
+#if defined(CONFIG_ZERO_LATENCY_IRQS)
+/* not masked by irq_lock(), so kernel critical sections get sampled too */
+#define TIMER_IRQ_FLAGS		IRQ_ZERO_LATENCY
+#else
+#define TIMER_IRQ_FLAGS		0
+#endif
+
+void cmsdk_profile_sample(u32_t *frame, u32_t exc_return);
+
+/* Entered straight from the vector table with the exception frame of the
+ * interrupted context on its stack. Hands that frame and EXC_RETURN to
+ * cmsdk_profile_sample(), which returns from the exception itself. */
+__attribute__((naked)) static void cmsdk_profile_isr(void)
+{
+	__asm__ volatile(
+		"tst lr, #4\n\t"
+		"ite eq\n\t"
+		"mrseq r0, msp\n\t"
+		"mrsne r0, psp\n\t"
+		"mov r1, lr\n\t"
+		"b cmsdk_profile_sample\n\t");
+}
+
+/* frame[5] and frame[6] are the stacked lr and pc */
+void cmsdk_profile_sample(u32_t *frame, u32_t exc_return)
+{
+	u32_t flags = 0;
+
+	sys_write32(1, TIMER_BASE + TIMER_INTCLEAR);
+
+	if ((exc_return & EXC_RETURN_THREAD_MODE) == 0)
+	{
+		flags |= PROFILE_SAMPLE_ISR;
+	}
+	else if ((__get_CONTROL() & CONTROL_nPRIV_Msk) != 0)
+	{
+		flags |= PROFILE_SAMPLE_USER;
+	}
+
+	profile_sample(frame[6], frame[5], flags);
+}
+
+void profile_timer_start(u32_t frequency)
+{
+	u32_t reload = CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC / frequency - 1;
+
+	IRQ_DIRECT_CONNECT(TIMER_IRQ, DT_CMSDK_APB_PROFILE_TIMER_IRQ_PRIORITY,
+		cmsdk_profile_isr, TIMER_IRQ_FLAGS);
+
+	sys_write32(0, TIMER_BASE + TIMER_CTRL);
+	sys_write32(reload, TIMER_BASE + TIMER_RELOAD);
+	sys_write32(reload, TIMER_BASE + TIMER_VALUE);
+	sys_write32(1, TIMER_BASE + TIMER_INTCLEAR);
+	sys_write32(TIMER_CTRL_EN | TIMER_CTRL_IRQ_EN, TIMER_BASE + TIMER_CTRL);
+	irq_enable(TIMER_IRQ);
+}
+
+void profile_timer_stop(void)
+{
+	sys_write32(0, TIMER_BASE + TIMER_CTRL);
+	sys_write32(1, TIMER_BASE + TIMER_INTCLEAR);
+	irq_disable(TIMER_IRQ);
+}
@@ -3,6 +3,7 @@
 #include <model/spinlock.h>
 #include <kernel/time.h>
 #include <arch/arm/aarch32/cortex_m/cmsis.h>
+#include <arch/arm/aarch32/cortex_m/dwt.h>
 
 static spinlock_t time_lock;
 
@@ -65,6 +66,22 @@ static u32_t announced_cycle;
  */
 static volatile u32_t overflowed_cycle;
 
+#if defined(CONFIG_SYSTEM_CLOCK_CYCLES_64)
+/*
+ * Software extension of the 32-bit cycle count to 64 bits. The low
+ * word is the last value read from the clock source, the high word
+ * counts its wraps. cycle64_update() must run at least once per 2^32
+ * cycles, which clock_isr() guarantees as LOAD never exceeds 24 bits.
+ */
+static u32_t cycle64_low;
+static u32_t cycle64_high;
+#endif
+
+#if defined(CONFIG_SYSTEM_CLOCK_SUBTICK_DEADLINE)
+/* Absolute cycle of the armed one-shot deadline, 0 if none */
+static u64_t deadline_cycle;
+#endif
+
 /* This internal function calculates the amount of HW cycles that have
  * elapsed since the last time the absolute HW cycles counter has been
  * updated. 'current_cycle' may be updated either by the ISR, or when we
@@ -115,6 +132,51 @@ static u32_t elapsed(void)
 	return (lastload_cycle - val2) + overflowed_cycle;
 }
 
+#if defined(CONFIG_SYSTEM_CLOCK_CYCLES_64)
+/* Must be invoked with time_lock held */
+static u64_t cycle64_update(void)
+{
+#if defined(CONFIG_SYSTEM_CLOCK_CYCLES_64_DWT)
+	u32_t now = DWT->CYCCNT;
+#else
+	u32_t now = elapsed() + current_cycle;
+#endif
+
+	if (now < cycle64_low)
+	{
+		cycle64_high++;
+	}
+	cycle64_low = now;
+
+	return ((u64_t)cycle64_high << 32) | now;
+}
+#endif
+
+#if defined(CONFIG_SYSTEM_CLOCK_SUBTICK_DEADLINE)
+/* Clamp a LOAD value so that SysTick fires no later than deadline_cycle.
+ * 'now' must be sampled before current_cycle absorbs the pending cycles,
+ * as the counter itself is only reset once LOAD is rewritten.
+ */
+static u32_t deadline_clamp(u32_t load, u64_t now)
+{
+	if (deadline_cycle == 0)
+	{
+		return load;
+	}
+
+	if (deadline_cycle <= now)
+	{
+		return MIN_DELAY;
+	}
+	if (deadline_cycle - now < load)
+	{
+		return MAX((u32_t)(deadline_cycle - now), MIN_DELAY);
+	}
+
+	return load;
+}
+#endif
+
 /* Callout out of platform assembly, not hooked via IRQ_DYNC_CONNECT... */
 void clock_isr(void)
 {
@@ -129,6 +191,26 @@ void clock_isr(void)
 	current_cycle += overflowed_cycle;
 	overflowed_cycle = 0;
 
+#if defined(CONFIG_SYSTEM_CLOCK_CYCLES_64)
+	LOCKED(&time_lock)
+	{
+		(void)cycle64_update();
+	}
+#endif
+
+#if defined(CONFIG_SYSTEM_CLOCK_SUBTICK_DEADLINE)
+	/* Disarm before update_timelist() reprograms LOAD, otherwise the
+	 * expired deadline would be clamped to MIN_DELAY once more.
+	 */
+	bool_t deadline_hit = false;
+
+	if (deadline_cycle != 0 && deadline_cycle <= clock_cycle_get_64())
+	{
+		deadline_cycle = 0;
+		deadline_hit = true;
+	}
+#endif
+
 	if (TICKLESS) 
 	{
 		/* In TICKLESS mode, the SysTick.LOAD is re-programmed
@@ -151,6 +233,13 @@ void clock_isr(void)
 	{
 		update_timelist(1);
 	}
+
+#if defined(CONFIG_SYSTEM_CLOCK_SUBTICK_DEADLINE)
+	if (deadline_hit)
+	{
+		update_cycle_timelist(clock_cycle_get_64());
+	}
+#endif
 	
 	arm_exc_exit();
 }
@@ -166,6 +255,10 @@ void clock_init(void)
 	SysTick->VAL  =  0; /* resets timer to lastload_cycle */
 	SysTick->CTRL |= (SysTick_CTRL_ENABLE_Msk | SysTick_CTRL_TICKINT_Msk |
 			  		  SysTick_CTRL_CLKSOURCE_Msk);
+
+#if defined(CONFIG_SYSTEM_CLOCK_CYCLES_64_DWT)
+	(void)arm_dwt_cycle_count_enable();
+#endif
 }
 
 void clock_set_timeout(sword_t ticks, bool idle)
@@ -177,7 +270,11 @@ void clock_set_timeout(sword_t ticks, bool idle)
 	 * interrupts are already disabled)
 	 */
 
-	if (IS_ENABLED(CONFIG_TICKLESS_IDLE) && idle && ticks == FOREVER) 
+	/* The 64-bit cycle clock relies on the SysTick interrupt to see
+	 * every 32-bit wrap, so it is never switched off.
+	 */
+	if (IS_ENABLED(CONFIG_TICKLESS_IDLE) && !IS_ENABLED(CONFIG_SYSTEM_CLOCK_CYCLES_64) &&
+		idle && ticks == FOREVER) 
 	{
 		SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
 		lastload_cycle = CLOSING_COUNTS;
@@ -192,6 +289,9 @@ void clock_set_timeout(sword_t ticks, bool idle)
 
 	LOCKED(&time_lock)
 	{
+#if defined(CONFIG_SYSTEM_CLOCK_SUBTICK_DEADLINE)
+		u64_t now = cycle64_update();
+#endif
 		u32_t pending = elapsed();
 		
 		current_cycle += pending;
@@ -227,6 +327,9 @@ void clock_set_timeout(sword_t ticks, bool idle)
 			{
 				lastload_cycle = delay;
 			}
+#if defined(CONFIG_SYSTEM_CLOCK_SUBTICK_DEADLINE)
+			lastload_cycle = deadline_clamp(lastload_cycle, now);
+#endif
 		}
 		
 		SysTick->LOAD = lastload_cycle - 1;
@@ -264,6 +367,49 @@ u32_t clock_cycle_get_32(void)
 	return ret;
 }
 
+#if defined(CONFIG_SYSTEM_CLOCK_CYCLES_64)
+u64_t clock_cycle_get_64(void)
+{
+	u64_t ret = 0;
+
+	LOCKED(&time_lock)
+	{
+		ret = cycle64_update();
+	}
+
+	return ret;
+}
+#endif
+
+#if defined(CONFIG_SYSTEM_CLOCK_SUBTICK_DEADLINE)
+void clock_set_deadline_cycles(u64_t cycle)
+{
+	LOCKED(&time_lock)
+	{
+		u64_t now = cycle64_update();
+		u32_t pending = elapsed();
+		u32_t remaining = (pending < lastload_cycle) ? (lastload_cycle - pending) : 0;
+		u32_t load;
+
+		deadline_cycle = cycle;
+
+		/* Only shorten the running period; the next tick timeout is
+		 * already programmed and must not be delayed. If the counter
+		 * already wrapped, the ISR is pending and will rearm us.
+		 */
+		load = deadline_clamp(remaining, now);
+		if (remaining != 0 && load < remaining)
+		{
+			current_cycle += pending;
+			overflowed_cycle = 0U;
+			lastload_cycle = load;
+			SysTick->LOAD = lastload_cycle - 1;
+			SysTick->VAL = 0; /* resets timer to lastload_cycle */
+		}
+	}
+}
+#endif
+
 void clock_idle_exit(void)
 {
 	if (lastload_cycle == CLOSING_COUNTS)
@@ -0,0 +1,146 @@
+#include <drivers/timer/system_timer.h>
+#include <drivers/timer/native_posix_timer.h>
+#include <sys/util.h>
+#include <model/spinlock.h>
+#include <kernel/time.h>
+#include <arch/cpu.h>
+#include <arch/irq.h>
+
+/* System timer of the POSIX arch. No host clock is read: the counter is
+ * simulated and only moves in native_posix_timer_advance(), called by
+ * arch_cpu_idle() up to the programmed timeout or directly by a test.
+ * A timeout is taken as an interrupt on NATIVE_POSIX_TIMER_IRQ.
+ */
+
+static spinlock_t time_lock;
+
+#define LOCKED(lck) \
+		for (spinlock_key_t __i = {},	\
+		     __key = lock_spin_lock(lck);	\
+		     !__i.key;					\
+             unlock_spin_unlock(lck, __key),\
+             __i.key = 1)
+
+#define CYC_PER_TICK    (sys_clock_hw_cycles_per_sec()	/ CONFIG_SYS_CLOCK_TICKS_PER_SEC)
+#define TICKLESS        (IS_ENABLED(CONFIG_TICKLESS_KERNEL))
+
+/* the simulated counter, 64 bits wide so it never wraps */
+static u64_t current_cycle;
+
+/* cycles announced to the kernel, always a whole number of ticks */
+static u64_t announced_cycle;
+
+/* absolute cycle of the programmed timeout, 0 if none */
+static u64_t timeout_cycle;
+
+static void native_posix_timer_isr(generptr_t arg)
+{
+	u32_t dticks;
+
+	ARG_UNUSED(arg);
+
+	dticks = (u32_t)((current_cycle - announced_cycle) / CYC_PER_TICK);
+	announced_cycle += (u64_t)dticks * CYC_PER_TICK;
+
+	if (!TICKLESS)
+	{
+		timeout_cycle = announced_cycle + CYC_PER_TICK;
+	}
+
+	/* reprograms the timeout through clock_set_timeout() when tickless */
+	update_timelist(dticks);
+}
+
+void native_posix_timer_advance(u64_t cycles)
+{
+	u64_t end = current_cycle + cycles;
+
+	/* stop at every timeout on the way, as the hardware would */
+	while (timeout_cycle != 0 && timeout_cycle <= end)
+	{
+		current_cycle = timeout_cycle;
+		timeout_cycle = 0;
+		posix_irq_raise(NATIVE_POSIX_TIMER_IRQ);
+	}
+
+	current_cycle = end;
+}
+
+u64_t native_posix_timer_pending(void)
+{
+	return (timeout_cycle != 0) ? timeout_cycle - current_cycle : 0;
+}
+
+void clock_init(void)
+{
+	IRQ_DYNC_CONNECT(NATIVE_POSIX_TIMER_IRQ, 0, native_posix_timer_isr, NULL, 0);
+	irq_enable(NATIVE_POSIX_TIMER_IRQ);
+
+	current_cycle = 0;
+	announced_cycle = 0;
+	timeout_cycle = TICKLESS ? 0 : CYC_PER_TICK;
+}
+
+void clock_set_timeout(sword_t ticks, bool idle)
+{
+	ARG_UNUSED(idle);
+
+#if defined(CONFIG_TICKLESS_KERNEL)
+	LOCKED(&time_lock)
+	{
+		u64_t unannounced = current_cycle - announced_cycle;
+
+		if (ticks == FOREVER)
+		{
+			/* nothing has to see the counter wrap */
+			timeout_cycle = 0;
+		}
+		else
+		{
+			/* on a tick boundary, never earlier than the next one */
+			timeout_cycle = announced_cycle +
+				(unannounced / CYC_PER_TICK + MAX(ticks, 1)) * CYC_PER_TICK;
+		}
+	}
+#else
+	ARG_UNUSED(ticks);
+#endif
+}
+
+u32_t clock_elapsed(void)
+{
+	u32_t ticks = 0;
+
+	if (!TICKLESS)
+	{
+		return 0;
+	}
+
+	LOCKED(&time_lock)
+	{
+		ticks = (u32_t)((current_cycle - announced_cycle) / CYC_PER_TICK);
+	}
+
+	return ticks;
+}
+
+u32_t clock_cycle_get_32(void)
+{
+	return (u32_t)current_cycle;
+}
+
+#if defined(CONFIG_SYSTEM_CLOCK_CYCLES_64)
+u64_t clock_cycle_get_64(void)
+{
+	return current_cycle;
+}
+#endif
+
+void clock_idle_exit(void)
+{
+}
+
+void clock_disable(void)
+{
+	timeout_cycle = 0;
+}
@@ -27,7 +27,7 @@ static const word_t random32_dvalue = 1000000013;
 /* */
 THREAD_STACK_DEFINE(_main_stack, CONFIG_MAIN_STACK_SIZE);
 THREAD_STACK_DEFINE(_idle_stack, CONFIG_IDLE_STACK_SIZE);
-THREAD_STACK_DEFINE(_privilege_stack, CONFIG_IDLE_STACK_SIZE);
+THREAD_STACK_DEFINE(_privilege_stack, CONFIG_PRIVILEGE_STACK_SIZE);
 
 /* idle thread */
 struct ktcb privilege_thread;
@@ -314,7 +314,7 @@ static void init_main_thread(struct ktcb *thread, struct thread_stack *stack)
 	set_new_thread(thread, stack,
 			   CONFIG_MAIN_STACK_SIZE, main_thread_entry,
 			   NULL, NULL, NULL, option_essential_option);
-	set_prior(thread, 31u, 31u);
+	set_prior(thread, MAIN_THREAD_PRIO, MAIN_THREAD_PRIO);
 	set_domain(thread, 0u);
 	marktcb_as_started(thread);
 	set_ready_thread(thread);
@@ -337,11 +337,11 @@ static void prepare_mult_thread(struct ktcb *dummy_thread)
 	dummy_thread->base.thread_state = state_dummy_state;
 	dummy_thread->sched = NULL;
 #if defined(CONFIG_THREAD_STACK_INFO) 
-	dummy_thread->stack_info.start = 0U;
-	dummy_thread->stack_info.size = 0U;
+	dummy_thread->cold.stack_info.start = 0U;
+	dummy_thread->cold.stack_info.size = 0U;
 #endif
 #if defined(CONFIG_USERSPACE) 
-	dummy_thread->userspace_fpage_table.pagetable_item = NULL;
+	dummy_thread->cold.userspace_fpage_table.pagetable_item = NULL;
 #endif
 #endif
 
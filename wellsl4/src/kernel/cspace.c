@@ -86,7 +86,8 @@ bool_t is_final_d_object(struct d_object *d) /* for same object */
 		sys_dnode_t *next = sys_dlist_peek_next(&d_obj_dlist, &d->k_obj_dlnode);
 		struct d_object *next_d_obj = CONTAINER_OF(next, struct d_object, k_obj_dlnode);
 		
-		if (!is_same_object(&d->k_obj, &next_d_obj->k_obj))
+		/* the last object of the list has nothing after it */
+		if (next == NULL || !is_same_object(&d->k_obj, &next_d_obj->k_obj))
 		{
 			return true;
 		}
@@ -188,7 +189,7 @@ void d_object_insert(struct    k_object *new_k, struct d_object *src_d, struct d
 			assert(!rb_contains(&d_obj_rb, &dest_d->k_obj_rbnode));
 			
 			rb_insert(&d_obj_rb, &dest_d->k_obj_rbnode);
-			sys_dlist_insert(&src_d->k_obj_dlnode, &dest_d->k_obj_dlnode); //after insert and src is dest parent
+			sys_dlist_insert(src_d->k_obj_dlnode.next, &dest_d->k_obj_dlnode); //after insert and src is dest parent
 		}
 	}
 }
@@ -219,10 +220,11 @@ void d_object_move(struct k_object *new_k, struct d_object *src_d, struct d_obje
 		if (&dest_d->k_obj)
 		{
 			rb_remove(&d_obj_rb, &src_d->k_obj_rbnode);
-			sys_dlist_remove(&src_d->k_obj_dlnode);
-			
 			rb_insert(&d_obj_rb, &dest_d->k_obj_rbnode);
-			sys_dlist_insert(&src_d->k_obj_dlnode, &dest_d->k_obj_dlnode); //after insert
+
+			/* dest takes the place of src, before src is unlinked */
+			sys_dlist_insert(src_d->k_obj_dlnode.next, &dest_d->k_obj_dlnode); //after insert
+			sys_dlist_remove(&src_d->k_obj_dlnode);
 		}
 	}
 }
@@ -5,6 +5,7 @@
 #include <kernel/time.h>
 #include <state/statedata.h>
 #include <kernel/thread.h>
+#include <benchmark/stack_usage.h>
 
 #if defined(CONFIG_TICKLESS_IDLE_THRESH) 
 #define IDLE_THREAD_MIN_TICKS CONFIG_TICKLESS_IDLE_THRESH
@@ -160,6 +161,10 @@ void sys_set_power_and_idle_exit(word_t ticks)
 #endif
 
 	clock_idle_exit();
+#if defined(CONFIG_USER_KIP_PAGE)
+	/* every interrupt that wakes idle, also one the kernel does not service */
+	refresh_kip_clock();
+#endif
 }
 
 /* Any task switch caused by the arrival event can exit idle */
@@ -182,6 +187,8 @@ void idle_thread_entry(void *unused1, void *unused2, void *unused3)
 
 	while (true) 
 	{
+		stack_usage_idle();
+
 #if SMP_IPI_NOT_SUPPORT
 		thread_busy_wait(100);
 		clock_idle_exit();
@@ -7,6 +7,9 @@
 #include <api/errno.h>
 #include <state/statedata.h>
 #include <kernel/thread.h>
+#include <benchmark/thread_stats.h>
+#include <benchmark/wcet.h>
+#include <syscall_list.h>
 
 static s32_t privilege_thread_status[priv_end_priv]; 
 
@@ -64,8 +67,10 @@ privilege_retry:
 				switch (p_type)
 				{
 					case priv_fastipc_priv:
-						do_exchange_ipc(fastipc_caller.receive, fastipc_caller.send, 
+						do_exchange_ipc(fastipc_caller.caller, 
+							fastipc_caller.receive, fastipc_caller.send, 
 							fastipc_caller.timeout, fastipc_caller.anysend);
+						wcet_syscall_deferred_exit(K_SYSCALL_EXCHANGE_IPC);
 						
 						break;
 					case priv_health_monitor_priv:
@@ -89,6 +94,7 @@ privilege_retry:
 				goto privilege_retry;
 		}
 
+		thread_stats_voluntary(_current_thread);
 		reschedule_required();
 		schedule();
 		reschedule_unlocked();
@@ -14,6 +14,9 @@
 #include <sys/util.h>
 #include <sys/assert.h>
 #include <kernel/privilege.h>
+#include <linker/section_tags.h>
+#include <benchmark/sched_stats.h>
+#include <benchmark/thread_stats.h>
 
 /* time constants */
 #define MS_IN_S     1000u
@@ -33,7 +36,19 @@ extern struct ktcb main_thread;
              unlock_spin_unlock(lck, __key),\
              __i.key = 1)
 
+/* clzl() counts over an unsigned long, wider than word_t on LP64 */
+#define BITMAP_MSB(x)	(sizeof(unsigned long) * 8 - 1 - clzl(x))
+
 /* The sched_prior starts from 0, and the higher the number, the higher the sched_prior */
+#if SCHED_BITMAP_LEVELS == 1
+static inline prio_t get_highest_prio(word_t dom)
+{
+	/* it's undefined to call __CLZ on 0 */
+	assert(ready_queues_l1_bitmap[dom] != 0);
+
+	return BITMAP_MSB(ready_queues_l1_bitmap[dom]);
+}
+#else
 static inline prio_t get_highest_prio(word_t dom)
 {
 	word_t l1index;
@@ -43,15 +58,16 @@ static inline prio_t get_highest_prio(word_t dom)
 	/* it's undefined to call __CLZ on 0 */
 	assert(ready_queues_l1_bitmap[dom] != 0);
 
-	l1index = WORD_BITS - 1 - clzl(ready_queues_l1_bitmap[dom]); /* clzl ~ WORD_BITS */
+	l1index = BITMAP_MSB(ready_queues_l1_bitmap[dom]);
 	l1index_inverted = invert_l1index(l1index);
 
 	assert(ready_queues_l2_bitmap[dom][l1index_inverted] != 0);
 
-	l2index = WORD_BITS - 1 - clzl(ready_queues_l2_bitmap[dom][l1index_inverted]);
+	l2index = BITMAP_MSB(ready_queues_l2_bitmap[dom][l1index_inverted]);
 
 	return (l1index_to_prio(l1index) | l2index);
 }
+#endif
 
 static inline bool_t is_highest_prio(word_t dom, prio_t prio)
 {
@@ -340,7 +356,7 @@ static void switch_to_sc(void)
 }
 
 /** next_thread */
-struct ktcb *next_thread(void)
+__kernel_hot_text struct ktcb *next_thread(void)
 {
 	word_t prio;
 	word_t dom;
@@ -465,8 +481,10 @@ static void update_cache(struct ktcb *thread,  word_t preempt_ok)
 static void choose_new_thread(void)
 {
 	struct ktcb *new_thread;
+	u32_t start = sched_stats_cycle();
 
 	new_thread = next_thread();
+	sched_stats_record(sched_stats_next_thread, start);
 	
 	if (current_domain_time == 0) 
 	{
@@ -479,7 +497,7 @@ static void choose_new_thread(void)
 /** Centralized scheduling, so changing the ready cache task can only be performed 
     in the scheduler, and the rest is to update the ready queue */
 
-void schedule(void)
+__kernel_hot_text void schedule(void)
 {
 	awaken();
 	if (scheduler_action != SCHEDULER_ACTION_RESUME_CURRENT_THREAD) 
@@ -751,6 +769,7 @@ void set_current_thread(struct ktcb *thread)
 {
 	assert(thread != NULL);
 
+	thread_stats_switched_in(thread);
 	_current_thread   = thread;
 	
 	 /*
@@ -825,7 +844,16 @@ void charge_budget(ticks_t capacity, ticks_t consumed, bool_t canTimeoutFault)
 	{
 		/* capacity need set to 0 when not enough (consumed > amount)*/
 		/* capacity need set to no-0,when enough (consumed < amount )*/
+		u32_t start = sched_stats_cycle();
+
+		/* a round robin thread running out its timeslice is no overrun */
+		if (consumed > REFILL_HEAD(_current_thread->sched).refill_amount)
+		{
+			thread_stats_budget_overrun(_current_thread);
+		}
+
 		refill_budget_check(consumed, capacity);
+		sched_stats_record(sched_stats_refill_budget, start);
 	}
 
 	assert(REFILL_HEAD(_current_thread->sched).refill_amount >= MIN_BUDGET);
@@ -854,16 +882,37 @@ void update_timestamp(bool_t is_reset)
 	if (is_reset == true)
 	{
 		consume_time = 0;
+#if defined(CONFIG_SCHED_BUDGET_CYCLES)
+		consume_cycle = 0;
+#endif
 	}
 	else
 	{
 		/* _current_thread time always add */
 		ticks_t prev = current_time;
 		current_time = get_current_tick();
+#if defined(CONFIG_SCHED_BUDGET_CYCLES)
+		/* measure in cycles, charge whole ticks and carry the remainder */
+		u64_t prev_cycle = current_cycle_time;
+		u64_t cyc_per_tick = sys_clock_hw_cycles_per_sec() / CONFIG_SYS_CLOCK_TICKS_PER_SEC;
+
+		ARG_UNUSED(prev);
+		current_cycle_time = get_cycle_64();
+		if(is_time_sensitived(_current_thread))
+		{
+			consume_cycle += (current_cycle_time - prev_cycle);
+			consume_time  += consume_cycle / cyc_per_tick;
+			consume_cycle %= cyc_per_tick;
+		}
+#else
 		if(is_time_sensitived(_current_thread))
 		{
 			consume_time += (current_time - prev);
 		}
+#endif
+#if defined(CONFIG_USER_KIP_PAGE)
+		refresh_kip_clock();
+#endif
 	}
 }
 
@@ -1047,6 +1096,24 @@ void possible_switchto(struct ktcb *thread)
 	}
 }
 
+/* make thread the next one PendSV switches to, without a scheduling pass;
+   only used by direct interrupt delivery for a highest priority thread */
+void direct_switchto(struct ktcb *thread)
+{
+	LOCKED(&thread_swap_lock)
+	{
+		if (!is_thread_not_running(_current_thread) && 
+			!is_thread_queued(_current_thread) &&
+			!smp_idle_thread_object(_current_thread))
+		{
+			marktcb_as_queued(_current_thread);
+			sched_enqueue(_current_thread);
+		}
+
+		_kernel.ready_thread = thread;
+	}
+}
+
 /* awake process specials the release queue of thread , and need to add the released thread to sched queue 
    and set to candidate thread(also called timeout thread or other not sched ready thread) */
 /* each exec , all release thread */
@@ -15,6 +15,8 @@
 #include <object/ipc.h>
 #include <kernel/thread.h>
 #include <kernel/privilege.h>
+#include <object/kip.h>
+#include <sys/printk.h>
 
 /* SYSTIMER */
 /* para1:delay time;para2:timer handler;para3:thread */
@@ -39,6 +41,11 @@ static spinlock_t time_lock;
 /* timer event list */
 static timer_list_t timer_event_list = SYS_DLIST_STATIC_INIT(&timer_event_list);
 
+#if defined(CONFIG_SYSTEM_CLOCK_SUBTICK_DEADLINE)
+/* cycle event list, sorted by absolute deadline */
+static timer_list_t cycle_event_list = SYS_DLIST_STATIC_INIT(&cycle_event_list);
+#endif
+
 /* timer global var */
 static uint64_t current_tick = 0;   /* timer _current_thread tick value */
 /* such as in the same time period, create multiple timer events,need elapsing "create process time" */
@@ -50,6 +57,26 @@ static word_t dvalue_elapse  = 0;   /* dvalue of next_node event elapse - dvalue
 s32_t clock_hw_cycles_per_sec = CONFIG_SYS_CLOCK_HW_CYCLES_PER_SEC;
 #endif
 
+/* The value system_clock() reports */
+static dword_t system_clock_now(void)
+{
+#if defined(CONFIG_SYSTEM_CLOCK_CYCLES_64)
+	return get_cycle_64();
+#else
+	return k_ticks_to_cyc_floor64(get_current_tick());
+#endif
+}
+
+#if defined(CONFIG_USER_KIP_PAGE)
+/* Republish the user readable clock. Done on every kernel entry, the
+ * timer announcement included, and when an interrupt ends idle, so the
+ * snapshot is as old as the last time the kernel ran. */
+void refresh_kip_clock(void)
+{
+	update_kip_clock(system_clock_now(), get_current_tick());
+}
+#endif
+
 static struct timer_event *first_node(void)
 {
 	sys_dnode_t *to = sys_dlist_peek_head(&timer_event_list);
@@ -81,6 +108,57 @@ static s32_t next_dvalue(void)
 	return (to == NULL) ? MAX_WAIT : MAX(0, to->dvalue - ticks_elapsed);
 }
 
+#if defined(CONFIG_TIMER_SLACK)
+/* timer interrupts avoided by firing several deadlines at once */
+static word_t timer_irqs_saved;
+/* the tick a batch was last programmed to expire at, 0 if the head
+ * event was not moved by its slack */
+static u64_t slack_fire_tick;
+
+/* Like next_dvalue(), but delay the head event within its slack as long
+ * as that lets later events expire in the same interrupt. The result is
+ * the last deadline of the batch, so every batched event is due and none
+ * is later than its own slack allows.
+ */
+static s32_t next_fire_dvalue(void)
+{
+	struct timer_event *to = first_node();
+	s32_t deadline;
+	s32_t latest;
+
+	if (to == NULL || to->slack == 0)
+	{
+		slack_fire_tick = 0;
+		return next_dvalue();
+	}
+
+	deadline = to->dvalue;
+	latest   = to->dvalue + to->slack;
+
+	for (to = next_node(to); to != NULL; to = next_node(to))
+	{
+		if (deadline + (s32_t)to->dvalue > latest)
+		{
+			break;
+		}
+
+		deadline += to->dvalue;
+		latest = MIN(latest, deadline + (s32_t)to->slack);
+	}
+
+	slack_fire_tick = (deadline > first_node()->dvalue) ? current_tick + deadline : 0;
+
+	return MAX(0, deadline - elapsed_dvalue());
+}
+
+word_t get_timer_irqs_saved(void)
+{
+	return timer_irqs_saved;
+}
+#else
+#define next_fire_dvalue() next_dvalue()
+#endif
+
 void add_to_timelist(struct timer_event *to, timer_handler_t handler, generptr_t data,
 	s32_t ticks)
 {
@@ -115,7 +193,7 @@ void add_to_timelist(struct timer_event *to, timer_handler_t handler, generptr_t
 	
 			if (to == first_node()) 
 			{
-				clock_set_timeout(next_dvalue(), false);
+				clock_set_timeout(next_fire_dvalue(), false);
 			}
 		}
 	}
@@ -216,7 +294,7 @@ s32_t get_next_timelist(void)
 
 	LOCKED(&time_lock) 
 	{
-		ret = next_dvalue();
+		ret = next_fire_dvalue();
 	}
 	
 	return ret;
@@ -226,7 +304,7 @@ void set_next_timelist(s32_t ticks, bool_t idle)
 {
 	LOCKED(&time_lock) 
 	{
-		s32_t next_node =   next_dvalue();
+		s32_t next_node =   next_fire_dvalue();
 		bool_t  sooner     =  (next_node == MAX_WAIT) || (ticks < next_node);
 		bool_t  imminent   =  next_node <= 1;
 
@@ -252,6 +330,10 @@ void update_timelist(s32_t ticks)
 {
 	LOCKED(&time_lock)
 	{
+#if defined(CONFIG_TIMER_SLACK)
+		u64_t fire_tick = current_tick + ticks;
+		u64_t last_moved = 0;
+#endif
 		dvalue_elapse = ticks;
 		
 		/* deadline ticks part */
@@ -261,6 +343,18 @@ void update_timelist(s32_t ticks)
 			s32_t dvalue  =  index->dvalue;
 			word_t period;
 
+#if defined(CONFIG_TIMER_SLACK)
+			/* an expiry held back to the batch deadline, and that
+			 * batch did fire, would have been an interrupt of its own */
+			if (slack_fire_tick != 0 && fire_tick >= slack_fire_tick &&
+				current_tick + dvalue < slack_fire_tick &&
+				current_tick + dvalue != last_moved)
+			{
+				last_moved = current_tick + dvalue;
+				timer_irqs_saved++;
+			}
+#endif
+
 			current_tick	+= dvalue;
 			dvalue_elapse -= dvalue;
 
@@ -291,7 +385,7 @@ void update_timelist(s32_t ticks)
 	
 		current_tick += dvalue_elapse;
 		dvalue_elapse = 0;
-		clock_set_timeout(next_dvalue(), false);
+		clock_set_timeout(next_fire_dvalue(), false);
 		update_timestamp(false); 
 	}
 }
@@ -353,12 +447,24 @@ static word_t deadline_timeout_handler(generptr_t data)
 }
 
 void set_deadline(ticks_t deadline, word_t *deadline_gid)
+{
+	set_deadline_slack(deadline, deadline_gid, 0);
+}
+
+/* A deadline that may expire up to slack ticks late, for timeouts the
+ * thread asked for. Scheduler deadlines go through set_deadline(). */
+void set_deadline_slack(ticks_t deadline, word_t *deadline_gid, word_t slack)
 {
 	struct timer_event *new_timer_event = (struct timer_event *)d_object_alloc(obj_time_obj, 0);
 
 	if (new_timer_event != NULL)
 	{
 		initialize_timelist(new_timer_event);
+#if defined(CONFIG_TIMER_SLACK)
+		new_timer_event->slack = slack;
+#else
+		ARG_UNUSED(slack);
+#endif
 		
 		if (!deadline)
 		{
@@ -377,6 +483,99 @@ u64_t get_uptime_64(void)
 	return k_ticks_to_ms_floor64(get_current_tick());
 }
 
+#if defined(CONFIG_SYSTEM_CLOCK_SUBTICK_DEADLINE)
+static struct cycle_event *first_cycle_node(void)
+{
+	sys_dnode_t *ce = sys_dlist_peek_head(&cycle_event_list);
+
+	return (ce == NULL) ? NULL : CONTAINER_OF(ce, struct cycle_event, index);
+}
+
+static void insert_cycle_timelist(struct cycle_event *ce)
+{
+	struct cycle_event *index;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&cycle_event_list, index, index)
+	{
+		if (ce->deadline < index->deadline)
+		{
+			sys_dlist_insert(&index->index, &ce->index);
+			return;
+		}
+	}
+
+	sys_dlist_append(&cycle_event_list, &ce->index);
+}
+
+/* Arm a timer event at an absolute cycle count, below tick resolution */
+void add_to_cycle_timelist(struct cycle_event *ce, timer_handler_t handler, generptr_t data,
+	u64_t deadline)
+{
+	assert(ce != NULL && deadline != 0);
+
+	LOCKED(&time_lock)
+	{
+		ce->deadline = deadline;
+		ce->handler  = handler;
+		ce->data     = data;
+
+		insert_cycle_timelist(ce);
+		if (first_cycle_node() == ce)
+		{
+			clock_set_deadline_cycles(deadline);
+		}
+	}
+}
+
+void remove_from_cycle_timelist(struct cycle_event *ce)
+{
+	if (ce != NULL && sys_dnode_is_linked(&ce->index))
+	{
+		LOCKED(&time_lock)
+		{
+			bool_t was_first = (first_cycle_node() == ce);
+
+			sys_dlist_remove(&ce->index);
+			if (was_first)
+			{
+				struct cycle_event *next = first_cycle_node();
+
+				clock_set_deadline_cycles((next == NULL) ? 0 : next->deadline);
+			}
+		}
+	}
+}
+
+/* Called by the timer driver once the armed cycle deadline has passed */
+void update_cycle_timelist(u64_t now)
+{
+	LOCKED(&time_lock)
+	{
+		struct cycle_event *index;
+
+		while ((index = first_cycle_node()) != NULL && index->deadline <= now)
+		{
+			word_t period = 0;
+
+			sys_dlist_remove(&index->index);
+			if (index->handler != NULL)
+			{
+				period = index->handler(index->data);
+			}
+
+			if (period != 0)
+			{
+				index->deadline += period;
+				insert_cycle_timelist(index);
+			}
+		}
+
+		index = first_cycle_node();
+		clock_set_deadline_cycles((index == NULL) ? 0 : index->deadline);
+	}
+}
+#endif
+
 exception_t syscall_system_clock(dword_t *clock)
 {
 
@@ -398,7 +597,7 @@ exception_t syscall_system_clock(dword_t *clock)
 #if defined(CONFIG_USERSPACE) 
 #endif
 	
-		*clock = sys_clock_hw_cycles_per_sec();
+		*clock = system_clock_now();
 	
 	
 		schedule();
@@ -412,6 +611,36 @@ exception_t syscall_system_clock(dword_t *clock)
 
 }
 
+#if defined(CONFIG_TIMER_SLACK)
+exception_t syscall_timer_slack_print(word_t reset)
+{
+	bool_t is_sufficient = false;
+
+	update_timestamp(false);
+	is_sufficient = check_budget_restart();
+
+	if (is_sufficient)
+	{
+		spinlock_key_t key = lock_spin_lock(&time_lock);
+		word_t saved = timer_irqs_saved;
+
+		if (reset)
+		{
+			timer_irqs_saved = 0;
+		}
+		unlock_spin_unlock(&time_lock, key);
+
+		printk("timer irqs saved by slack: %u\n", (u32_t)saved);
+
+		schedule();
+		/* reschedule_unlocked(); */
+		return EXCEPTION_NONE;
+	}
+
+	return EXCEPTION_FAULT;
+}
+#endif
+
 void init_time_object(void)
 {
 	clock_init();
@@ -0,0 +1,333 @@
+#include <sys/string.h>
+#include <sys/assert.h>
+#include <sys/tlsf.h>
+#include <sys/errno.h>
+#include <arch/ffs.h>
+
+#define TLSF_BLOCK_FREE 	BIT(0)
+
+/* prev_phys and size are always present, the free links overlay the payload */
+#define TLSF_BLOCK_HEADER 	offsetof(struct sys_tlsf_block, next_free)
+#define TLSF_BLOCK_MIN 		(sizeof(struct sys_tlsf_block) - TLSF_BLOCK_HEADER)
+
+static FORCE_INLINE size_t block_size(const struct sys_tlsf_block *b)
+{
+	return b->size & ~(size_t)(TLSF_ALIGN - 1);
+}
+
+static FORCE_INLINE bool_t block_is_free(const struct sys_tlsf_block *b)
+{
+	return (b->size & TLSF_BLOCK_FREE) != 0;
+}
+
+static FORCE_INLINE void *block_to_ptr(struct sys_tlsf_block *b)
+{
+	return (byte_t *)b + TLSF_BLOCK_HEADER;
+}
+
+static FORCE_INLINE struct sys_tlsf_block *ptr_to_block(void *ptr)
+{
+	return (struct sys_tlsf_block *)((byte_t *)ptr - TLSF_BLOCK_HEADER);
+}
+
+static FORCE_INLINE struct sys_tlsf_block *block_next(struct sys_tlsf_block *b)
+{
+	return (struct sys_tlsf_block *)((byte_t *)block_to_ptr(b) + block_size(b));
+}
+
+/* The first level is the most significant bit of the size, the second level
+ * the next TLSF_SL_LOG2 bits. Sizes below TLSF_SMALL_BLOCK all live in the
+ * first row, split linearly by TLSF_ALIGN.
+ */
+static FORCE_INLINE void mapping_insert(size_t size, u32_t *fl, u32_t *sl)
+{
+	if (size < TLSF_SMALL_BLOCK)
+	{
+		*fl = 0;
+		*sl = size >> TLSF_ALIGN_LOG2;
+	}
+	else
+	{
+		u32_t msb = find_msb_set(size) - 1;
+
+		*sl = (size >> (msb - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT;
+		*fl = msb - (TLSF_FL_SHIFT - 1);
+	}
+}
+
+/* Round the request up to the next list boundary, so every block of the
+ * list found is large enough and no list has to be walked.
+ */
+static FORCE_INLINE void mapping_search(size_t size, u32_t *fl, u32_t *sl)
+{
+	if (size >= TLSF_SMALL_BLOCK)
+	{
+		size += BIT(find_msb_set(size) - 1 - TLSF_SL_LOG2) - 1;
+	}
+
+	mapping_insert(size, fl, sl);
+}
+
+static struct sys_tlsf_block *search_suitable(struct sys_tlsf_pool *p, u32_t *fl, u32_t *sl)
+{
+	u32_t sl_map, fl_map;
+
+	if (*fl >= TLSF_FL_COUNT)
+	{
+		return NULL;
+	}
+
+	sl_map = p->sl_bitmap[*fl] & (~0U << *sl);
+	if (!sl_map)
+	{
+		fl_map = p->fl_bitmap & (~0U << (*fl + 1));
+		if (!fl_map)
+		{
+			return NULL;
+		}
+
+		*fl = find_lsb_set(fl_map) - 1;
+		sl_map = p->sl_bitmap[*fl];
+	}
+
+	*sl = find_lsb_set(sl_map) - 1;
+
+	return p->blocks[*fl][*sl];
+}
+
+static void remove_free(struct sys_tlsf_pool *p, struct sys_tlsf_block *b, u32_t fl, u32_t sl)
+{
+	struct sys_tlsf_block *prev = b->prev_free;
+	struct sys_tlsf_block *next = b->next_free;
+
+	if (next)
+	{
+		next->prev_free = prev;
+	}
+
+	if (prev)
+	{
+		prev->next_free = next;
+	}
+
+	if (p->blocks[fl][sl] == b)
+	{
+		p->blocks[fl][sl] = next;
+		if (!next)
+		{
+			p->sl_bitmap[fl] &= ~BIT(sl);
+			if (!p->sl_bitmap[fl])
+			{
+				p->fl_bitmap &= ~BIT(fl);
+			}
+		}
+	}
+
+	b->size &= ~(size_t)TLSF_BLOCK_FREE;
+}
+
+static void block_remove(struct sys_tlsf_pool *p, struct sys_tlsf_block *b)
+{
+	u32_t fl, sl;
+
+	mapping_insert(block_size(b), &fl, &sl);
+	remove_free(p, b, fl, sl);
+}
+
+static void block_insert(struct sys_tlsf_pool *p, struct sys_tlsf_block *b)
+{
+	struct sys_tlsf_block *head;
+	u32_t fl, sl;
+
+	mapping_insert(block_size(b), &fl, &sl);
+
+	head = p->blocks[fl][sl];
+	b->next_free = head;
+	b->prev_free = NULL;
+	if (head)
+	{
+		head->prev_free = b;
+	}
+
+	p->blocks[fl][sl] = b;
+	p->fl_bitmap |= BIT(fl);
+	p->sl_bitmap[fl] |= BIT(sl);
+
+	b->size |= TLSF_BLOCK_FREE;
+}
+
+static FORCE_INLINE sword_t pool_irq_lock(struct sys_tlsf_pool *p)
+{
+	if (p->flag & SYS_MEM_POOL_KERNEL) 
+	{
+		return irq_lock();
+	} 
+	else
+	{
+		return 0;
+	}
+}
+
+static FORCE_INLINE void pool_irq_unlock(struct sys_tlsf_pool *p, sword_t key)
+{
+	if (p->flag & SYS_MEM_POOL_KERNEL)
+	{
+		irq_unlock(key);
+	}
+}
+
+void sys_tlsf_pool_init(struct sys_tlsf_pool *p)
+{
+	struct sys_tlsf_block *b;
+	struct sys_tlsf_block *sentinel;
+	size_t size = ROUND_DOWN(p->size, TLSF_ALIGN);
+
+	assert(((uintptr_t)p->buf & (TLSF_ALIGN - 1)) == 0);
+	assert(size < SYS_TLSF_MAX_POOL_SIZE);
+	assert(size >= 2 * TLSF_BLOCK_HEADER + TLSF_BLOCK_MIN);
+
+	p->fl_bitmap = 0;
+	(void)memset(p->sl_bitmap, 0, sizeof(p->sl_bitmap));
+	(void)memset(p->blocks, 0, sizeof(p->blocks));
+	p->used_bytes = 0;
+	p->max_used_bytes = 0;
+
+	/* one free block covering the pool, closed by a used zero size block */
+	b = p->buf;
+	b->prev_phys = NULL;
+	b->size = size - 2 * TLSF_BLOCK_HEADER;
+
+	sentinel = block_next(b);
+	sentinel->prev_phys = b;
+	sentinel->size = 0;
+
+	block_insert(p, b);
+}
+
+sword_t sys_tlsf_block_alloc(struct sys_tlsf_pool *p, size_t size,
+			      u32_t *level_p, u32_t *block_p, void **data_p)
+{
+	struct sys_tlsf_block *b;
+	struct sys_tlsf_block *rest;
+	size_t adjust;
+	u32_t fl, sl;
+	sword_t key;
+
+	*data_p = NULL;
+
+	if (size == 0 || size >= SYS_TLSF_MAX_POOL_SIZE)
+	{
+		return -ENOMEM;
+	}
+
+	adjust = MAX(ROUND_UP(size, TLSF_ALIGN), TLSF_BLOCK_MIN);
+	mapping_search(adjust, &fl, &sl);
+
+	key = pool_irq_lock(p);
+
+	b = search_suitable(p, &fl, &sl);
+	if (!b)
+	{
+		pool_irq_unlock(p, key);
+		return -ENOMEM;
+	}
+
+	remove_free(p, b, fl, sl);
+
+	/* give the tail back if it can hold a block of its own */
+	if (block_size(b) >= adjust + TLSF_BLOCK_HEADER + TLSF_BLOCK_MIN)
+	{
+		rest = (struct sys_tlsf_block *)((byte_t *)block_to_ptr(b) + adjust);
+		rest->size = block_size(b) - adjust - TLSF_BLOCK_HEADER;
+		rest->prev_phys = b;
+		block_next(rest)->prev_phys = rest;
+		b->size = adjust;
+
+		block_insert(p, rest);
+	}
+
+	p->used_bytes += block_size(b);
+	if (p->used_bytes > p->max_used_bytes)
+	{
+		p->max_used_bytes = p->used_bytes;
+	}
+
+	pool_irq_unlock(p, key);
+
+	*data_p = block_to_ptr(b);
+	*level_p = 0;
+	*block_p = ((byte_t *)*data_p - (byte_t *)p->buf) >> TLSF_ALIGN_LOG2;
+
+	return 0;
+}
+
+void sys_tlsf_block_free(struct sys_tlsf_pool *p, u32_t level, u32_t block)
+{
+	struct sys_tlsf_block *b;
+	struct sys_tlsf_block *prev;
+	struct sys_tlsf_block *next;
+	sword_t key;
+
+	ARG_UNUSED(level);
+
+	b = ptr_to_block((byte_t *)p->buf + (block << TLSF_ALIGN_LOG2));
+
+	key = pool_irq_lock(p);
+
+	assert(!block_is_free(b));
+	p->used_bytes -= block_size(b);
+
+	/* free blocks are never physical neighbours, so at most two merges */
+	prev = b->prev_phys;
+	if (prev && block_is_free(prev))
+	{
+		block_remove(p, prev);
+		prev->size = block_size(prev) + TLSF_BLOCK_HEADER + block_size(b);
+		b = prev;
+		block_next(b)->prev_phys = b;
+	}
+
+	next = block_next(b);
+	if (block_is_free(next))
+	{
+		block_remove(p, next);
+		b->size = block_size(b) + TLSF_BLOCK_HEADER + block_size(next);
+		block_next(b)->prev_phys = b;
+	}
+
+	block_insert(p, b);
+
+	pool_irq_unlock(p, key);
+}
+
+/* walks every block, for diagnostics only, never on the allocation path */
+void sys_tlsf_pool_stats_get(struct sys_tlsf_pool *p, struct sys_tlsf_stats *stats)
+{
+	struct sys_tlsf_block *b;
+	sword_t key;
+
+	(void)memset(stats, 0, sizeof(*stats));
+	stats->total_bytes = ROUND_DOWN(p->size, TLSF_ALIGN);
+
+	key = pool_irq_lock(p);
+
+	stats->used_bytes = p->used_bytes;
+	stats->max_used_bytes = p->max_used_bytes;
+
+	for (b = p->buf; block_size(b) != 0; b = block_next(b))
+	{
+		if (block_is_free(b))
+		{
+			stats->free_bytes += block_size(b);
+			stats->free_blocks++;
+			stats->largest_free = MAX(stats->largest_free, block_size(b));
+		}
+	}
+
+	pool_irq_unlock(p, key);
+
+	if (stats->free_bytes)
+	{
+		stats->fragmentation = 100 - (stats->largest_free * 100) / stats->free_bytes;
+	}
+}
@@ -185,12 +185,12 @@ void add_to_page_table(struct thread_page *page_item, struct ktcb *thread)
 {
 	assert_info(page_item != NULL, "");
 	assert_info(thread != NULL, "");
-	/* assert_info(thread->userspace_fpage_table.pagetable_item == NULL, "mem page_item unset"); */
+	/* assert_info(thread->cold.userspace_fpage_table.pagetable_item == NULL, "mem page_item unset"); */
 
 	LOCKED(&space_lock)
 	{
-		sys_dlist_append(&page_item->pagetable_list, &thread->userspace_fpage_table.pagetable_node);
-		thread->userspace_fpage_table.pagetable_item = page_item;
+		sys_dlist_append(&page_item->pagetable_list, &thread->cold.userspace_fpage_table.pagetable_node);
+		thread->cold.userspace_fpage_table.pagetable_item = page_item;
 		arm_core_page_table_add(thread);
 	}
 }
@@ -198,13 +198,13 @@ void add_to_page_table(struct thread_page *page_item, struct ktcb *thread)
 void remove_from_page_table(struct ktcb *thread)
 {
 	assert_info(thread != NULL, "");
-	assert_info(thread->userspace_fpage_table.pagetable_item != NULL, "mem page_item set");
+	assert_info(thread->cold.userspace_fpage_table.pagetable_item != NULL, "mem page_item set");
 
 	LOCKED(&space_lock)
 	{
 		arm_core_page_table_remove(thread);
-		sys_dlist_remove(&thread->userspace_fpage_table.pagetable_node);
-		thread->userspace_fpage_table.pagetable_item = NULL;
+		sys_dlist_remove(&thread->cold.userspace_fpage_table.pagetable_node);
+		thread->cold.userspace_fpage_table.pagetable_item = NULL;
 	}
 }
 
@@ -219,9 +219,9 @@ void remove_from_page_table_of(struct thread_page *page_item)
 		arm_core_page_destroy(page_item);
 		SYS_DLIST_FOR_EACH_NODE_SAFE(&page_item->pagetable_list, pagetable_node, next_table_node) 
 		{
-			struct ktcb *thread = CONTAINER_OF(pagetable_node, struct ktcb, userspace_fpage_table);
-			sys_dlist_remove(&thread->userspace_fpage_table.pagetable_node);
-			thread->userspace_fpage_table.pagetable_item = NULL;
+			struct ktcb *thread = CONTAINER_OF(pagetable_node, struct ktcb, cold.userspace_fpage_table);
+			sys_dlist_remove(&thread->cold.userspace_fpage_table.pagetable_node);
+			thread->cold.userspace_fpage_table.pagetable_item = NULL;
 		}
 	}
 }
@@ -238,20 +238,20 @@ exception_t do_guard_page(struct ktcb *s_thread,
 	switch (right)
 	{
 		/* na */
-		case 0x0:
+		case PAGE_RIGHT_NA:
 			right_attr = MEM_PARTITION_P_RW_U_NA;
 			break;
 		/* ro */
-		case 0x4:
+		case PAGE_RIGHT_RO:
 			/* v8 not support */
 			right_attr = MEM_PARTITION_P_RW_U_RO;
 			break;	
 		/* rw */
-		case 0x6:
+		case PAGE_RIGHT_RW:
 			right_attr = MEM_PARTITION_P_RW_U_RW;
 			break;
 		/* rwx */
-		case 0x7:
+		case PAGE_RIGHT_RWX:
 			right_attr = MEM_PARTITION_P_RWX_U_RWX;
 			break;
 		default:
@@ -266,9 +266,9 @@ exception_t do_guard_page(struct ktcb *s_thread,
 	};
 
 	struct thread_page *s_page = 
-		s_thread->userspace_fpage_table.pagetable_item;
+		s_thread->cold.userspace_fpage_table.pagetable_item;
 	struct thread_page *d_page = 
-		d_thread->userspace_fpage_table.pagetable_item;
+		d_thread->cold.userspace_fpage_table.pagetable_item;
 
 	if (s_page)
 	{
@@ -302,20 +302,20 @@ exception_t do_map_page(struct ktcb *thread,
 	switch (right)
 	{
 		/* na */
-		case 0x0:
+		case PAGE_RIGHT_NA:
 			right_attr = MEM_PARTITION_P_RW_U_NA;
 			break;
 		/* ro */
-		case 0x4:
+		case PAGE_RIGHT_RO:
 			/* v8 not support */
 			right_attr = MEM_PARTITION_P_RW_U_RO;
 			break;	
 		/* rw */
-		case 0x6:
+		case PAGE_RIGHT_RW:
 			right_attr = MEM_PARTITION_P_RW_U_RW;
 			break;
 		/* rwx */
-		case 0x7:
+		case PAGE_RIGHT_RWX:
 			right_attr = MEM_PARTITION_P_RWX_U_RWX;
 			break;
 		default:
@@ -330,7 +330,7 @@ exception_t do_map_page(struct ktcb *thread,
 	};
 		
 	struct thread_page *page = 
-		thread->userspace_fpage_table.pagetable_item;
+		thread->cold.userspace_fpage_table.pagetable_item;
 
 	if (!page)
 	{
@@ -350,7 +350,7 @@ exception_t do_map_page(struct ktcb *thread,
 
 exception_t do_unmap_page(struct ktcb *thread)
 {
-	d_object_free(thread->userspace_fpage_table.pagetable_item);
+	d_object_free(thread->cold.userspace_fpage_table.pagetable_item);
 	remove_from_page_table(thread);
 
 	return EXCEPTION_NONE;
@@ -366,7 +366,7 @@ exception_t do_map_string(struct ktcb *thread,
 		.size = len
 	};
 	struct thread_page *page = 
-		thread->userspace_fpage_table.pagetable_item;
+		thread->cold.userspace_fpage_table.pagetable_item;
 	
 	if (!page)
 	{
@@ -0,0 +1,247 @@
+#include <types_def.h>
+#include <object/batch.h>
+#include <object/untyped.h>
+#include <object/objecttype.h>
+#include <object/cnode.h>
+#include <object/anode.h>
+#include <kernel/cspace.h>
+#include <kernel/thread.h>
+#include <state/statedata.h>
+#include <api/syscall.h>
+#include <api/errno.h>
+#include <model/preemption.h>
+#include <sys/util.h>
+
+BUILD_ASSERT_MSG((BATCH_RING_ENTRIES & BATCH_RING_MASK) == 0,
+	"CONFIG_SYSCALL_BATCH_ENTRIES must be a power of two");
+
+/* Each handler runs one submission through the same kernel helper the
+ * single syscall uses, without the per call timestamp, budget check and
+ * scheduler pass, which batch_submit() does once for the whole batch.
+ * A handler reports a failed entry in its completion and never fails
+ * the batch, except for EXCEPTION_PREEMPTED.
+ */
+static exception_t batch_dobject_alloc(struct batch_sqe *sqe, struct batch_cqe *cqe)
+{
+	enum obj_tag otype = (enum obj_tag)sqe->arg[0];
+	void *obj;
+
+	if (otype <= obj_any_obj || otype >= obj_last_obj ||
+		(otype == obj_untyped_obj && sqe->arg[1] == 0))
+	{
+		current_syscall_error_code = TCR_INVAL_PARA;
+		return EXCEPTION_SYSCALL_ERROR;
+	}
+
+	obj = d_object_alloc(otype, sqe->arg[1]);
+	if (!obj)
+	{
+		current_syscall_error_code = TCR_OUT_OF_MEM;
+		return EXCEPTION_SYSCALL_ERROR;
+	}
+
+	cqe->result = (word_t)obj;
+	return EXCEPTION_NONE;
+}
+
+static exception_t batch_dobject_free(struct batch_sqe *sqe, struct batch_cqe *cqe)
+{
+	void *obj = (void *)sqe->arg[0];
+	struct d_object *d_obj = obj ? d_object_find(obj) : NULL;
+
+	ARG_UNUSED(cqe);
+
+	/* an untyped is only freed once everything carved from it is */
+	if (!d_obj || (d_obj->k_obj.type == obj_untyped_obj && untyped_has_children(d_obj)))
+	{
+		current_syscall_error_code = TCR_INVAL_PARA;
+		return EXCEPTION_SYSCALL_ERROR;
+	}
+
+	d_object_free(obj);
+	return EXCEPTION_NONE;
+}
+
+static exception_t batch_retype_untyped(struct batch_sqe *sqe, struct batch_cqe *cqe)
+{
+	struct d_object *src = d_object_find((void *)sqe->arg[0]);
+	enum obj_tag user_type = (enum obj_tag)sqe->arg[1];
+	void *obj = NULL;
+	exception_t status;
+
+	if (user_type >= obj_last_obj || user_type == obj_untyped_obj)
+	{
+		current_syscall_error_code = TCR_INVAL_PARA;
+		return EXCEPTION_SYSCALL_ERROR;
+	}
+
+	if (src == NULL || src->k_obj.type != obj_untyped_obj)
+	{
+		current_syscall_error_code = TCR_INVAL_PARA;
+		return EXCEPTION_SYSCALL_ERROR;
+	}
+
+	/* clearing is preemptible, a restart resumes from region->zeroed */
+	status = retype_untyped_bulk_object(src, user_type, sqe->arg[2], 1, &obj);
+	if (status == EXCEPTION_NONE)
+	{
+		cqe->result = (word_t)obj;
+	}
+
+	return status;
+}
+
+static exception_t batch_unmap_page(struct batch_sqe *sqe, struct batch_cqe *cqe)
+{
+	ARG_UNUSED(cqe);
+	/* the control word is not used by unmap_page yet either */
+	ARG_UNUSED(sqe);
+
+#if defined(CONFIG_USERSPACE)
+	return do_unmap_page(_current_thread);
+#else
+	current_syscall_error_code = TCR_INVAL_PARA;
+	return EXCEPTION_SYSCALL_ERROR;
+#endif
+}
+
+static exception_t batch_kobject_access_grant(struct batch_sqe *sqe, struct batch_cqe *cqe)
+{
+	void *object = (void *)sqe->arg[0];
+	struct ktcb *thread = (struct ktcb *)sqe->arg[1];
+
+	ARG_UNUSED(cqe);
+
+#if defined(CONFIG_USERSPACE)
+	if (obj_validation_check(k_object_find(thread), thread, obj_thread_obj) != 0)
+	{
+		current_syscall_error_code = TCR_INVAL_THREAD;
+		return EXCEPTION_SYSCALL_ERROR;
+	}
+
+	/* only pass on access the caller holds itself */
+	if (validate_any_k_object(object, _current_thread) == NULL)
+	{
+		current_syscall_error_code = TCR_NO_PRIVILIGE;
+		return EXCEPTION_SYSCALL_ERROR;
+	}
+#endif
+
+	do_kobject_access_grant(object, thread);
+	return EXCEPTION_NONE;
+}
+
+typedef exception_t (*batch_handler_t)(struct batch_sqe *sqe, struct batch_cqe *cqe);
+
+static const batch_handler_t batch_handlers[batch_last_op] = {
+	[batch_nop_op] = NULL,
+	[batch_dobject_alloc_op] = batch_dobject_alloc,
+	[batch_dobject_free_op] = batch_dobject_free,
+	[batch_retype_untyped_op] = batch_retype_untyped,
+	[batch_unmap_page_op] = batch_unmap_page,
+	[batch_kobject_access_grant_op] = batch_kobject_access_grant,
+};
+
+static exception_t batch_process(struct batch_ring *ring)
+{
+	word_t sq_head = ring->sq_head;
+	word_t cq_tail = ring->cq_tail;
+	struct batch_sqe sqe;
+	struct batch_cqe cqe;
+	exception_t status;
+
+	while (sq_head != *(volatile word_t *)&ring->sq_tail &&
+		cq_tail - *(volatile word_t *)&ring->cq_head < BATCH_RING_ENTRIES)
+	{
+		/* the caller may rewrite the entry at any time, work on a copy */
+		compiler_barrier();
+		sqe = ring->sqes[sq_head & BATCH_RING_MASK];
+
+		cqe.user_data = sqe.user_data;
+		cqe.result = 0;
+		cqe.error = 0;
+
+		current_syscall_error_code = 0;
+		if (sqe.op >= batch_last_op)
+		{
+			current_syscall_error_code = TCR_INVAL_PARA;
+			status = EXCEPTION_SYSCALL_ERROR;
+		}
+		else if (batch_handlers[sqe.op] == NULL)
+		{
+			status = EXCEPTION_NONE;
+		}
+		else
+		{
+			status = batch_handlers[sqe.op](&sqe, &cqe);
+		}
+
+		/* not consumed, the restarted call runs this entry again */
+		if (status == EXCEPTION_PREEMPTED)
+		{
+			return status;
+		}
+
+		cqe.status = status;
+		if (status != EXCEPTION_NONE)
+		{
+			cqe.error = current_syscall_error_code;
+		}
+
+		ring->cqes[cq_tail & BATCH_RING_MASK] = cqe;
+		compiler_barrier();
+		*(volatile word_t *)&ring->cq_tail = ++cq_tail;
+		*(volatile word_t *)&ring->sq_head = ++sq_head;
+
+		status = preemption_point();
+		if (status != EXCEPTION_NONE)
+		{
+			return status;
+		}
+	}
+
+	return EXCEPTION_NONE;
+}
+
+exception_t syscall_batch_submit(void *ring, word_t size)
+{
+	bool_t is_sufficient = false;
+
+	update_timestamp(false);
+	is_sufficient = check_budget_restart();
+
+	if (is_sufficient)
+	{
+		exception_t status;
+
+		if (!ring || size < sizeof(struct batch_ring) ||
+			((word_t)ring & (sizeof(word_t) - 1)) != 0)
+		{
+			user_error("Batch Object: Invalid ring region.");
+			current_syscall_error_code = TCR_INVAL_PARA;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+
+#if defined(CONFIG_USERSPACE)
+		if (SYSCALL_MEMORY_WRITE(ring, sizeof(struct batch_ring)))
+		{
+			user_error("Batch Object: Illegal operation attempted.");
+			current_syscall_error_code = TCR_INVAL_PARA;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+#endif
+
+		set_thread_state(_current_thread, state_restart_state);
+		status = batch_process(ring);
+		if (status != EXCEPTION_NONE)
+		{
+			return status;
+		}
+
+		schedule();
+		/* reschedule_unlocked(); */
+
+		return EXCEPTION_NONE;
+	}
+	return EXCEPTION_FAULT;
+}
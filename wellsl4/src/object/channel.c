@@ -0,0 +1,195 @@
+#include <types_def.h>
+#include <object/channel.h>
+#include <object/ipc.h>
+#include <object/tcb.h>
+#include <object/anode.h>
+#include <object/objecttype.h>
+#include <kernel/cspace.h>
+#include <kernel/thread.h>
+#include <state/statedata.h>
+#include <api/syscall.h>
+#include <api/errno.h>
+#include <model/spinlock.h>
+#include <sys/assert.h>
+#include <sys/util.h>
+
+static spinlock_t channel_lock;       /* channel doorbell */
+
+#define LOCKED(lck) \
+		for (spinlock_key_t __i = {},	\
+		     __key = lock_spin_lock(lck);	\
+		     !__i.key;					\
+             unlock_spin_unlock(lck, __key),\
+             __i.key = 1)
+
+/* region must be a natural aligned power of two, so one page entry covers it */
+static bool_t is_channel_region_vaild(word_t base, word_t size)
+{
+	if (size < CHANNEL_REGION_MIN_SIZE || !is_power_of_two(size))
+	{
+		return FALSE;
+	}
+
+	if ((base & (size - 1)) != 0)
+	{
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+static exception_t channel_bind_doorbell(struct ktcb *consumer)
+{
+	notifation_t *node = consumer->notifation_node;
+
+	if (!node)
+	{
+		node = notifation_node_alloc(consumer);
+		if (!node)
+		{
+			return EXCEPTION_LOOKUP_FAULT;
+		}
+	}
+
+	node->bindedtcb = consumer;
+	return EXCEPTION_NONE;
+}
+
+struct channel *do_channel_create(word_t base, word_t size,
+	struct ktcb *producer, struct ktcb *consumer)
+{
+	struct channel *ch;
+	struct channel_ring *ring = (struct channel_ring *)base;
+
+	ch = d_object_alloc(obj_channel_obj, 0);
+	if (!ch)
+	{
+		return NULL;
+	}
+
+	if (channel_bind_doorbell(consumer) != EXCEPTION_NONE)
+	{
+		d_object_free(ch);
+		return NULL;
+	}
+
+	ring_buf_init(&ring->desc, CHANNEL_RING_WORDS, ring->desc_storage);
+
+	/* both ends write the ring header, the payload is shared rw too */
+	do_map_page(producer, base, size, PAGE_RIGHT_RW);
+	do_map_page(consumer, base, size, PAGE_RIGHT_RW);
+
+	ch->producer = producer;
+	ch->consumer = consumer;
+	ch->ring = ring;
+	ch->size = size;
+	ch->doorbell_count = 0;
+
+	return ch;
+}
+
+void do_channel_doorbell(struct channel *ch)
+{
+	assert(ch && ch->consumer);
+
+	LOCKED(&channel_lock)
+	{
+		ch->doorbell_count++;
+	}
+
+	send_signal(ch->consumer->notifation_node, CHANNEL_DOORBELL_BADGE);
+}
+
+exception_t syscall_channel_create(void **channel, word_t base, 
+	word_t size, word_t producer_id, word_t consumer_id)
+{
+	bool_t is_sufficient = false;
+	
+	update_timestamp(false);
+	is_sufficient = check_budget_restart();
+
+	if (is_sufficient)
+	{
+		struct channel *ch;
+		struct ktcb *producer;
+		struct ktcb *consumer;
+
+		if (!is_channel_region_vaild(base, size))
+		{
+			user_error("Channel Object: Region is not power of two aligned.");
+			current_syscall_error_code = TCR_INVAL_PARA;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+
+#if defined(CONFIG_USERSPACE)
+		/* the caller must own the region it hands out */
+		if (SYSCALL_MEMORY_WRITE((void *)base, size) || 
+			SYSCALL_MEMORY_WRITE(channel, sizeof(*channel)))
+		{
+			user_error("Channel Object: Illegal operation attempted.");
+			current_syscall_error_code = TCR_INVAL_PARA;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+#endif
+
+		producer = get_thread(producer_id);
+		consumer = get_thread(consumer_id);
+		if (!producer || !consumer || producer == consumer)
+		{
+			user_error("Channel Object: Invalid producer or consumer thread.");
+			current_syscall_error_code = TCR_INVAL_THREAD;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+
+		ch = do_channel_create(base, size, producer, consumer);
+		if (!ch)
+		{
+			current_syscall_error_code = TCR_OUT_OF_MEM;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+
+		*channel = ch;
+	
+		schedule();
+		/* reschedule_unlocked(); */
+	
+		return EXCEPTION_NONE;
+	}
+	return EXCEPTION_FAULT;
+}
+
+exception_t syscall_channel_doorbell(void *channel)
+{
+	bool_t is_sufficient = false;
+	
+	update_timestamp(false);
+	is_sufficient = check_budget_restart();
+
+	if (is_sufficient)
+	{
+		struct d_object *d_obj = d_object_find(channel);
+		struct channel *ch = channel;
+
+		if (!d_obj || d_obj->k_obj.type != obj_channel_obj)
+		{
+			user_error("Channel Object: Invalid channel object.");
+			current_syscall_error_code = TCR_INVAL_PARA;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+
+		if (ch->producer != _current_thread)
+		{
+			user_error("Channel Object: Only the producer can ring the doorbell.");
+			current_syscall_error_code = TCR_NO_PRIVILIGE;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+
+		do_channel_doorbell(ch);
+	
+		schedule();
+		/* reschedule_unlocked(); */
+	
+		return EXCEPTION_NONE;
+	}
+	return EXCEPTION_FAULT;
+}
@@ -108,6 +108,16 @@ sword_t k_object_access_validate(struct k_object *ko, struct ktcb *thread,
 }
 
 
+/* the grant itself, shared with the batch ring */
+void do_kobject_access_grant(void *object, struct ktcb *thread)
+{
+	LOCKED(&k_obj_lock)
+	{
+		k_object_access_grant(object, thread);
+	}
+}
+
+
 /* Normally these would be included in userspace.c, but the way
  * syscall_dispatch.c declares weak handlers results in build errors if these
  * are located in userspace.c. Just put in a separate file.
@@ -129,18 +139,12 @@ void syscall_kobject_access_grant(void *object, struct ktcb *thread)
 		/* thread */
 		SYSCALL_OOPS(SYSCALL_OBJ(thread, obj_thread_obj));
 		/* grant */
-		LOCKED(&k_obj_lock)
-		{
-			k_object_access_grant(object, thread);
-		}
+		do_kobject_access_grant(object, thread);
 		/* object */
 		ko = validate_any_k_object(object, thread);
 		SYSCALL_OOPS(SYSCALL_VERIFY_MSG(ko != NULL, "object %p access denied", object));
 #else
-		LOCKED(&k_obj_lock)
-		{
-			k_object_access_grant(object, thread);
-		}
+		do_kobject_access_grant(object, thread);
 #endif
 	
 		schedule();
@@ -9,6 +9,8 @@
 #include <kernel/thread.h>
 #include <device.h>
 #include <api/errno.h>
+#include <benchmark/irq_stats.h>
+#include <benchmark/wcet.h>
 
 static spinlock_t interrupt_lock;       /* k_obj struct data */
 
@@ -19,60 +21,58 @@ static spinlock_t interrupt_lock;       /* k_obj struct data */
              unlock_spin_unlock(lck, __key),\
              __i.key = 1)
 
-static struct interrupt *interrupt_array[CONFIG_NUM_IRQS] = {NULL};
-static interrupt_state_t interrupt_state_array[CONFIG_NUM_IRQS] = {interrupt_irq_inactive};
+#if defined(CONFIG_GEN_IRQ_OBJECT_TABLE)
+BUILD_ASSERT(CONFIG_GEN_IRQ_START_VECTOR == 0);
+#define interrupt_table irq_object_table
+#else
+static struct interrupt interrupt_table[CONFIG_NUM_IRQS];
+#endif
+
+static FORCE_INLINE struct interrupt *interrupt_of(int32_t num)
+{
+	return &interrupt_table[num];
+}
 
 static bool_t is_interrupt_active(int32_t num)
 {
-	return interrupt_state_array[num] != interrupt_irq_inactive;
+	return interrupt_of(num)->state != interrupt_irq_inactive;
 }
 
 static void set_interrupt_active(interrupt_state_t state, int32_t num)
 {
-	interrupt_state_array[num] = state;
+	interrupt_of(num)->state = state;
 }
 
-static struct interrupt *interrupt_create(int32_t num)
+/* link irq into the owned list of thread, the caller holds interrupt_lock */
+static void interrupt_bind(struct interrupt *irq, struct ktcb *thread)
 {
-	LOCKED(&interrupt_lock)
-	{
-		if (IRQ_NUM_IS_VAILD(num))
-		{
-			struct interrupt *irq = 
-				(struct interrupt *)d_object_alloc(obj_irq_control_obj, 0);
-			
-			irq->action = (uint16_t) interrupt_action_number;
-			irq->number = num;
-			irq->thread = NULL;
-			
-			if(!interrupt_array[num]) 
-				interrupt_array[num] = irq;
-			
-			return(irq);
-		}
-	}
-
-	return(NULL);
+	irq->thread = thread;
+	irq->owned_next = thread->irq_owned;
+	thread->irq_owned = irq;
 }
 
-static bool_t interrupt_destroy(int32_t num)
+/* unlink irq from the owned list of its thread, the caller holds interrupt_lock */
+static void interrupt_unbind(struct interrupt *irq)
 {
-	LOCKED(&interrupt_lock)
+	struct interrupt **link;
+
+	if (!irq->thread)
 	{
-		if (IRQ_NUM_IS_VAILD(num))
+		return;
+	}
+
+	for (link = &irq->thread->irq_owned; *link; link = &(*link)->owned_next)
+	{
+		if (*link == irq)
 		{
-			struct interrupt *irq = interrupt_array[num];
-			
-			if (irq)
-			{
-				interrupt_array[num] = NULL;
-				d_object_free(irq);
-				return(TRUE);
-			}
+			*link = irq->owned_next;
+			break;
 		}
 	}
 
-	return(FALSE);
+	irq->thread = NULL;
+	irq->owned_next = NULL;
+	irq->action = (uint16_t) interrupt_action_number;
 }
 
 void interrupt_request(struct ktcb *s_thread)
@@ -92,14 +92,18 @@ void interrupt_request(struct ktcb *s_thread)
 
 		irq_disable(num);
 		
-		struct interrupt *irq = interrupt_create(num);
-		
-		if (irq)
+		LOCKED(&interrupt_lock)
 		{
-			if (!is_interrupt_active(num))
+			struct interrupt *irq = interrupt_of(num);
+			struct ktcb *thread = get_thread(id);
+
+			if (!is_interrupt_active(num) && thread)
 			{
-				irq->number = num;
-				irq->thread = get_thread(id);
+				if (irq->thread != thread)
+				{
+					interrupt_unbind(irq);
+					interrupt_bind(irq, thread);
+				}
 				irq->action = act;
 			}
 			else
@@ -107,21 +111,22 @@ void interrupt_request(struct ktcb *s_thread)
 				user_error("Rejecting request for IRQ %u. Already active\n", num);
 			}
 		}
-
 	}
 }
 
 void interrupt_respond(struct ktcb *r_thread)
 {
 	assert(r_thread);
+	struct interrupt *irq;
+	struct interrupt *next;
+	int32_t num;
 	word_t lock;
 	
-	for (int32_t num = 0; num < CONFIG_NUM_IRQS; num++)
+	/* only the IRQs owned by r_thread are visited */
+	for (irq = r_thread->irq_owned; irq; irq = next)
 	{
-		struct interrupt *irq = interrupt_array[num];
-		
-		if (!irq || irq->thread != r_thread) 
-			continue;
+		next = irq->owned_next;
+		num = irq->number;
 
 		switch (irq->action)
 		{
@@ -139,13 +144,35 @@ void interrupt_respond(struct ktcb *r_thread)
 				irq_unlock(lock);
 				irq_enable(num);
 				break;
+#if defined(CONFIG_IRQ_DIRECT_DELIVERY)
+			case interrupt_direct_enable:
+				lock = irq_lock();
+				if (r_thread->base.sched_prior == NUM_PRIORITIES - 1 && 
+					r_thread->notifation_node)
+				{
+					set_interrupt_active(interrupt_irq_direct, num);
+					irq_unlock(lock);
+					irq_enable(num);
+				}
+				else
+				{
+					set_interrupt_active(interrupt_irq_reserved, num);
+					irq_unlock(lock);
+					irq_disable(num);
+					user_error("Rejecting direct IRQ %d, thread is not highest priority\n", num);
+				}
+				break;
+#endif
 			case interrupt_disable:
 			case interrupt_free:
 				lock = irq_lock(); 
 			    set_interrupt_active(interrupt_irq_inactive, num);
 				if (irq->action == interrupt_free)
 				{
-					interrupt_destroy(num);
+					LOCKED(&interrupt_lock)
+					{
+						interrupt_unbind(irq);
+					}
 				}
 				irq_unlock(lock);
 			    irq_disable(num);
@@ -161,10 +188,31 @@ void interrupt_respond(struct ktcb *r_thread)
 	}
 }
 
+/* drop every IRQ bound to a thread that goes away */
+void interrupt_release(struct ktcb *thread)
+{
+	word_t lock;
+
+	LOCKED(&interrupt_lock)
+	{
+		while (thread->irq_owned)
+		{
+			struct interrupt *irq = thread->irq_owned;
+
+			irq_disable(irq->number);
+			lock = irq_lock();
+			set_interrupt_active(interrupt_irq_inactive, irq->number);
+			interrupt_unbind(irq);
+			irq_unlock(lock);
+		}
+	}
+}
+
 static void interrupt_signal(int32_t num)
 {
-	struct interrupt *irq  = interrupt_array[num];
+	struct interrupt *irq  = interrupt_of(num);
 	struct ktcb  *thread  = irq->thread;
+	bool_t is_blocked;
 	word_t lock;
 	
 	assert(irq && thread);
@@ -172,14 +220,22 @@ static void interrupt_signal(int32_t num)
 	lock = irq_lock();
 	if (thread)
 	{
-		if (get_thread_state(thread, state_recv_blocked_state | 
-			state_send_blocked_state) != 0)
+		is_blocked = get_thread_state(thread, state_recv_blocked_state | 
+			state_send_blocked_state) != 0;
+		if (is_blocked)
 		{
 			cancel_ipc(thread);
 		}
 
 		/** Interrupt handle sends signal and interrupt thread receives signal */
-		send_signal(thread->notifation_node);
+		send_signal(thread->notifation_node, interrupt_badge(num));
+		irq_stats_thread_woken(num, thread);
+
+		/* the wakeup carries every badge coalesced so far */
+		if (is_blocked && thread->notifation_node->state == notifation_state_active)
+		{
+			complete_signal(thread, thread->notifation_node);
+		}
 		
 		set_thread_state(thread, state_queued_state);
 		
@@ -191,6 +247,33 @@ static void interrupt_signal(int32_t num)
 	irq_unlock(lock);
 }
 
+#if defined(CONFIG_IRQ_DIRECT_DELIVERY)
+/* the direct path, see interrupt.h for what it skips and its worst case */
+static bool_t interrupt_direct(int32_t num)
+{
+	struct interrupt *irq = interrupt_of(num);
+	struct ktcb *thread = irq->thread;
+	notifation_t *node = thread->notifation_node;
+
+	/* masked until the handler acks it through interrupt_respond */
+	irq_disable(num);
+
+	if (!is_thread_state_set(thread, state_notify_blocked_state))
+	{
+		/* not waiting on its node, busy or in an IPC: it takes the badge
+		 * on its next wait */
+		node->badge |= interrupt_badge(num);
+		node->state = notifation_state_active;
+		return FALSE;
+	}
+
+	direct_signal(thread, node, interrupt_badge(num));
+	irq_stats_thread_woken(num, thread);
+	direct_switchto(thread);
+	return TRUE;
+}
+#endif
+
 #if defined(CONFIG_KERNEL_TIMER_INT) 
 static bool_t interrupt_time(int32_t num)
 {
@@ -224,14 +307,21 @@ bool_t do_interrupt_service(int32_t num)
 		irq_disable(num);
 		return FALSE;
 	}
+
+#if defined(CONFIG_IRQ_DIRECT_DELIVERY)
+	if (interrupt_of(num)->state == interrupt_irq_direct)
+	{
+		return interrupt_direct(num);
+	}
+#endif
 	
-	if (interrupt_state_array[num] == interrupt_irq_reserved)
+	if (interrupt_of(num)->state == interrupt_irq_reserved)
 	{
 		user_error("Received unhandled reserved IRQ: %d\n", num);
 		return FALSE;
 	}
 
-	if (interrupt_state_array[num] == interrupt_irq_inactive)
+	if (interrupt_of(num)->state == interrupt_irq_inactive)
 	{
 		user_error("Received disabled IRQ: %d\n", num);
 		return FALSE;
@@ -239,7 +329,7 @@ bool_t do_interrupt_service(int32_t num)
 
 	update_timestamp(false); 
 
-	if (interrupt_state_array[num] == interrupt_irq_timer)
+	if (interrupt_of(num)->state == interrupt_irq_timer)
 	{
 		if (interrupt_time(num) == TRUE)
 		{
@@ -251,7 +341,7 @@ bool_t do_interrupt_service(int32_t num)
 
 	if (check_budget()) 
 	{ 
-		switch (interrupt_state_array[num])
+		switch (interrupt_of(num)->state)
 		{
 			case interrupt_irq_signal:
 			case interrupt_irq_timer:
@@ -275,7 +365,11 @@ ISR_DIRECT_DECLARE(handle_interrupt)
 	
 	if (irq_num != CONFIG_NUM_IRQS)
 	{
+		wcet_irq_enter(irq_num);
+		irq_stats_isr_enter(irq_num);
 		is_resched = do_interrupt_service(irq_num);
+		irq_stats_isr_exit(irq_num);
+		wcet_irq_exit(irq_num, is_resched);
 		/* re-schedule is vaild */
 		return is_resched;
 	}
@@ -286,7 +380,19 @@ ISR_DIRECT_DECLARE(handle_interrupt)
 static s32_t init_interrupt_object_module(struct device *dev)
 {
 	ARG_UNUSED(dev);
-	interrupt_array_init(interrupt_array);
+
+#if !defined(CONFIG_GEN_IRQ_OBJECT_TABLE)
+	for (int32_t num = 0; num < CONFIG_NUM_IRQS; num++)
+	{
+		struct interrupt *irq = interrupt_of(num);
+
+		irq->thread = NULL;
+		irq->owned_next = NULL;
+		irq->number = num;
+		irq->action = (uint16_t) interrupt_action_number;
+		irq->state = interrupt_irq_inactive;
+	}
+#endif
 	return 0;
 }
 
@@ -14,6 +14,9 @@
 #include <object/objecttype.h>
 #include <api/syscall.h>
 #include <kernel/privilege.h>
+#include <linker/section_tags.h>
+#include <benchmark/thread_stats.h>
+#include <benchmark/wcet.h>
 
 static spinlock_t ipc_lock;
 
@@ -32,6 +35,7 @@ static exception_t message_exchange(struct ktcb *s_thread, struct ktcb *r_thread
 	word_t untyped_item_index = 1;
 	word_t gmsc_item_index = 0;
 	word_t gmsc_item_word = 0;
+	message_gmsc_items_t gmsc_item_cur;
 
 	assert(s_thread != NULL && r_thread != NULL);
 	
@@ -58,7 +62,7 @@ static exception_t message_exchange(struct ktcb *s_thread, struct ktcb *r_thread
 	/* Fast IPC that the length of message is 8 when the thread switch to myself */
 	/* Slow IPC that the length of message is greater than 8 */
 	for (untyped_item_index = 1; untyped_item_index < untyped_item_last;
-		untyped_item_last++)
+		untyped_item_index++)
 	{
 		store_message_registers(r_thread, untyped_item_index, 
 			load_message_registers(s_thread, untyped_item_index));
@@ -68,25 +72,15 @@ static exception_t message_exchange(struct ktcb *s_thread, struct ktcb *r_thread
 	for (gmsc_item_index = untyped_item_index; gmsc_item_index < gmsc_item_last;
 		gmsc_item_index++)
 	{
-		message_gmsc_items_t gmsc_item_cur;
- 
-		if (gmsc_item_word == 0)
-		{
-			TYPED_ITEM(gmsc_item_cur)[gmsc_item_word] = 
-				load_message_registers(s_thread, gmsc_item_index);
-			gmsc_item_word ++;
-		}
-		else
-		{
-			TYPED_ITEM(gmsc_item_cur)[gmsc_item_word] = 
-				load_message_registers(s_thread, gmsc_item_index);
-			gmsc_item_word --;
-		}
+		/* every typed item is two words, act once both are in */
+		TYPED_ITEM(gmsc_item_cur)[gmsc_item_word] = 
+			load_message_registers(s_thread, gmsc_item_index);
 
 		store_message_registers(r_thread, gmsc_item_index, 
 			TYPED_ITEM(gmsc_item_cur)[gmsc_item_word]);
 
-		if (gmsc_item_word % 2) 
+		gmsc_item_word ^= 1;
+		if (gmsc_item_word) 
 			continue;
 
 		if (message_get_encode(gmsc_item_cur) == MAP_ITEM) 
@@ -103,7 +97,8 @@ static exception_t message_exchange(struct ktcb *s_thread, struct ktcb *r_thread
 			/* grant process means 'permanent give', the page always to be receive, not to be send */
 		}	
 			
-		if (message_get_encode(gmsc_item_cur) == STRING_ITEM)
+		/* a string item is the one with the bit clear */
+		if (!(message_get_encode(gmsc_item_cur) & STRING_ITEM))
 		{
 			do_map_string(r_thread, message_get_length(gmsc_item_cur), 
 				message_get_address(gmsc_item_cur));
@@ -174,6 +169,8 @@ void send_ipc(struct ktcb *thread, bool_t blocking, bool_t candonate, message_t
 			case message_state_send:
 				if(blocking)
 				{
+					thread_stats_voluntary(thread);
+					thread_stats_wait(thread, state_send_blocked_state);
 					set_thread_state(thread, state_send_blocked_state);
 					set_thread_state_object(thread, (uintptr_t)node);
 					
@@ -249,6 +246,8 @@ void receive_ipc(struct ktcb *thread, bool_t blocking, message_t *node)
 				case message_state_recv:
 					if(blocking)
 					{
+						thread_stats_voluntary(thread);
+						thread_stats_wait(thread, state_recv_blocked_state);
 						set_thread_state(thread, state_recv_blocked_state);
 						set_thread_state_object(thread, (uintptr_t)node);
 						schedule_tcb(thread);
@@ -379,7 +378,7 @@ static void possible_reset_context(struct ktcb *thread, notifation_t *node)
    When signaling the second time, the binding thread must want to receive the signal,
    so the notification node must be waiting. Therefore, the time budget may be needed 
    at this time, so it is necessary to donate the time budget */
-void send_signal(notifation_t *node)
+void send_signal(notifation_t *node, word_t badge)
 {
 	struct ktcb *thread;
 	struct tcb_queue queue;
@@ -401,6 +400,8 @@ void send_signal(notifation_t *node)
 					{
 						/* Send and start thread running */
 						cancel_ipc(thread);
+						deliver_signal_badge(thread, node->badge | badge);
+						node->badge = 0;
 						set_thread_state(thread, state_queued_state);
 	
 						/* make can be scheduled */
@@ -413,11 +414,13 @@ void send_signal(notifation_t *node)
 					}
 					else
 					{
+						node->badge |= badge;
 						node->state = notifation_state_active;
 					}
 				}
 				else
 				{
+					node->badge |= badge;
 					node->state = notifation_state_active;
 				}
 				break;
@@ -437,6 +440,7 @@ void send_signal(notifation_t *node)
 				}
 				
 				dest->notifation_node = node;
+				deliver_signal_badge(dest, badge);
 				set_thread_state(dest, state_queued_state);
 				
 				/* make can be scheduled */
@@ -448,7 +452,8 @@ void send_signal(notifation_t *node)
 				}
 				break;
 			case notifation_state_active:
-				user_error("dest - %d has already active, dont active again\n", dest->thread_id);
+				/* coalesce with the signals not yet received */
+				node->badge |= badge;
 				break;
 			default:
 				break;
@@ -474,6 +479,8 @@ void recevie_signal(struct ktcb *thread, notifation_t *node, bool_t blocking)
 	
 				if (blocking)
 				{
+					thread_stats_voluntary(thread);
+					thread_stats_wait(thread, state_notify_blocked_state);
 					set_thread_state(thread, state_notify_blocked_state);
 	
 					/* make cannot be scheduled */
@@ -490,6 +497,9 @@ void recevie_signal(struct ktcb *thread, notifation_t *node, bool_t blocking)
 				}
 				break;
 			case notifation_state_active:
+				/* read and clear the badge word in one go */
+				deliver_signal_badge(thread, node->badge);
+				node->badge = 0;
 				node->state = notifation_state_idle;
 				/* make can be scheduled */
 				possible_donate_context(thread, node);
@@ -519,6 +529,29 @@ void cancel_signal(struct ktcb *thread, notifation_t *node)
 	}
 }
 
+/* The direct interrupt path: take the handler off the wait queue of its
+ * node and leave it running, neither blocked, queued nor restarting. No
+ * set_thread_state(), so schedule_tcb() is not run for it either. */
+void direct_signal(struct ktcb *thread, notifation_t *node, word_t badge)
+{
+	assert(thread != NULL && node != NULL);
+
+	LOCKED(&ipc_lock)
+	{
+		node->queue = message_dequeue(thread, node->queue);
+		if (!node->queue.head)
+		{
+			node->state = notifation_state_idle;
+		}
+
+		deliver_signal_badge(thread, node->badge | badge);
+		node->badge = 0;
+
+		reset_thread_states(thread, state_notify_blocked_state | state_queued_state);
+		marktcb_as_started(thread);
+	}
+}
+
 void complete_signal(struct ktcb *thread, notifation_t *node)
 {
 	assert(thread  != NULL && node != NULL);
@@ -527,6 +560,8 @@ void complete_signal(struct ktcb *thread, notifation_t *node)
 	{
 		if (thread && node->state == notifation_state_active)
 		{
+			deliver_signal_badge(thread, node->badge);
+			node->badge = 0;
 			node->state = notifation_state_idle;
 			thread->notifation_node = node;
 		}
@@ -554,16 +589,23 @@ void reorder_noticenode(struct ktcb *thread)
 	}
 }
 
-static void exchange_ipc_timeout(u16_t t)
+static void exchange_ipc_timeout(struct ktcb *caller, u16_t t)
 {
 	message_time_t timeout = { .raw = t };
 	ticks_t ticks = 
 		us_to_ticks(message_time_period_m(timeout) << message_time_period_e(timeout));
 	
-	set_deadline(ticks, &(_current_thread->thread_id));
+#if defined(CONFIG_TIMER_SLACK)
+	set_deadline_slack(ticks, &(caller->thread_id), caller->cold.timer_slack);
+#else
+	set_deadline(ticks, &(caller->thread_id));
+#endif
 }
 
-exception_t do_exchange_ipc(	
+/* Runs on the privilege thread, so the thread that made the call is 
+   caller and not _current_thread */
+__kernel_hot_text exception_t do_exchange_ipc(	
+	struct ktcb *caller,
 	word_t recv_gid, 
 	word_t send_gid,
 	word_t timeout,
@@ -597,11 +639,11 @@ exception_t do_exchange_ipc(
 	{
 		if (wait_timeout.raw != 0) 
 		{
-			exchange_ipc_timeout(wait_timeout.raw);
+			exchange_ipc_timeout(caller, wait_timeout.raw);
 		}
 		else
 		{
-			set_thread_state(_current_thread, state_restart_state);
+			set_thread_state(caller, state_restart_state);
 			user_error("IPC Object: Illegal operation IPC not exist - ids are both NIL.");
 			current_syscall_error_code = IPC_NOT_EXIST;
 			return EXCEPTION_SYSCALL_ERROR;
@@ -612,7 +654,7 @@ exception_t do_exchange_ipc(
 	if (recv_gid == GLOBALID_ANYTHREAD && 
 		send_gid == GLOBALID_ANYTHREAD)
 	{
-		set_thread_state(_current_thread, state_restart_state);
+		set_thread_state(caller, state_restart_state);
 		user_error("IPC Object: Illegal operation IPC not exist - ids are both ANY.");
 		current_syscall_error_code = IPC_NOT_EXIST;
 		return EXCEPTION_SYSCALL_ERROR;
@@ -637,7 +679,7 @@ exception_t do_exchange_ipc(
 		if (recv_gid == TID_TO_GLOBALID(id_irq_request_id))
 		{
 			/* myself sends request to me */
-			interrupt_request(_current_thread);
+			interrupt_request(caller);
 			return EXCEPTION_NONE;
 		}
 
@@ -665,21 +707,21 @@ exception_t do_exchange_ipc(
 		/* set timeout */
 		if (send_timeout.raw != 0) 
 		{
-			exchange_ipc_timeout(send_timeout.raw);
+			exchange_ipc_timeout(caller, send_timeout.raw);
 		}
 
 		/* send process: receive thread may be self or others */
-		send_ipc(_current_thread, TRUE, TRUE, r_thread->message_node);
+		send_ipc(caller, TRUE, TRUE, r_thread->message_node);
 	}
 
 	/* receive IPC process - recv_gid = nil(current), recv_gid = any */
-	if (send_gid != GLOBALID_NILTHREAD)
+	if (send_gid != GLOBALID_NILTHREAD && send_gid != GLOBALID_ANYTHREAD)
 	{		
 		/* INT ack */
 		if (send_gid == TID_TO_GLOBALID(id_irq_ack_id))
 		{
 			/* myself receives respond from me */
-			interrupt_respond(_current_thread);
+			interrupt_respond(caller);
 			return EXCEPTION_NONE;
 		}
 		
@@ -693,43 +735,30 @@ exception_t do_exchange_ipc(
 		/* set receive timeout */
 		if (recv_timeout.raw != 0) 
 		{
-			exchange_ipc_timeout(recv_timeout.raw);
+			exchange_ipc_timeout(caller, recv_timeout.raw);
 		}	
 
 		/* receive process: send thread may be self or others */
-		receive_ipc(_current_thread, TRUE, s_thread->message_node);
+		receive_ipc(caller, TRUE, s_thread->message_node);
 	}	
 
-	/* recv_gid != any, recv_gid = nil(current) */
+	/* open wait: a sender blocks on the message node of its destination, 
+	   so every thread sending to the caller is queued on the caller's node */
 	if (send_gid == GLOBALID_ANYTHREAD)
 	{
-		for (word_t thread_index = 0; thread_index < record_thread_count; thread_index ++)
+		message_t *node = caller->message_node;
+
+		if (recv_timeout.raw != 0) 
 		{
-			s_thread = record_threads[thread_index];
-			
-			if (!s_thread)
-			{
-				user_error("IPC Object: Illegal operation any send thread.");
-				current_syscall_error_code = TCR_INVAL_PARA;
-				return EXCEPTION_SYSCALL_ERROR;
-			}
-			
-			if (get_thread_object_state(s_thread) == state_send_blocked_state)
-			{
-				if (recv_timeout.raw != 0) 
-				{
-					exchange_ipc_timeout(recv_timeout.raw);
-				}
+			exchange_ipc_timeout(caller, recv_timeout.raw);
+		}
 
-				if (recv_gid != GLOBALID_NILTHREAD) 
-					receive_ipc(r_thread, TRUE, s_thread->message_node);
-				else
-					receive_ipc(_current_thread, TRUE, s_thread->message_node);
-				
-				*send_any_gid = s_thread->thread_id;
-				break;
-			}
+		if (node->state == message_state_send && send_any_gid)
+		{
+			*send_any_gid = node->queue.head->thread_id;
 		}
+
+		receive_ipc(caller, TRUE, node);
 	}
 
 	/* schedule(); */
@@ -753,11 +782,15 @@ exception_t syscall_exchange_ipc(
 
 	if (is_sufficient)
 	{
+		fastipc_caller.caller = _current_thread;
 		fastipc_caller.receive = recv_gid;
 		fastipc_caller.send = send_gid;
 		fastipc_caller.timeout = timeout;
 		fastipc_caller.anysend = send_any_gid;
 		
+		/* the caller hands over to the privilege thread */
+		thread_stats_voluntary(_current_thread);
+		wcet_syscall_defer();
 		scheduler_action = SCHEDULER_ACTION_CHOOSE_PRIV_THREAD;
 		
 		set_privilege_status(priv_fastipc_priv, priv_ready_priv);
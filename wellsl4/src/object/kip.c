@@ -3,13 +3,59 @@
 #include <sys/assert.h>
 #include <api/syscall.h>
 #include <kernel/thread.h>
+#include <linker/section_tags.h>
+#include <device.h>
+#include <sys/string.h>
+#include <model/spinlock.h>
 
-struct kip_info kip = 
+#define KIP_INITIALIZER \
+{ \
+	.kid      = 0x00000000, \
+	.apiv.raw = 0x84 << 24 | 7 << 16,  /* L4 X.2, rev 7 */ \
+	.apif.raw = 0x00000000            /* Little endian 32-bit */ \
+}
+
+#if defined(CONFIG_USER_KIP_PAGE)
+/* Both live in the user readable, kernel writable KIP partition.
+ * The section is not loaded, so the KIP is filled in at boot.
+ */
+__user_kip struct kip_info kip;
+__user_kip struct kip_clock kip_clock;
+
+static spinlock_t kip_clock_lock;
+
+static s32_t kip_page_init(struct device *dev)
 {
-	.kid      = 0x00000000,
-	.apiv.raw = 0x84 << 24 | 7 << 16,  /* L4 X.2, rev 7 */
-	.apif.raw = 0x00000000            /* Little endian 32-bit */
-};
+	static const struct kip_info kip_template = KIP_INITIALIZER;
+
+	ARG_UNUSED(dev);
+
+	(void)memcpy(&kip, &kip_template, sizeof(kip));
+	(void)memset(&kip_clock, 0, sizeof(kip_clock));
+
+	return 0;
+}
+
+SYS_INIT(kip_page_init, pre_kernel_1, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+/* Any kernel entry republishes, an interrupt may do it in the middle
+ * of a system call doing it, so the writers are serialised here */
+void update_kip_clock(dword_t clock, dword_t tick)
+{
+	spinlock_key_t key = lock_spin_lock(&kip_clock_lock);
+
+	kip_clock.seq++;
+	compiler_barrier();
+	kip_clock.clock = clock;
+	kip_clock.tick = tick;
+	compiler_barrier();
+	kip_clock.seq++;
+
+	unlock_spin_unlock(&kip_clock_lock, key);
+}
+#else
+struct kip_info kip = KIP_INITIALIZER;
+#endif
 
 word_t syscall_kernel_interface(
 	word_t *version, 
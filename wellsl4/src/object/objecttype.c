@@ -12,15 +12,17 @@
 #include <sys/inttypes.h>
 #include <sys/assert.h>
 #include <object/objecttype.h>
+#include <object/untyped.h>
 #include <user/anode.h>
 #include <model/spinlock.h>
 #include <sys/rb.h>
 #include <sys/dlist.h>
 #include <kernel_object.h>
+#include <linker/section_tags.h>
 
-MEM_POOL_DEFINE(_heap_mem_pool, CONFIG_HEAP_MEM_POOL_MIN_SIZE, CONFIG_HEAP_MEM_POOL_SIZE, CONFIG_KERNEL_OBJECT_NUMBER, 4);
+/* the object heap holds every tcb, see KERNEL_HOT_DATA_HEAP */
+__kernel_hot_heap MEM_POOL_DEFINE(_heap_mem_pool, CONFIG_HEAP_MEM_POOL_MIN_SIZE, CONFIG_HEAP_MEM_POOL_SIZE, CONFIG_KERNEL_OBJECT_NUMBER, 4);
 
-static enum obj_tag d_obj_type = obj_null_obj;
 static spinlock_t d_obj_lock;       /* k_obj rbtree/dlist */
 /* static spinlock_t d_free_lock;  */    /* d_object_free */
 
@@ -60,10 +62,11 @@ size_t get_k_object_size(enum obj_tag type, word_t untyped_obj_size)
 			case obj_irq_control_obj: ret = sizeof(struct interrupt); break;
 			case obj_irq_handler_obj: ret = sizeof(word_t); break;
 			case obj_domain_obj: ret = sizeof(struct dschedule); break;
-			case obj_untyped_obj: ret = untyped_obj_size; break;
+			case obj_untyped_obj: ret = sizeof(struct untyped_region) + untyped_obj_size; break;
 			case obj_time_obj: ret = sizeof(struct timer_event); break;
 			case obj_device_obj: ret = sizeof(struct device); break;
 			case obj_pager_obj: ret = sizeof(struct pager_context); break;
+			case obj_channel_obj: ret = sizeof(struct channel); break;
 			default: ret = 0; break;
 		}
 	}
@@ -107,6 +110,7 @@ const string k_object_type_to_str(enum obj_tag type)
 			case obj_time_obj: ret = "thread time"; break;
 			case obj_device_obj: ret = "thread device"; break;
 			case obj_pager_obj: ret = "thread pager"; break;
+			case obj_channel_obj: ret = "shared memory channel"; break;
 			default: ret = "?"; break;
 		}
 	}
@@ -335,24 +339,51 @@ void *d_object_alloc(enum obj_tag type, word_t untyped_obj_size)
 	memset((char *)&d_obj->k_obj_self, 0, get_k_object_size(type, untyped_obj_size));
 	sys_dnode_init(&d_obj->k_obj_dlnode);
 	rb_node_init(&d_obj->k_obj_rbnode);
+
+	if (type == obj_untyped_obj)
+	{
+		untyped_region_init(untyped_region_of(d_obj), untyped_obj_size);
+	}
 	
-	if (d_obj_type != type)
+	/* every object is indexed, as d_object_carve() does, or the next
+	 * d_object_find() of one allocated after another of its type fails */
+	LOCKED(&d_obj_lock)
 	{
-		LOCKED(&d_obj_lock)
-		{
-			rb_insert(&d_obj_rb, &d_obj->k_obj_rbnode);
-			sys_dlist_append(&d_obj_dlist, &d_obj->k_obj_dlnode);
-		}
+		rb_insert(&d_obj_rb, &d_obj->k_obj_rbnode);
+		sys_dlist_append(&d_obj_dlist, &d_obj->k_obj_dlnode);
 	}
-
-	d_obj_type = type;
 	
 	return d_obj->k_obj.name;
 }
 
+/* memory is owned and already cleared by the untyped, nothing is allocated here,
+ * untyped objects are never carved */
+void *d_object_carve(void *memory, enum obj_tag type)
+{
+	struct d_object *d_obj = memory;
+
+	d_obj->k_obj.name = (char *)&d_obj->k_obj_self;
+	d_obj->k_obj.type = type;
+	d_obj->k_obj.flag = obj_allocated_obj | obj_carved_obj;
+	d_obj->k_obj.right = 0;
+	d_obj->k_obj.data = 0;
+
+	sys_dnode_init(&d_obj->k_obj_dlnode);
+	rb_node_init(&d_obj->k_obj_rbnode);
+
+	LOCKED(&d_obj_lock)
+	{
+		rb_insert(&d_obj_rb, &d_obj->k_obj_rbnode);
+		sys_dlist_append(&d_obj_dlist, &d_obj->k_obj_dlnode);
+	}
+
+	return d_obj->k_obj.name;
+}
+
 void d_object_free(void *obj)
 {
 	struct d_object *d_obj;
+	bool_t is_carved;
 
 	/* This function is intentionally not exposed to user mode.
 	 * There's currently no robust way to track that an object isn't
@@ -362,8 +393,26 @@ void d_object_free(void *obj)
 
 	if (d_obj != NULL)
 	{
+		/* the objects carved from it would point into freed memory */
+		if (d_obj->k_obj.type == obj_untyped_obj && untyped_has_children(d_obj))
+		{
+			user_error("Untyped Object: Carved objects are still live.");
+			return;
+		}
+
+		/* deleting clears the flags */
+		is_carved = (d_obj->k_obj.flag & obj_carved_obj) != 0;
 		d_object_delete(d_obj);
-		free_object(d_obj);
+
+		/* carved objects go back with their untyped */
+		if (is_carved)
+		{
+			untyped_child_release(d_obj);
+		}
+		else
+		{
+			free_object(d_obj);
+		}
 	}
 }
 
@@ -522,7 +571,7 @@ static sword_t init_memory_pool_module(struct device *dev)
 	
 	STRUCT_SECTION_FOREACH(k_mem_pool, pool_ptr) 
 	{
-		sys_mem_pool_base_init(&pool_ptr->base);
+		k_mem_pool_base_init(&pool_ptr->base);
 	}
 	return 0;
 }
@@ -532,7 +581,7 @@ sword_t alloc_slot(struct k_mem_pool *pool_ptr, struct slot *slot_ptr, size_t si
 	word_t level;
 	word_t block;
 
-	if (sys_mem_pool_block_alloc(&pool_ptr->base, size, &level, &block, &slot_ptr->data)
+	if (k_mem_pool_block_alloc(&pool_ptr->base, size, &level, &block, &slot_ptr->data)
 		== 0)
 	{
 		slot_ptr->desc.offset = poolptr_to_offset(pool_ptr);
@@ -550,7 +599,7 @@ void free_slot(struct slot *slot_ptr)
 	struct slot_desc *desc = &slot_ptr->desc;
 	struct k_mem_pool *pool = offset_to_poolptr(desc->offset);
 
-	sys_mem_pool_block_free(&pool->base, desc->level, desc->block);
+	k_mem_pool_block_free(&pool->base, desc->level, desc->block);
 }
 
 void *malloc_object(size_t size)
@@ -610,7 +659,7 @@ void free_object(void *obj_ptr)
 		/* return block to the heap memory pool */
 		struct k_mem_pool *pool = offset_to_poolptr(desc_ptr->offset);
 
-		sys_mem_pool_block_free(&pool->base, desc_ptr->level, desc_ptr->block);
+		k_mem_pool_block_free(&pool->base, desc_ptr->level, desc_ptr->block);
 	}
 }
 
@@ -1,5 +1,6 @@
 #include <object/tcb.h>
 #include <object/ipc.h>
+#include <object/interrupt.h>
 #include <sys/math_extras.h>
 #include <sys/util.h>
 #include <model/atomic.h>
@@ -22,6 +23,8 @@
 #include <sys/assert.h>
 #include <default/default.h>
 #include <object/objecttype.h>
+#include <benchmark/thread_stats.h>
+#include <benchmark/stack_usage.h>
 
 static spinlock_t thread_conf_lock;
 
@@ -148,7 +151,7 @@ void thread_foreach(thread_user_cb_t user_cb, void *user_data)
 
 	LOCKED(&thread_conf_lock)
 	{
-		for (thread = _kernel.monitor_thread; thread != NULL; thread = thread->monitor_thread_next) 
+		for (thread = _kernel.monitor_thread; thread != NULL; thread = thread->cold.monitor_thread_next) 
 		{
 			user_cb(thread, user_data);
 		}
@@ -162,22 +165,24 @@ void thread_foreach_exit(struct ktcb *thread)
 {
 	LOCKED(&thread_conf_lock)
 	{
+		stack_usage_thread_exit(thread);
+
 		if (thread == _kernel.monitor_thread) 
 		{
-			_kernel.monitor_thread = _kernel.monitor_thread->monitor_thread_next;
+			_kernel.monitor_thread = _kernel.monitor_thread->cold.monitor_thread_next;
 		} 
 		else 
 		{
 			struct ktcb *prev_thread = _kernel.monitor_thread;
 
-			while ((prev_thread != NULL) && (thread != prev_thread->monitor_thread_next)) 
+			while ((prev_thread != NULL) && (thread != prev_thread->cold.monitor_thread_next)) 
 			{
-				prev_thread = prev_thread->monitor_thread_next;
+				prev_thread = prev_thread->cold.monitor_thread_next;
 			}
 			
 			if (prev_thread != NULL) 
 			{
-				prev_thread->monitor_thread_next = thread->monitor_thread_next;
+				prev_thread->cold.monitor_thread_next = thread->cold.monitor_thread_next;
 			}
 		}
 	}
@@ -197,12 +202,12 @@ void thread_set_name(struct ktcb *thread, const string value)
 		thread = _current_thread;
 	}
 	
-	strncpy(thread->name, value, CONFIG_THREAD_MAX_NAME_LEN);
-	thread->name[CONFIG_THREAD_MAX_NAME_LEN - 1] = '\0';
+	strncpy(thread->cold.name, value, CONFIG_THREAD_MAX_NAME_LEN);
+	thread->cold.name[CONFIG_THREAD_MAX_NAME_LEN - 1] = '\0';
 }
 const string thread_get_name(struct ktcb *thread)
 {
-	return (const string)thread->name;
+	return (const string)thread->cold.name;
 }
 #endif
 
@@ -260,7 +265,7 @@ void check_stack_sentinel(void)
 		return;
 	}
 
-	stack = (word_t *)_current_thread->stack_info.start;
+	stack = (word_t *)_current_thread->cold.stack_info.start;
 	
 	if (*stack != STACSENTINEL) 
 	{
@@ -434,19 +439,23 @@ struct ktcb *thread_init(struct ktcb *thread, s8_t *stack_start, size_t stack_si
 	set_base(&thread->base, state_restart_state, options);
 
 	/* static record_threads overwrite it afterwards with real value */
-	thread->abort_handle = NULL;
+	thread->cold.abort_handle = NULL;
 
 #ifdef CONFIG_ERRNO
-	thread->errno_var = 0;
+	thread->cold.errno_var = 0;
 #endif
 
 #ifdef CONFIG_THREAD_NAME
-	thread->name[0] = '\0';
+	thread->cold.name[0] = '\0';
 #endif
 
 #if defined(CONFIG_THREAD_STACK_INFO)
-	thread->stack_info.start = (uintptr_t)stack_start;
-	thread->stack_info.size = (word_t)stack_size;
+	thread->cold.stack_info.start = (uintptr_t)stack_start;
+	thread->cold.stack_info.size = (word_t)stack_size;
+#endif
+
+#if defined(CONFIG_STACK_USAGE)
+	thread->cold.stack_info.unused = stack_size;
 #endif
 
 	thread->ready_q_next = NULL;
@@ -457,6 +466,8 @@ struct ktcb *thread_init(struct ktcb *thread, s8_t *stack_start, size_t stack_si
 	
 	thread->notifation_node = NULL;
 
+	thread_stats_init(thread);
+
 	return(thread);
 }
 
@@ -465,6 +476,7 @@ void thread_deinit(struct ktcb *thread)
 {
 	assert(thread != NULL);
 
+	interrupt_release(thread);
 	delete_from_threads(GLOBALID_TO_TID(thread->thread_id));
 }
 
@@ -475,10 +487,10 @@ FUNC_NORETURN void thread_user_mode_enter(ktcb_entry_t entry,
 	_current_thread->base.option &= ~option_essential_option;
 
 #if defined(CONFIG_THREAD_MONITOR) 
-	_current_thread->entry.entry_ptr = entry;
-	_current_thread->entry.para1 = p1;
-	_current_thread->entry.para2 = p2;
-	_current_thread->entry.para3 = p3;
+	_current_thread->cold.monitor_thread_function.entry_ptr = entry;
+	_current_thread->cold.monitor_thread_function.para1 = p1;
+	_current_thread->cold.monitor_thread_function.para2 = p2;
+	_current_thread->cold.monitor_thread_function.para3 = p3;
 #endif
 
 #if defined(CONFIG_USERSPACE) 
@@ -502,6 +514,11 @@ struct ktcb *thread_alloc(word_t id)
 	{
 		return (_current_thread);
 	}
+
+	if (record_thread_count >= THREAD_TABLE_SIZE)
+	{
+		return (NULL);
+	}
 	
 	struct ktcb *new_thread = (struct ktcb *)d_object_alloc(obj_thread_obj, 0);
 	struct thread_sched *new_sched = (struct thread_sched *)d_object_alloc(obj_sched_context_obj, 0);
@@ -686,19 +703,19 @@ void set_new_thread(struct ktcb *new_thread, struct thread_stack *stack,
 		       			void *p1, void *p2, void *p3, word_t options)
 {
 #if defined(CONFIG_USERSPACE) 
-	new_thread->userspace_stack_point = stack;
+	new_thread->cold.userspace_stack_point = stack;
 	k_object_access_grant(new_thread, new_thread);
 #endif
 	stack_size = adjust_stack_size(stack_size);
 	arch_new_thread(new_thread, stack, stack_size, entry, p1, p2, p3, options);
 #if defined(CONFIG_THREAD_MONITOR) 
-	LOCKED(thread_conf_lock)
+	LOCKED(&thread_conf_lock)
 	{
-		new_thread->monitor_thread_function.entry_ptr  = entry;
-		new_thread->monitor_thread_function.para1  = p1;
-		new_thread->monitor_thread_function.para2  = p2;
-		new_thread->monitor_thread_function.para3  = p3;
-		new_thread->monitor_thread_next	= _kernel.monitor_thread;
+		new_thread->cold.monitor_thread_function.entry_ptr  = entry;
+		new_thread->cold.monitor_thread_function.para1  = p1;
+		new_thread->cold.monitor_thread_function.para2  = p2;
+		new_thread->cold.monitor_thread_function.para3  = p3;
+		new_thread->cold.monitor_thread_next	= _kernel.monitor_thread;
 		_kernel.monitor_thread  = new_thread;
 	}
 #endif
@@ -709,10 +726,10 @@ void set_new_thread(struct ktcb *new_thread, struct thread_stack *stack,
 #endif
 #if defined(CONFIG_USERSPACE) 
 	/* New threads inherit any memory domain membership by the parent */
-	if (_current_thread->userspace_fpage_table.pagetable_item != NULL) 
-		add_to_page_table(_current_thread->userspace_fpage_table.pagetable_item, new_thread);
+	if (_current_thread->cold.userspace_fpage_table.pagetable_item != NULL) 
+		add_to_page_table(_current_thread->cold.userspace_fpage_table.pagetable_item, new_thread);
 	else
-		new_thread->userspace_fpage_table.pagetable_item = NULL;
+		new_thread->cold.userspace_fpage_table.pagetable_item = NULL;
 #endif
 }
 
@@ -904,9 +921,9 @@ void thread_single_abort(struct ktcb *thread)
 {
 	assert(thread != NULL);
 
-	if (thread->abort_handle) 
+	if (thread->cold.abort_handle) 
 	{
-		thread->abort_handle();
+		thread->cold.abort_handle();
 	}
 
 #ifdef CONFIG_SMP
@@ -968,6 +985,7 @@ void thread_yield(struct ktcb *thread)
 			else
 			{
 				_current_thread->yield = thread;
+				thread_stats_voluntary(_current_thread);
 				sched_dequeue(thread);
 				if (!IS_ENABLED(CONFIG_SMP))
 				{
@@ -1271,7 +1289,7 @@ exception_t syscall_thread_control(
 			{
 				/* create the thread */
 				struct ktcb *new_thread = thread_alloc(dest_thread_id);
-				struct pager_context *pager = (struct pager_context *)dest_pager_id;
+				struct pager_context *pager = (struct pager_context *)(uintptr_t)dest_pager_id;
 				
 				if (!new_thread)
 				{
@@ -1370,6 +1388,7 @@ exception_t syscall_switch_thread(word_t dest_thread_id)
 		{
 			/* something */
 			remove_from_ready_q(_current_thread);
+			thread_stats_voluntary(_current_thread);
 			set_thread_state(_current_thread, state_restart_state);
 			reschedule_required();
 		}
@@ -1439,7 +1458,7 @@ exception_t syscall_switch_thread(word_t dest_thread_id)
 */
 
 /* dest_time:budget | period | max_refills */
-/* dest_process:processer number */
+/* dest_process:timer slack ticks | processer number */
 /* dest_prior:mcp | prior */
 /* dest_domain:domain number */
 
@@ -1457,8 +1476,8 @@ exception_t syscall_schedule_control(
 
 	if (is_sufficient)
 	{
-		ARG_UNUSED(dest_process);
 		struct ktcb *dest_thread = get_thread(dest_thread_id);
+		word_t slack = GET_UNIT(dest_process, SCHEDULER_SLACK_MASK) >> 16;
 		
 		prio_t sched_prior = GET_UNIT(dest_prior, SCHEDULER_PRIORITY_MASK);
 		prio_t mcp = GET_UNIT(dest_prior, SCHEDULER_MCP_MASK) >> 12;
@@ -1486,7 +1505,7 @@ exception_t syscall_schedule_control(
 			return EXCEPTION_SYSCALL_ERROR;
 		}
 		
-		if (sched_prior > mcp || sched_prior > NUM_PRIORITIES || mcp > NUM_PRIORITIES)
+		if (sched_prior > mcp || sched_prior >= NUM_PRIORITIES || mcp >= NUM_PRIORITIES)
 		{
 			user_error("THREAD Object: Illegal operation attempted - priority.");
 			current_syscall_error_code = TCR_INVAL_PARA;
@@ -1553,6 +1572,11 @@ exception_t syscall_schedule_control(
 		set_thread_action(dest_thread, level);
 		set_domain(dest_thread, dest_domain);
 		set_schedule_context(dest_thread, budget, period, refills);
+#if defined(CONFIG_TIMER_SLACK)
+		dest_thread->cold.timer_slack = slack;
+#else
+		ARG_UNUSED(slack);
+#endif
 		
 		reschedule_required();
 	
@@ -3,6 +3,7 @@
 #include <object/objecttype.h>
 #include <kernel/cspace.h>
 #include <sys/errno.h>
+#include <api/errno.h>
 #include <state/statedata.h>
 #include <api/syscall.h>
 #include <model/preemption.h>
@@ -56,26 +57,103 @@ sword_t do_user_string_copy(char *dst, const char *src, size_t maxlen)
 }
 
 
+void untyped_region_init(struct untyped_region *region, word_t size)
+{
+	region->size = size;
+	region->free_offset = 0;
+	region->zeroed = 0;
+	region->watermark = 0;
+	region->children = 0;
+}
+
+/* clear with unrolled double word stores, the compiler turns them into store multiples */
+static void untyped_zero_chunk(byte_t *start, size_t len)
+{
+	dword_t *dst = (dword_t *)start;
+	size_t n = len / sizeof(dword_t);
+
+	for (; n >= 4; n -= 4, dst += 4)
+	{
+		dst[0] = 0;
+		dst[1] = 0;
+		dst[2] = 0;
+		dst[3] = 0;
+	}
+
+	for (; n > 0; n--)
+	{
+		*dst++ = 0;
+	}
+
+	(void)memset(dst, 0, len % sizeof(dword_t));
+}
+
+/* Only memory below the watermark was handed out before and can be dirty,
+ * memory above it is still clear from when the untyped was created. The
+ * progress is kept in region->zeroed so a preempted call restarts where it
+ * stopped.
+ */
+static exception_t untyped_zero_range(struct untyped_region *region, word_t end)
+{
+	byte_t *memory = untyped_region_memory(region);
+	word_t start = MAX(region->free_offset, region->zeroed);
+	word_t stop = MIN(end, region->watermark);
+	word_t len;
+	exception_t status;
+
+	while (start < stop)
+	{
+		len = MIN(stop - start, CONFIG_UNTYPED_ZERO_CHUNK_SIZE);
+		untyped_zero_chunk(memory + start, len);
+		start += len;
+		region->zeroed = start;
+
+		status = preemption_point();
+		if (status != EXCEPTION_NONE)
+		{
+			return status;
+		}
+	}
+
+	return EXCEPTION_NONE;
+}
+
 /* the untyped is the memory of you can put any type object , so you need give a user type and size */
 static exception_t reset_untyped_object(struct d_object *src, size_t src_size)
 {
-	exception_t status;
+	struct untyped_region *region = untyped_region_of(src);
 
-	memset((char *)&src->k_obj_self, 0, get_k_object_size(src->k_obj.type, src_size));
-	status = preemption_point();
-	if (status != EXCEPTION_NONE)
+	ARG_UNUSED(src_size);
+
+	/* the carved objects still live in the memory a rewind hands out again */
+	if (region->children != 0)
 	{
-		return status;
+		user_error("Untyped Retype: Carved objects are still live.");
+		current_syscall_error_code = TCR_INVAL_PARA;
+		return EXCEPTION_SYSCALL_ERROR;
 	}
+
+	/* rewind only, used memory is cleared again when it is carved */
+	region->free_offset = 0;
+	region->zeroed = 0;
 	
 	return EXCEPTION_NONE;
 }
 
-exception_t retype_untyped_object(struct d_object *dest, enum obj_tag user_type,
+/* one object, carved like a bulk retype at the watermark and cleared first,
+ * so it never shows what the memory held before */
+exception_t retype_untyped_object(void **object, enum obj_tag user_type,
 	bool_t reset, size_t user_size, struct d_object *src)
 {
 	exception_t status;
 
+	if (src == NULL)
+	{
+		user_error("Untyped Retype: Invalid untyped object.");
+		current_syscall_error_code = TCR_INVAL_PARA;
+		return EXCEPTION_SYSCALL_ERROR;
+	}
+
 	if (reset)
 	{
 		status = reset_untyped_object(src, user_size);
@@ -85,20 +163,52 @@ exception_t retype_untyped_object(struct d_object *dest, enum obj_tag user_type,
 		}
 	}
 
-	if (src == NULL)
+	return retype_untyped_bulk_object(src, user_type, user_size, 1, object);
+}
+
+exception_t retype_untyped_bulk_object(struct d_object *src, enum obj_tag user_type,
+	size_t user_size, word_t number, void **objects)
+{
+	struct untyped_region *region = untyped_region_of(src);
+	byte_t *memory = untyped_region_memory(region);
+	struct untyped_child *child;
+	size_t obj_size;
+	size_t total;
+	word_t end;
+	word_t index;
+	exception_t status;
+
+	obj_size = WB_UP(sizeof(struct untyped_child) + sizeof(struct d_object) + 
+		get_k_object_size(user_type, user_size));
+	if (size_mul_overflow(obj_size, number, &total) || 
+		total > region->size - region->free_offset)
 	{
-		dest = src;
-		dest->k_obj.type = user_type;
-		return EXCEPTION_NONE;
+		user_error("Untyped Retype: Not enough untyped memory.");
+		current_syscall_error_code = TCR_OUT_OF_MEM;
+		return EXCEPTION_SYSCALL_ERROR;
 	}
-	
-	dest = d_object_alloc(user_type, user_size);
-	if (dest == NULL) 
+
+	end = region->free_offset + total;
+
+	/* the only long part, preemptible and restartable */
+	status = untyped_zero_range(region, end);
+	if (status != EXCEPTION_NONE)
+	{
+		return status;
+	}
+
+	for (index = 0; index < number; index++)
 	{
-		return EXCEPTION_LOOKUP_FAULT;
+		child = (struct untyped_child *)(memory + region->free_offset + index * obj_size);
+		child->parent = region;
+		objects[index] = d_object_carve(child + 1, user_type);
 	}
 
-	(void)memcpy(dest->k_obj.name, src->k_obj.name, user_size);
+	region->children += number;
+	region->free_offset = end;
+	region->zeroed = end;
+	region->watermark = MAX(region->watermark, end);
+
 	return EXCEPTION_NONE;
 }
 
@@ -114,12 +224,10 @@ exception_t syscall_retype_untyped(void *kobject,
 
 	if (is_sufficient)
 	{
-		sword_t errno;
 		bool_t reset;
-		word_t obj_size;
 		exception_t status;
 		struct d_object *src = NULL;
-		struct d_object *dest = NULL;
+		void *object;
 #if(0)
 		if (inv_level != memory_control)
 		{
@@ -127,18 +235,18 @@ exception_t syscall_retype_untyped(void *kobject,
 			return EXCEPTION_SYSCALL_ERROR;
 		}
 #endif
-		if (user_type >= obj_last_obj)
+		if (user_type >= obj_last_obj || user_type == obj_untyped_obj)
 		{
 			user_error("Untyped Retype: Invalid object type.");
 			return EXCEPTION_SYSCALL_ERROR;
 		}
 	
-		obj_size = get_k_object_size(user_type, user_size);
-		/* check obj_size is right */
-	
+		/* a new untyped just big enough for the one object */
 		if (kobject == NULL)
 		{
-			kobject = d_object_alloc(obj_untyped_obj, user_size);
+			kobject = d_object_alloc(obj_untyped_obj, 
+				WB_UP(sizeof(struct untyped_child) + sizeof(struct d_object) + 
+				get_k_object_size(user_type, user_size)));
 			if (kobject == NULL)
 			{
 				return EXCEPTION_LOOKUP_FAULT;
@@ -146,32 +254,11 @@ exception_t syscall_retype_untyped(void *kobject,
 		}
 		
 		src = d_object_find(kobject);
-		if (src == NULL)
+		if (src == NULL || src->k_obj.type != obj_untyped_obj)
 		{
 			user_error("Untyped Retype: Invalid destination address.");
 			return EXCEPTION_SYSCALL_ERROR;
 		}
-		else
-		{
-#if defined(CONFIG_USERSPACE)
-			size_t actual_len;
-	
-			actual_len = user_string_nlen(src->k_obj.name, user_size, &errno);		
-			if (errno != 0 || actual_len == user_size || \
-				size_add_overflow(actual_len, 1, &actual_len))
-			{
-				user_error("Untyped Object: Illegal operation attempted.");
-				return EXCEPTION_SYSCALL_ERROR;
-			}
-			
-			/* Does the caller in user mode have access to read this memory? */
-			if (SYSCALL_MEMORY_READ(src->k_obj.name, user_size))
-			{
-				user_error("Untyped Object: Illegal operation attempted.");
-				return EXCEPTION_SYSCALL_ERROR;
-			}
-#endif
-		}
 		
 		if (is_d_object_no_child(src))
 		{
@@ -183,20 +270,65 @@ exception_t syscall_retype_untyped(void *kobject,
 		}
 		
 		set_thread_state(_current_thread, state_restart_state);
-		status = retype_untyped_object(dest, user_type, reset, obj_size, src);
+		status = retype_untyped_object(&object, user_type, reset, user_size, src);
 		if (status != EXCEPTION_NONE)
 		{
 			return status;
 		}
-		
+	
+		schedule();
+		/* reschedule_unlocked(); */
+	
+		return EXCEPTION_NONE;
+
+	}
+	return EXCEPTION_FAULT;
+}
+
+exception_t syscall_retype_untyped_bulk(void *kobject, enum obj_tag user_type,
+	size_t user_size, word_t number, void **objects)
+{
+	bool_t is_sufficient = false;
+	
+	update_timestamp(false);
+	is_sufficient = check_budget_restart();
+
+	if (is_sufficient)
+	{
+		exception_t status;
+		struct d_object *src;
+
+		if (user_type >= obj_last_obj || user_type == obj_untyped_obj || 
+			number == 0 || number > CONFIG_UNTYPED_RETYPE_MAX_NUMBER)
+		{
+			user_error("Untyped Retype: Invalid object type or number.");
+			current_syscall_error_code = TCR_INVAL_PARA;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+
+		src = d_object_find(kobject);
+		if (src == NULL || src->k_obj.type != obj_untyped_obj)
+		{
+			user_error("Untyped Retype: Invalid untyped object.");
+			current_syscall_error_code = TCR_INVAL_PARA;
+			return EXCEPTION_SYSCALL_ERROR;
+		}
+
 #if defined(CONFIG_USERSPACE)
-		if (SYSCALL_MEMORY_WRITE(dest->k_obj.name, user_size))
+		if (SYSCALL_MEMORY_ARRAY_WRITE(objects, number, sizeof(void *)))
 		{
 			user_error("Untyped Object: Illegal operation attempted.");
+			current_syscall_error_code = TCR_INVAL_PARA;
 			return EXCEPTION_SYSCALL_ERROR;
 		}
 #endif
-	
+
+		set_thread_state(_current_thread, state_restart_state);
+		status = retype_untyped_bulk_object(src, user_type, user_size, number, objects);
+		if (status != EXCEPTION_NONE)
+		{
+			return status;
+		}
 	
 		schedule();
 		/* reschedule_unlocked(); */
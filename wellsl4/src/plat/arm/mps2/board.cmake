@@ -0,0 +1,19 @@
+# SPDX-License-Identifier: Apache-2.0
+
+set(EMU_PLATFORM qemu)
+
+if(CONFIG_BOARD_MPS2_AN386)
+  set(QEMU_CPU_TYPE_${ARCH} cortex-m4)
+  set(QEMU_MACHINE_${ARCH} mps2-an386)
+else()
+  set(QEMU_CPU_TYPE_${ARCH} cortex-m3)
+  set(QEMU_MACHINE_${ARCH} mps2-an385)
+endif()
+
+set(QEMU_FLAGS_${ARCH}
+  -cpu ${QEMU_CPU_TYPE_${ARCH}}
+  -machine ${QEMU_MACHINE_${ARCH}}
+  -nographic
+  -vga none
+  )
+board_set_debugger_ifnset(qemu)
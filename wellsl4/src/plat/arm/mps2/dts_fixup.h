@@ -0,0 +1,12 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/* SoC level DTS fixup file */
+
+#define DT_NUM_IRQ_PRIO_BITS	DT_ARM_V7M_NVIC_E000E100_ARM_NUM_IRQ_PRIORITY_BITS
+
+#define DT_UART_CMSDK_APB_CONSOLE_BASE_ADDRESS	DT_INST_0_ARM_CMSDK_UART_BASE_ADDRESS
+#define DT_UART_CMSDK_APB_CONSOLE_BAUD_RATE	DT_INST_0_ARM_CMSDK_UART_CURRENT_SPEED
+
+#define DT_CMSDK_APB_PROFILE_TIMER_BASE_ADDRESS	DT_INST_0_ARM_CMSDK_TIMER_BASE_ADDRESS
+#define DT_CMSDK_APB_PROFILE_TIMER_IRQ		DT_INST_0_ARM_CMSDK_TIMER_IRQ_0
+#define DT_CMSDK_APB_PROFILE_TIMER_IRQ_PRIORITY	DT_INST_0_ARM_CMSDK_TIMER_IRQ_0_PRIORITY
@@ -1,10 +1,12 @@
 #include <state/statedata.h>
 #include <linker/sections.h>
+#include <linker/section_tags.h>
+#include <generated_dts_board.h>
 #include <user/anode.h>
 
 fastipc_path_t fastipc_caller;
 
-struct ktcb *record_threads[256];
+struct ktcb *record_threads[THREAD_TABLE_SIZE];
 word_t record_thread_count;
 
 word_t work_units_completed;
@@ -12,8 +14,12 @@ word_t work_units_completed;
 struct thread_sched *current_sched;
 struct ktcb *current_thread;
 
+#if defined(CONFIG_KERNEL_HOT_DATA_DTCM) && !defined(DT_DTCM_BASE_ADDRESS)
+#error "KERNEL_HOT_DATA_DTCM needs a DTCM region in the devicetree"
+#endif
+
 /* the only struct __kernel instance */
-struct kernel _kernel;
+__kernel_hot_bss struct kernel _kernel;
 
 /* Values of 0 and ~0 encode ResumeCurrentThread and ChooseNewThread
  * respectively; other values encode SwitchToThread and must be valid
@@ -23,7 +29,7 @@ struct ktcb *scheduler_action;
 /* struct tcb_cause *induced_causes; */
 
 /* ready queue */
-struct tcb_queue ready_queues[NUM_READY_QUEUES]; 	 /*index:prior*/
+__kernel_hot_bss struct tcb_queue ready_queues[NUM_READY_QUEUES]; 	 /*index:prior*/
 
 /* thread message node */
 /* message_t message_queues[CONFIG_MAX_MESSAGE_NODES_ALL]; */
@@ -37,8 +43,10 @@ struct ktcb *release_queue;
 bool_t reprogram;
 
 /* ready queue bitmap by sched_prior */
-word_t ready_queues_l1_bitmap[CONFIG_NUM_DOMAINS];
-word_t ready_queues_l2_bitmap[CONFIG_NUM_DOMAINS][L2_BITMAP_BITS];
+__kernel_hot_bss word_t ready_queues_l1_bitmap[CONFIG_NUM_DOMAINS];
+#if SCHED_BITMAP_LEVELS > 1
+__kernel_hot_bss word_t ready_queues_l2_bitmap[CONFIG_NUM_DOMAINS][L2_BITMAP_BITS];
+#endif
 
 /* time */
 /* the amount of time passed since the kernel time was last updated */
@@ -47,6 +55,12 @@ ticks_t consume_time;	/*usage time length*/
 /* the _current_thread kernel time (recorded on kernel entry) */
 ticks_t current_time;	/*_current_thread time point*/
 
+#if defined(CONFIG_SCHED_BUDGET_CYCLES)
+/* cycle count at the last kernel entry and the sub-tick part of consume_time */
+u64_t current_cycle_time;
+u64_t consume_cycle;
+#endif
+
 /* Domain timeslice remaining */
 ticks_t current_domain_time;	/*domain can use time*/
 
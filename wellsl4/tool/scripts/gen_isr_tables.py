@@ -121,6 +121,8 @@ def parse_args():
             help="Generate SW ISR table")
     parser.add_argument("-V", "--vector-table", action="store_true",
             help="Generate vector table")
+    parser.add_argument("-q", "--irq-object-table", action="store_true",
+            help="Generate IRQ object table")
     parser.add_argument("-i", "--intlist", required=True,
             help="WellL4 intlist binary for intList extraction")
 
@@ -142,11 +144,30 @@ source_header = """
 
 """
 
-def write_source_file(fp, vt, swt, intlist, syms):
+irq_object_header = """
+#include <kernel_object.h>
+#include <object/interrupt.h>
+
+"""
+
+def write_irq_object_table(fp, nv, reserved):
+    fp.write(irq_object_header)
+    fp.write("struct interrupt irq_object_table[%d] = {\n" % nv)
+    for i in range(nv):
+        state = ("interrupt_irq_reserved" if i in reserved
+                 else "interrupt_irq_inactive")
+        fp.write("\t{{NULL, NULL, {0}, interrupt_action_number, {1}}},\n".
+                 format(i, state))
+    fp.write("};\n")
+
+def write_source_file(fp, vt, swt, intlist, syms, reserved):
     fp.write(source_header)
 
     nv = intlist["num_vectors"]
 
+    if args.irq_object_table:
+        write_irq_object_table(fp, nv, reserved)
+
     if vt:
         fp.write("u32_t __irq_vector_table irq_vector_table[%d] = {\n" % nv)
         for i in range(nv):
@@ -254,6 +275,12 @@ def main():
             error("one or both of -s or -V needs to be specified on command line")
         swt = None
 
+    # Lines connected statically by the kernel can not be bound by threads,
+    # except the kernel timer which is handed out as a timer IRQ.
+    timer_irq = syms.get("CONFIG_KERNEL_TIMER_INT")
+    reserved = set(irq - offset for irq, _, _, _ in intlist["interrupts"]
+                   if irq != timer_irq)
+
     for irq, flag, func, param in intlist["interrupts"]:
         if flag & isr_direct_isr:
             if param != 0:
@@ -310,7 +337,7 @@ def main():
             swt[table_index] = (param, func)
 
     with open(args.output_source, "w") as fp:
-        write_source_file(fp, vt, swt, intlist, syms)
+        write_source_file(fp, vt, swt, intlist, syms, reserved)
 
 if __name__ == "__main__":
     main()
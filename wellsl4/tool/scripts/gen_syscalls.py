@@ -46,6 +46,24 @@ noweak = ["handle_space_control","handle_processor_control","handle_system_clock
         "handle_dobject_alloc","handle_dobject_free","handle_kobject_access_grant",
         "handle_kobject_access_revoke","handle_retype_untyped"]
 
+# Hot system calls that get their own SVC number on architectures defining
+# it, see arch_syscall_direct_invoke*(). Entering through the immediate skips
+# loading the call id and the dispatch table lookup in the kernel.
+direct_svc = {
+    "exchange_ipc": "_SVC_CALL_EXCHANGE_IPC",
+    "switch_thread": "_SVC_CALL_SWITCH_THREAD",
+    "system_clock": "_SVC_CALL_SYSTEM_CLOCK",
+}
+
+# Types that fit a register and convert to and from uintptr_t with a plain
+# cast. Arguments of these types are passed by value, without taking their
+# address, so they stay in registers in the stubs. Pointers and enums are
+# always handled this way.
+scalar_types = ["word_t", "sword_t", "uintptr_t", "intptr_t",
+        "size_t", "ssize_t", "bool_t", "bool", "byte_t", "exception_t",
+        "u8_t", "u16_t", "u32_t", "s8_t", "s16_t", "s32_t",
+        "int", "unsigned int", "char", "long", "unsigned long"]
+
 table_template = """/* auto-generated by gen_syscalls.py, don't edit */
 
 /* Weak handler functions that get replaced by the real ones unless a system
@@ -149,6 +167,25 @@ def typename_split(item):
 def need_split(argtype):
     return (not args.long_registers) and (argtype in types64)
 
+def is_scalar(argtype):
+    if "*" in argtype or argtype.startswith("enum "):
+        return True
+    if argtype in types64:
+        return bool(args.long_registers)
+    return argtype.replace("const ", "") in scalar_types
+
+# Register value of an argument of the invocation
+def to_register(argtype, argname):
+    if is_scalar(argtype):
+        return "(uintptr_t)%s" % argname
+    return "*(uintptr_t *)&" + argname
+
+# Argument value from a marshalled register in the handler
+def from_register(argtype, rval):
+    if is_scalar(argtype):
+        return "(%s)%s" % (argtype, rval)
+    return "*(%s*)&%s" % (argtype, rval)
+
 # Note: "lo" and "hi" are named in little endian conventions,
 # but it doesn't matter as long as they are consistently
 # generated.
@@ -167,7 +204,7 @@ def wrapper_defs(func_name, func_type, args):
             mrsh_args.append("parm%d.split.hi" % nsplit)
             nsplit += 1
         else:
-            mrsh_args.append("*(uintptr_t *)&" + argname)
+            mrsh_args.append(to_register(argtype, argname))
 
     if ret64:
         mrsh_args.append("(uintptr_t)&ret64")
@@ -197,14 +234,28 @@ def wrapper_defs(func_name, func_type, args):
               % (len(mrsh_args),
                  ", ".join(mrsh_args + [syscall_id])))
 
-    if ret64:
-        wrap += "\t\t" + "(void)%s;\n" % invoke
-        wrap += "\t\t" + "return (%s)ret64;\n" % func_type
-    elif func_type == "void":
-        wrap += "\t\t" + "%s;\n" % invoke
-        wrap += "\t\t" + "return;\n"
+    def invoke_defs(invoke):
+        if ret64:
+            ret = "\t\t" + "(void)%s;\n" % invoke
+            ret += "\t\t" + "return (%s)ret64;\n" % func_type
+        elif func_type == "void":
+            ret = "\t\t" + "%s;\n" % invoke
+            ret += "\t\t" + "return;\n"
+        else:
+            ret = "\t\t" + "return (%s) %s;\n" % (func_type, invoke)
+        return ret
+
+    if func_name in direct_svc and len(mrsh_args) <= 4:
+        svid = direct_svc[func_name]
+        direct = ("arch_syscall_direct_invoke%d(%s)"
+                  % (len(mrsh_args), ", ".join(mrsh_args + [svid])))
+        wrap += "#if defined(CONFIG_SYSCALL_DIRECT_SVC) && defined(%s)\n" % svid
+        wrap += invoke_defs(direct)
+        wrap += "#else\n"
+        wrap += invoke_defs(invoke)
+        wrap += "#endif\n"
     else:
-        wrap += "\t\t" + "return (%s) %s;\n" % (func_type, invoke)
+        wrap += invoke_defs(invoke)
 
     wrap += "\t" + "}\n"
     wrap += "#endif\n"
@@ -233,6 +284,7 @@ def mrsh_rval(mrsh_num, total):
 
 def marshall_defs(func_name, func_type, args):
     mrsh_name = "handle_" + func_name
+    syscall_id = "K_SYSCALL_" + func_name.upper()
 
     nmrsh = 0        # number of marshalled uintptr_t parameter
     vrfy_parms = []  # list of (arg_num, mrsh_or_parm_num, bool_is_split)
@@ -260,6 +312,8 @@ def marshall_defs(func_name, func_type, args):
         mrsh += "\t\t" + "uintptr_t arg3, uintptr_t arg4, void *more, void *ssf)\n"
     mrsh += "{\n"
     mrsh += "\t" + "_current_cpu->syscall_frame_point = ssf;\n"
+    mrsh += "\t" + "wcet_syscall_enter(%s, arg0, arg1, arg2, arg3, arg4, %s);\n" % (
+        syscall_id, "(uintptr_t)more" if nmrsh > 6 else "arg5")
 
     for unused_arg in range(nmrsh, 6):
         mrsh += "\t(void) arg%d;\t/* unused */\n" % unused_arg
@@ -282,15 +336,19 @@ def marshall_defs(func_name, func_type, args):
         if is_split:
             out_args.append("parm%d.val" % argn)
         else:
-            out_args.append("*(%s*)&%s" % (args[i][0], mrsh_rval(argn, nmrsh)))
+            out_args.append(from_register(args[i][0], mrsh_rval(argn, nmrsh)))
 
     vrfy_call = "syscall_%s(%s)\n" % (func_name, ", ".join(out_args))
 
+    # The entry is timed until the implementation returns, copying out a
+    # split return value is not counted.
     if func_type == "void":
         mrsh += "\t" + "%s;\n" % vrfy_call
+        mrsh += "\t" + "wcet_syscall_exit(%s);\n" % syscall_id
         mrsh += "\t" + "return 0;\n"
     else:
         mrsh += "\t" + "%s ret = %s;\n" % (func_type, vrfy_call)
+        mrsh += "\t" + "wcet_syscall_exit(%s);\n" % syscall_id
         if need_split(func_type):
             ptr = "((u64_t *)%s)" % mrsh_rval(nmrsh - 1, nmrsh)
             mrsh += "\t" + "SYSCALL_OOPS(SYSCALL_MEMORY_WRITE(%s, 8));\n" % ptr
@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Symbolise the CONFIG_PROFILER samples against wellsl4.elf.
+
+The input is either the console output of the profile_print syscall
+("PROF ..." lines, anything else is ignored) or, with --binary, a memory
+dump of the profile_buffers array, e.g. from gdb:
+
+    dump binary memory prof.bin &profile_buffers ((char *)&profile_buffers) + sizeof(profile_buffers)
+
+The default output is a flat profile, the functions sorted by the share
+of samples their PC fell in. With --folded the samples are written as
+folded stacks, "thread;caller;function count" per line, ready for
+flamegraph.pl or speedscope. The caller is the function the stacked LR
+points into, one level only and only where the sample source records it.
+Sample and buffer layouts must match inc/benchmark/profile.h.
+"""
+
+import argparse
+import bisect
+import collections
+import re
+import shutil
+import struct
+import subprocess
+import sys
+
+BUFFER_MAGIC = 0x4650344c
+BUFFER_HEADER = struct.Struct("<IIIIII8x")
+SAMPLE_LAYOUTS = {
+    16: struct.Struct("<IIII"),
+    24: struct.Struct("<QQII"),
+}
+
+SAMPLE_USER = 1 << 0
+SAMPLE_ISR = 1 << 1
+
+
+class Sample:
+    __slots__ = ("cpu", "pc", "lr", "thread", "flags")
+
+    def __init__(self, cpu, pc, lr, thread, flags):
+        self.cpu = cpu
+        self.pc = pc
+        self.lr = lr
+        self.thread = thread
+        self.flags = flags
+
+
+def parse_text(lines):
+    samples = []
+    cpu = None
+    head_re = re.compile(r"PROF buf cpu=(\d+) head=(\d+) samples=(\d+) hz=(\d+)")
+    sample_re = re.compile(r"PROF s ([0-9a-f]+) ([0-9a-f]+) ([0-9a-f]+) ([0-9a-f]+)")
+
+    for line in lines:
+        m = head_re.search(line)
+        if m:
+            cpu = int(m.group(1))
+            continue
+
+        m = sample_re.search(line)
+        if m and cpu is not None:
+            pc, lr, thread, flags = (int(g, 16) for g in m.groups())
+            samples.append(Sample(cpu, pc, lr, thread, flags))
+
+    return samples
+
+
+def parse_binary(data):
+    samples = []
+    offset = 0
+
+    while offset + BUFFER_HEADER.size <= len(data):
+        magic, size, count, cpu, hz, head = BUFFER_HEADER.unpack_from(data, offset)
+        if magic != BUFFER_MAGIC:
+            if offset == 0:
+                sys.exit("no profile buffer at the start of the dump, wrong address?")
+            break
+        if size not in SAMPLE_LAYOUTS:
+            sys.exit("sample size %d, this script knows %s" %
+                     (size, sorted(SAMPLE_LAYOUTS)))
+
+        layout = SAMPLE_LAYOUTS[size]
+        base = offset + BUFFER_HEADER.size
+        for idx in range(max(head - count, 0), head):
+            slot = base + (idx % count) * size
+            pc, lr, thread, flags = layout.unpack_from(data, slot)
+            samples.append(Sample(cpu, pc, lr, thread, flags))
+
+        offset = base + count * size
+
+    return samples
+
+
+class Symbols:
+    """Address to function name, from the ELF symbol table."""
+
+    def __init__(self, elf, nm):
+        self.addrs = []
+        self.names = []
+        self.ends = []
+        funcs = self.load_pyelftools(elf)
+        if funcs is None:
+            funcs = self.load_nm(elf, nm)
+
+        for addr, size, name in sorted(funcs):
+            self.addrs.append(addr)
+            self.ends.append(addr + max(size, 1))
+            self.names.append(name)
+
+    @staticmethod
+    def load_pyelftools(elf):
+        try:
+            from elftools.elf.elffile import ELFFile
+            from elftools.elf.sections import SymbolTableSection
+        except ImportError:
+            return None
+
+        funcs = []
+        with open(elf, "rb") as f:
+            for section in ELFFile(f).iter_sections():
+                if not isinstance(section, SymbolTableSection):
+                    continue
+                for sym in section.iter_symbols():
+                    if sym["st_info"]["type"] != "STT_FUNC":
+                        continue
+                    # bit 0 of a Thumb function address is the mode bit
+                    funcs.append((sym["st_value"] & ~1, sym["st_size"], sym.name))
+        return funcs
+
+    @staticmethod
+    def load_nm(elf, nm):
+        if shutil.which(nm) is None:
+            sys.exit("neither pyelftools nor %s is available" % nm)
+
+        out = subprocess.run([nm, "-S", "--defined-only", elf], check=True,
+                             stdout=subprocess.PIPE, universal_newlines=True)
+        funcs = []
+        for line in out.stdout.splitlines():
+            fields = line.split()
+            if len(fields) == 4 and fields[2] in "tTwW":
+                funcs.append((int(fields[0], 16) & ~1, int(fields[1], 16), fields[3]))
+        return funcs
+
+    def lookup(self, addr):
+        idx = bisect.bisect_right(self.addrs, addr) - 1
+        if idx >= 0 and addr < self.ends[idx]:
+            return self.names[idx]
+        return "0x%x" % addr
+
+
+def thread_name(sample):
+    if sample.flags & SAMPLE_ISR:
+        return "isr"
+    return "thread_%x" % sample.thread
+
+
+def flat(samples, symbols, out):
+    total = len(samples)
+    funcs = collections.Counter()
+    user = collections.Counter()
+
+    for sample in samples:
+        name = symbols.lookup(sample.pc & ~1)
+        funcs[name] += 1
+        if sample.flags & SAMPLE_USER:
+            user[name] += 1
+
+    out.write("%d samples\n\n" % total)
+    out.write("%8s %7s %6s  %s\n" % ("samples", "%", "user%", "function"))
+    for name, count in funcs.most_common():
+        out.write("%8d %6.2f%% %5.1f%%  %s\n" % (count, 100.0 * count / total,
+                  100.0 * user[name] / count, name))
+
+
+def folded(samples, symbols, out):
+    stacks = collections.Counter()
+
+    for sample in samples:
+        frames = ["cpu%d" % sample.cpu, thread_name(sample)]
+        # LR holds the return address, look up the call instruction before it
+        if sample.lr and sample.lr < 0xfffffff0:
+            frames.append(symbols.lookup((sample.lr & ~1) - 2))
+        frames.append(symbols.lookup(sample.pc & ~1))
+        stacks[";".join(frames)] += 1
+
+    for stack, count in sorted(stacks.items()):
+        out.write("%s %d\n" % (stack, count))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="console log, or memory dump with --binary")
+    parser.add_argument("-e", "--elf", required=True, help="wellsl4.elf")
+    parser.add_argument("-b", "--binary", action="store_true",
+                        help="input is a raw dump of profile_buffers")
+    parser.add_argument("--folded", action="store_true",
+                        help="write folded stacks instead of a flat profile")
+    parser.add_argument("--thread", type=lambda x: int(x, 0),
+                        help="only the samples of this thread id")
+    parser.add_argument("--nm", default="nm",
+                        help="nm to read the symbols with when pyelftools is missing")
+    parser.add_argument("-o", "--output", default="-",
+                        help="output file, '-' for stdout")
+    args = parser.parse_args()
+
+    if args.binary:
+        with open(args.input, "rb") as f:
+            samples = parse_binary(f.read())
+    else:
+        with open(args.input, errors="replace") as f:
+            samples = parse_text(f)
+
+    if args.thread is not None:
+        samples = [s for s in samples if s.thread == args.thread]
+
+    if not samples:
+        sys.exit("no profile samples found in %s" % args.input)
+
+    symbols = Symbols(args.elf, args.nm)
+    report = folded if args.folded else flat
+
+    if args.output == "-":
+        report(samples, symbols, sys.stdout)
+    else:
+        with open(args.output, "w") as out:
+            report(samples, symbols, out)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Turn the CONFIG_STACK_USAGE high-water marks into stack sizes.
+
+The input is the console output of the stack_usage_print syscall
+("STACK ..." lines, anything else is ignored), one or more logs of the
+same build. A stack seen in several dumps keeps its deepest mark.
+
+For every stack the report lists its size, the high-water mark, the
+recommended size (the mark plus CONFIG_STACK_USAGE_MARGIN percent) and
+what shrinking it to that would give back. The stacks of the kernel are
+named after their Kconfig option; with --elf the stacks of the
+application are named after the symbol they are defined by, e.g.
+THREAD_STACK_DEFINE(driver_stack, ...).
+
+With --conf-out the recommendations for the kernel stacks are written as
+a Kconfig fragment to add to project.conf for the next build. The idle
+and ISR stacks of all cpus share one option and take the largest of
+them. A mark is only as deep as the paths that ran while it was taken,
+run the application through its worst cases first.
+"""
+
+import argparse
+import bisect
+import re
+import shutil
+import subprocess
+import sys
+
+STACK_RE = re.compile(r"STACK name=(\S+) start=([0-9a-f]+) size=(\d+) "
+                      r"used=(\d+) recommend=(\d+)")
+
+# kernel stack name, without the cpu number, to its option
+KERNEL_STACKS = {
+    "main": "CONFIG_MAIN_STACK_SIZE",
+    "idle": "CONFIG_IDLE_STACK_SIZE",
+    "privilege": "CONFIG_PRIVILEGE_STACK_SIZE",
+    "isr": "CONFIG_ISR_STACK_SIZE",
+}
+
+
+class Stack:
+    __slots__ = ("name", "start", "size", "used", "recommend")
+
+    def __init__(self, name, start, size, used, recommend):
+        self.name = name
+        self.start = start
+        self.size = size
+        self.used = used
+        self.recommend = recommend
+
+    @property
+    def option(self):
+        return KERNEL_STACKS.get(self.name.rstrip("0123456789"))
+
+
+def parse(paths):
+    stacks = {}
+
+    for path in paths:
+        with open(path, errors="replace") as f:
+            for line in f:
+                m = STACK_RE.search(line)
+                if not m:
+                    continue
+                name = m.group(1)
+                start = int(m.group(2), 16)
+                size, used, recommend = (int(g) for g in m.groups()[2:])
+
+                key = (name, start)
+                if key not in stacks or stacks[key].used < used:
+                    stacks[key] = Stack(name, start, size, used, recommend)
+
+    return sorted(stacks.values(), key=lambda s: s.start)
+
+
+def load_config(path):
+    config = {}
+    with open(path) as f:
+        for line in f:
+            m = re.match(r"(CONFIG_\w+)=(\d+)\s*$", line)
+            if m:
+                config[m.group(1)] = int(m.group(2))
+    return config
+
+
+class Objects:
+    """Address to data symbol, to name the stacks of the application."""
+
+    def __init__(self, elf, nm):
+        if shutil.which(nm) is None:
+            sys.exit("%s is needed to read the symbols of %s" % (nm, elf))
+
+        out = subprocess.run([nm, "-S", "--defined-only", elf], check=True,
+                             stdout=subprocess.PIPE, universal_newlines=True)
+        objects = []
+        for line in out.stdout.splitlines():
+            fields = line.split()
+            if len(fields) == 4 and fields[2] in "bBdD":
+                objects.append((int(fields[0], 16), int(fields[1], 16), fields[3]))
+
+        objects.sort()
+        self.addrs = [o[0] for o in objects]
+        self.objects = objects
+
+    def lookup(self, addr):
+        idx = bisect.bisect_right(self.addrs, addr) - 1
+        if idx >= 0:
+            base, size, name = self.objects[idx]
+            if addr < base + size:
+                # a stack of an array, or one behind a guard
+                return name if addr == base else "%s+0x%x" % (name, addr - base)
+        return None
+
+
+def report(stacks, objects, out):
+    total = 0
+
+    out.write("%-12s %-28s %8s %8s %9s %8s\n" %
+              ("stack", "symbol", "size", "used", "recommend", "reclaim"))
+    for stack in stacks:
+        symbol = stack.option or ""
+        if not symbol and objects is not None:
+            symbol = objects.lookup(stack.start) or ""
+
+        reclaim = stack.size - stack.recommend
+        total += max(reclaim, 0)
+        out.write("%-12s %-28s %8d %8d %9d %8s\n" %
+                  (stack.name, symbol, stack.size, stack.used, stack.recommend,
+                   reclaim if reclaim >= 0 else "GROW"))
+
+    out.write("\n%d bytes could be given back\n" % total)
+
+
+def kernel_options(stacks):
+    options = {}
+    for stack in stacks:
+        option = stack.option
+        if option:
+            options[option] = max(options.get(option, 0), stack.recommend)
+    return options
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("logs", nargs="+", help="console logs with STACK lines")
+    parser.add_argument("-e", "--elf", help="wellsl4.elf, to name the other stacks")
+    parser.add_argument("--nm", default="nm", help="nm to read the symbols with")
+    parser.add_argument("-c", "--config",
+                        help=".config of the build, the kernel stack sizes "
+                             "are checked against it")
+    parser.add_argument("--conf-out",
+                        help="write the recommended kernel stack sizes here")
+    args = parser.parse_args()
+
+    stacks = parse(args.logs)
+    if not stacks:
+        sys.exit("no STACK lines found in %s" % ", ".join(args.logs))
+
+    objects = Objects(args.elf, args.nm) if args.elf else None
+    report(stacks, objects, sys.stdout)
+
+    options = kernel_options(stacks)
+
+    if args.config:
+        config = load_config(args.config)
+        for stack in stacks:
+            option = stack.option
+            if option in config and config[option] != stack.size:
+                sys.stderr.write("warning: %s is %d in %s, %s was %d, "
+                                 "the log is of another build?\n" %
+                                 (option, config[option], args.config,
+                                  stack.name, stack.size))
+
+    if args.conf_out:
+        with open(args.conf_out, "w") as out:
+            out.write("# from the stack high-water marks, tool/scripts/stack_report.py\n")
+            for option, size in sorted(options.items()):
+                out.write("%s=%d\n" % (option, size))
+
+
+if __name__ == "__main__":
+    main()
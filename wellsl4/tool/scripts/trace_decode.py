@@ -0,0 +1,304 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Decode the CONFIG_TRACING ring buffers into a timeline.
+
+The input is either the console output of the trace_ring_print syscall
+("TRACE ..." lines, anything else is ignored) or, with --binary, a memory
+dump of the trace_rings array, e.g. from gdb:
+
+    dump binary memory trace.bin &trace_rings ((char *)&trace_rings) + sizeof(trace_rings)
+
+The output is a Chrome/Perfetto JSON trace (open it at ui.perfetto.dev) or,
+with --ctf, a CTF 1.8 trace directory readable by babeltrace and Trace
+Compass. Record and ring layouts must match inc/benchmark/trace.h.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+RING_MAGIC = 0x5254344c
+RING_HEADER = struct.Struct("<IHHIIi12x")
+RECORD = struct.Struct("<IIIHH")
+
+EVENTS = {
+    0x10: "thread_switched_out",
+    0x11: "thread_switched_in",
+    0x12: "thread_priority_set",
+    0x13: "thread_create",
+    0x14: "thread_abort",
+    0x15: "thread_suspend",
+    0x16: "thread_resume",
+    0x17: "thread_ready",
+    0x18: "thread_pending",
+    0x19: "thread_info",
+    0x1A: "thread_name_set",
+    0x20: "isr_enter",
+    0x21: "isr_exit",
+    0x22: "isr_exit_to_scheduler",
+    0x30: "idle",
+    0x41: "call_start",
+    0x42: "call_end",
+}
+
+SWITCHED_OUT = 0x10
+SWITCHED_IN = 0x11
+ISR_ENTER = 0x20
+ISR_EXIT = 0x21
+
+# the ISR track of a cpu, above any thread id the kernel hands out
+ISR_TID = 0x7fff0000
+
+
+class Ring:
+    def __init__(self, cpu, hz):
+        self.cpu = cpu
+        self.hz = hz
+        # (timestamp in cycles, unwrapped, event, thread, arg)
+        self.records = []
+
+    def add(self, idx, timestamp, thread, arg, event, seq):
+        # a slot overwritten or still being written while it was read
+        if seq != idx & 0xffff:
+            return
+        self.records.append([timestamp, event, thread, arg])
+
+    def unwrap(self):
+        # the timestamps are a 32 bit cycle counter, assume no two
+        # consecutive records are a whole wrap apart
+        base = 0
+        last = None
+        for rec in self.records:
+            if last is not None and rec[0] < last:
+                base += 1 << 32
+            last = rec[0]
+            rec[0] += base
+
+
+def parse_text(lines):
+    rings = []
+    ring = None
+    head_re = re.compile(r"TRACE ring cpu=(\d+) head=(\d+) records=(\d+) hz=(\d+)")
+    rec_re = re.compile(r"TRACE rec ([0-9a-f]{8}) ([0-9a-f]{8}) ([0-9a-f]{8}) ([0-9a-f]{8})")
+
+    for line in lines:
+        m = head_re.search(line)
+        if m:
+            cpu, head, records, hz = (int(g) for g in m.groups())
+            ring = Ring(cpu, hz)
+            rings.append(ring)
+            continue
+
+        m = rec_re.search(line)
+        if m and ring is not None:
+            # torn records were already skipped on the target
+            words = [int(g, 16) for g in m.groups()]
+            ring.records.append([words[0], words[3] & 0xffff, words[1], words[2]])
+
+    return rings
+
+
+def parse_binary(data):
+    rings = []
+    offset = 0
+
+    while offset + RING_HEADER.size <= len(data):
+        magic, size, records, cpu, hz, head = RING_HEADER.unpack_from(data, offset)
+        if magic != RING_MAGIC:
+            if not rings:
+                sys.exit("no trace ring at the start of the dump, wrong address?")
+            break
+        if size != RECORD.size:
+            sys.exit("record size %d, this script knows %d" % (size, RECORD.size))
+
+        base = offset + RING_HEADER.size
+        head &= 0xffffffff
+        ring = Ring(cpu, hz)
+        for idx in range(max(head - records, 0), head):
+            slot = base + (idx % records) * size
+            ring.add(idx, *RECORD.unpack_from(data, slot))
+
+        rings.append(ring)
+        offset = base + records * size
+
+    return rings
+
+
+def to_perfetto(rings, out):
+    events = []
+
+    for ring in rings:
+        pid = ring.cpu
+        hz = ring.hz or 1
+
+        def usec(cycles):
+            return cycles * 1e6 / hz
+
+        events.append({"ph": "M", "name": "process_name", "pid": pid,
+                       "args": {"name": "cpu %d" % ring.cpu}})
+        events.append({"ph": "M", "name": "thread_name", "pid": pid,
+                       "tid": ISR_TID, "args": {"name": "isr"}})
+
+        threads = set()
+        running = None
+        isr = []
+
+        for ts, event, thread, arg in ring.records:
+            name = EVENTS.get(event, "event_%#x" % event)
+            threads.add(thread)
+
+            if event == SWITCHED_IN:
+                if running is not None:
+                    events.append(slice_event(pid, running[0], running[1],
+                                              usec(running[1]), usec(ts)))
+                running = (thread, ts)
+            elif event == SWITCHED_OUT:
+                if running is not None and running[0] == thread:
+                    events.append(slice_event(pid, thread, running[1],
+                                              usec(running[1]), usec(ts)))
+                    running = None
+            elif event == ISR_ENTER:
+                isr.append((arg, ts))
+            elif event == ISR_EXIT:
+                if isr:
+                    num, start = isr.pop()
+                    ev = slice_event(pid, ISR_TID, start, usec(start), usec(ts))
+                    ev["name"] = "irq %d" % (num - 16) if num >= 16 else "exception %d" % num
+                    events.append(ev)
+            else:
+                events.append({"ph": "i", "s": "t", "name": name, "pid": pid,
+                               "tid": thread, "ts": usec(ts),
+                               "args": {"arg": arg}})
+
+        # the thread still running when the ring was read
+        if running is not None and ring.records:
+            end = ring.records[-1][0]
+            events.append(slice_event(pid, running[0], running[1],
+                                      usec(running[1]), usec(end)))
+
+        for thread in sorted(threads):
+            events.append({"ph": "M", "name": "thread_name", "pid": pid,
+                           "tid": thread, "args": {"name": "thread %d" % thread}})
+
+    json.dump({"traceEvents": events, "displayTimeUnit": "ns"}, out)
+
+
+def slice_event(pid, tid, start, begin, end):
+    return {"ph": "X", "name": "thread %d" % tid, "pid": pid, "tid": tid,
+            "ts": begin, "dur": end - begin, "args": {"cycle": start}}
+
+
+CTF_METADATA = """/* CTF 1.8 */
+
+typealias integer { size = 8; align = 8; signed = false; } := uint8_t;
+typealias integer { size = 16; align = 8; signed = false; } := uint16_t;
+typealias integer { size = 32; align = 8; signed = false; } := uint32_t;
+typealias integer { size = 64; align = 8; signed = false; } := uint64_t;
+
+trace {
+	major = 1;
+	minor = 8;
+	byte_order = le;
+	packet.header := struct {
+		uint32_t magic;
+		uint32_t stream_id;
+	};
+};
+
+clock {
+	name = cycles;
+	freq = %(hz)d;
+	offset = 0;
+};
+
+typealias integer {
+	size = 64; align = 8; signed = false;
+	map = clock.cycles.value;
+} := uint64_clock_cycles_t;
+
+stream {
+	id = 0;
+	packet.context := struct {
+		uint32_t cpu_id;
+	};
+	event.header := struct {
+		uint8_t id;
+		uint64_clock_cycles_t timestamp;
+	};
+};
+"""
+
+CTF_EVENT = """
+event {
+	name = "%(name)s";
+	id = %(id)d;
+	stream_id = 0;
+	fields := struct {
+		uint32_t thread_id;
+		uint32_t arg;
+	};
+};
+"""
+
+
+def to_ctf(rings, path):
+    os.makedirs(path, exist_ok=True)
+    hz = rings[0].hz if rings and rings[0].hz else 1
+
+    with open(os.path.join(path, "metadata"), "w") as meta:
+        meta.write(CTF_METADATA % {"hz": hz})
+        for event_id, name in sorted(EVENTS.items()):
+            meta.write(CTF_EVENT % {"name": name, "id": event_id})
+
+    for ring in rings:
+        with open(os.path.join(path, "stream_%d" % ring.cpu), "wb") as stream:
+            # 0xC1FC1FC1 is the CTF packet magic
+            stream.write(struct.pack("<III", 0xC1FC1FC1, 0, ring.cpu))
+            for ts, event, thread, arg in ring.records:
+                if event not in EVENTS:
+                    continue
+                stream.write(struct.pack("<BQII", event, ts, thread, arg))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="console log, or memory dump with --binary")
+    parser.add_argument("-b", "--binary", action="store_true",
+                        help="input is a raw dump of trace_rings")
+    parser.add_argument("-o", "--output", default="-",
+                        help="Perfetto JSON file, '-' for stdout")
+    parser.add_argument("--ctf", metavar="DIR",
+                        help="write a CTF trace directory instead")
+    args = parser.parse_args()
+
+    if args.binary:
+        with open(args.input, "rb") as f:
+            rings = parse_binary(f.read())
+    else:
+        with open(args.input, errors="replace") as f:
+            rings = parse_text(f)
+
+    if not rings:
+        sys.exit("no trace rings found in %s" % args.input)
+
+    for ring in rings:
+        ring.unwrap()
+
+    if args.ctf:
+        to_ctf(rings, args.ctf)
+    elif args.output == "-":
+        to_perfetto(rings, sys.stdout)
+    else:
+        with open(args.output, "w") as out:
+            to_perfetto(rings, out)
+
+
+if __name__ == "__main__":
+    main()